@@ -0,0 +1,119 @@
+//
+// Copyright (c) 2017 Michael W Powell <mwpowellhtx@gmail.com>
+//
+// This software is supplied under the terms of the MIT License, a
+// copy of which should be located in the distribution where this
+// file was obtained (LICENSE.txt).  A copy of the license may also be
+// found online at https://opensource.org/licenses/MIT.
+//
+
+#ifndef NNGCPP_BENCH_HARNESS_HPP
+#define NNGCPP_BENCH_HARNESS_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace nng {
+    namespace bench {
+
+        struct measurement {
+
+            std::string name;
+
+            uint64_t iterations;
+
+            double ns_per_op;
+        };
+
+        // Keeps the optimizer from discarding work whose result we do not otherwise use.
+        template<typename Type_>
+        void do_not_optimize(const Type_& value) {
+            static volatile const void* sink;
+            sink = &value;
+        }
+
+        /* Runs the operation a number of times untimed, to warm the caches, and then again
+        under the clock. We are interested in the relative per call cost, not absolute numbers. */
+        template<class Op_>
+        measurement measure(const std::string& name, uint64_t iterations, const Op_& op) {
+
+            using namespace std::chrono;
+
+            typedef high_resolution_clock clock_type;
+
+            for (uint64_t i = 0; i < iterations / 10; i++) { op(); }
+
+            const auto start = clock_type::now();
+            for (uint64_t i = 0; i < iterations; i++) { op(); }
+            const auto elapsed = duration_cast<nanoseconds>(clock_type::now() - start);
+
+            measurement result;
+            result.name = name;
+            result.iterations = iterations;
+            result.ns_per_op = static_cast<double>(elapsed.count()) / iterations;
+            return result;
+        }
+
+        inline void report(const measurement& m) {
+            std::printf("%-48s %12llu iterations %10.2f ns/op\n", m.name.c_str()
+                , static_cast<unsigned long long>(m.iterations), m.ns_per_op);
+        }
+
+        struct latency_summary {
+
+            double p50_ns;
+
+            double p99_ns;
+
+            double p999_ns;
+
+            double mean_ns;
+
+            latency_summary() : p50_ns(0), p99_ns(0), p999_ns(0), mean_ns(0) {}
+        };
+
+        // Nearest rank percentiles; sorts the samples in place.
+        inline latency_summary summarize(std::vector<uint64_t>& samples) {
+
+            latency_summary result;
+
+            if (samples.empty()) { return result; }
+
+            std::sort(samples.begin(), samples.end());
+
+            const auto n = samples.size();
+
+            const auto at = [&](double q) {
+                const auto rank = static_cast<size_t>(std::ceil(q * n));
+                return static_cast<double>(samples[std::min(n, std::max<size_t>(rank, 1)) - 1]);
+            };
+
+            double sum = 0;
+            for (const auto& x : samples) { sum += x; }
+
+            result.p50_ns = at(0.5);
+            result.p99_ns = at(0.99);
+            result.p999_ns = at(0.999);
+            result.mean_ns = sum / n;
+
+            return result;
+        }
+
+        // Only what our own names and notes might contain needs escaping.
+        inline std::string json_escape(const std::string& s) {
+            std::string result;
+            for (const auto& ch : s) {
+                if (ch == '"' || ch == '\\') { result += '\\'; }
+                result += ch;
+            }
+            return result;
+        }
+    }
+}
+
+#endif // NNGCPP_BENCH_HARNESS_HPP
@@ -0,0 +1,90 @@
+//
+// Copyright (c) 2017 Michael W Powell <mwpowellhtx@gmail.com>
+//
+// This software is supplied under the terms of the MIT License, a
+// copy of which should be located in the distribution where this
+// file was obtained (LICENSE.txt).  A copy of the license may also be
+// found online at https://opensource.org/licenses/MIT.
+//
+
+#include <nngcpp.h>
+
+#include "bench_harness.hpp"
+
+#include <string>
+
+/* Measures the string and buffer conversions at 64 B, 4 KiB and 1 MiB:
+
+  to_buffer/to_string  - the messaging_utils helpers returning fresh containers;
+  ... into existing    - the same, reusing the capacity of a caller's container;
+  message << / >>      - appending to, and copying out of, a message body;
+  message round trip   - both of the above, plus clearing, which is what a relay does.
+
+The optional argument scales the iteration counts, which shrink as payloads grow. */
+
+int main(int argc, char* argv[]) {
+
+    using namespace std;
+    using namespace nng;
+    using namespace nng::bench;
+
+    const double scale = argc > 1 ? stod(argv[1]) : 1.0;
+
+    const size_type sizes[] = { 64, 4 * 1024, 1024 * 1024 };
+
+    for (const auto sz : sizes) {
+
+        const auto iterations = static_cast<uint64_t>(std::max(1.0, scale * (64.0 * 1024 * 1024) / (sz + 64)));
+        const auto suffix = " (" + to_string(sz) + " B)";
+
+        const string s(sz, 'x');
+        const auto buf = messaging_utils::to_buffer(&s);
+
+        report(measure("to_buffer" + suffix, iterations, [&]() {
+            const auto result = messaging_utils::to_buffer(&s);
+            do_not_optimize(result);
+        }));
+
+        report(measure("to_string" + suffix, iterations, [&]() {
+            const auto result = messaging_utils::to_string(&buf);
+            do_not_optimize(result);
+        }));
+
+        buffer_vector_type buf_result;
+        string s_result;
+
+        report(measure("to_buffer into existing" + suffix, iterations, [&]() {
+            messaging_utils::to_buffer(&buf_result, &s, s.size());
+            do_not_optimize(buf_result);
+        }));
+
+        report(measure("to_string into existing" + suffix, iterations, [&]() {
+            messaging_utils::to_string(&s_result, &buf, buf.size());
+            do_not_optimize(s_result);
+        }));
+
+        binary_message bm;
+
+        report(measure("message << string" + suffix, iterations, [&]() {
+            bm.GetBody()->Clear();
+            bm << s;
+            do_not_optimize(bm);
+        }));
+
+        report(measure("message >> string" + suffix, iterations, [&]() {
+            bm >> s_result;
+            do_not_optimize(s_result);
+        }));
+
+        report(measure("message string round trip" + suffix, iterations, [&]() {
+            bm.GetBody()->Clear();
+            bm << s;
+            bm >> s_result;
+            do_not_optimize(s_result);
+        }));
+    }
+
+    ::nng_fini();
+
+    return 0;
+}
@@ -0,0 +1,73 @@
+//
+// Copyright (c) 2017 Michael W Powell <mwpowellhtx@gmail.com>
+//
+// This software is supplied under the terms of the MIT License, a
+// copy of which should be located in the distribution where this
+// file was obtained (LICENSE.txt).  A copy of the license may also be
+// found online at https://opensource.org/licenses/MIT.
+//
+
+#include <nngcpp.h>
+#include <core/invocation.hpp>
+
+#include "bench_harness.hpp"
+
+#include <functional>
+#include <memory>
+
+/* Measures the per call cost of the dispatch strategies the wrapper has used over NNG.
+Getting an integer option is cheap enough on the NNG side that the dispatch is visible:
+
+  direct       - calling the C API, which is the floor;
+  bound        - invoking a bound std::function member, the former options strategy;
+  bind per op  - constructing the bind object on every call, the former send/receive strategy;
+  options API  - the options reader as it stands, which should be close to direct. */
+
+int main(int argc, char* argv[]) {
+
+    using namespace std;
+    using namespace std::placeholders;
+    using namespace nng;
+    using namespace nng::bench;
+    using namespace nng::protocol;
+    using O = option_names;
+
+    const uint64_t iterations = argc > 1 ? stoull(argv[1]) : 1000000;
+
+    ::nng_socket sid = 0;
+    if (::nng_pair1_open(&sid) != 0) { return 1; }
+
+    auto sp = make_unique<latest_pair_socket>();
+
+    const auto name = O::recv_buf.c_str();
+    int val = 0;
+
+    report(measure("direct nng_getopt_int", iterations, [&]() {
+        ::nng_getopt_int(sid, name, &val);
+        do_not_optimize(val);
+    }));
+
+    const function<int(const char*, int*)> bound = bind(&::nng_getopt_int, sid, _1, _2);
+
+    report(measure("bound std::function nng_getopt_int", iterations, [&]() {
+        invocation::with_default_error_handling(bound, name, &val);
+        do_not_optimize(val);
+    }));
+
+    report(measure("bind per op nng_getopt_int", iterations, [&]() {
+        const auto op = bind(&::nng_getopt_int, sid, _1, _2);
+        invocation::with_default_error_handling(op, name, &val);
+        do_not_optimize(val);
+    }));
+
+    report(measure("options API GetInt32", iterations, [&]() {
+        val = sp->GetOptions()->GetInt32(O::recv_buf);
+        do_not_optimize(val);
+    }));
+
+    sp.reset();
+    ::nng_close(sid);
+    ::nng_fini();
+
+    return 0;
+}
@@ -0,0 +1,517 @@
+//
+// Copyright (c) 2017 Michael W Powell <mwpowellhtx@gmail.com>
+//
+// This software is supplied under the terms of the MIT License, a
+// copy of which should be located in the distribution where this
+// file was obtained (LICENSE.txt).  A copy of the license may also be
+// found online at https://opensource.org/licenses/MIT.
+//
+
+#include <nngcpp.h>
+
+#include "bench_harness.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+/* Measures throughput and latency through the wrapper for each protocol over each transport,
+varying message size and concurrency, i.e. the number of peers driving the one socket under
+test. Every message carries its send time, so one way protocols report send to receive latency,
+whereas req/rep and survey report the round trip.
+
+  --messages N      messages per case, shared among the peers (default 10000);
+  --sizes a,b,...   message sizes in bytes, at least 8 (default 64,1024,65536);
+  --concurrency ... peer counts (default 1,4);
+  --protocol name   runs only the named protocol, i.e. pair0, pair1, pipeline, pubsub,
+                    reqrep, survey or bus;
+  --transport name  runs only the named transport, i.e. inproc, ipc, tcp or tcp6;
+  --json path       also writes the results to the file, for regression tracking.
+
+Allocations per message counts only C++ heap allocations through the wrapper and these
+benchmarks, not NNG allocations, which go through malloc directly. */
+
+namespace {
+
+    std::atomic<uint64_t> __allocations(0);
+}
+
+void* operator new(std::size_t sz) {
+    ++__allocations;
+    if (void* ptr = std::malloc(sz ? sz : 1)) { return ptr; }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t sz) {
+    ++__allocations;
+    if (void* ptr = std::malloc(sz ? sz : 1)) { return ptr; }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+
+void operator delete[](void* ptr) noexcept { std::free(ptr); }
+
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+
+void operator delete[](void* ptr, std::size_t) noexcept { std::free(ptr); }
+
+namespace nng {
+    namespace bench {
+
+        typedef std::chrono::steady_clock clock_type;
+
+        const size_type stamp_size = sizeof(uint64_t);
+
+        const duration_type receive_timeout = std::chrono::milliseconds(1000);
+
+        // Gives dialers a chance to connect, and subscribers to subscribe, before any sends.
+        const auto settle_time = std::chrono::milliseconds(100);
+
+        struct bench_case {
+
+            std::string protocol;
+
+            std::string transport;
+
+            size_type size;
+
+            size_type concurrency;
+        };
+
+        struct bench_result {
+
+            bench_case which;
+
+            uint64_t sent;
+
+            uint64_t received;
+
+            double seconds;
+
+            uint64_t allocations;
+
+            latency_summary latency;
+        };
+
+        uint64_t now_ns() {
+            using namespace std::chrono;
+            return static_cast<uint64_t>(duration_cast<nanoseconds>(clock_type::now().time_since_epoch()).count());
+        }
+
+        void stamp(buffer_vector_type& buf) {
+            const auto ns = now_ns();
+            std::memcpy(buf.data(), &ns, stamp_size);
+        }
+
+        uint64_t elapsed_since_stamp(const uint8_t* data) {
+            uint64_t ns = 0;
+            std::memcpy(&ns, data, stamp_size);
+            return now_ns() - ns;
+        }
+
+        std::string get_addr(const std::string& transport, int n) {
+            std::ostringstream os;
+            if (transport == "inproc") { os << "inproc://bench_" << n; }
+            else if (transport == "ipc") { os << "ipc:///tmp/nngcpp_bench_" << n; }
+            else if (transport == "tcp") { os << "tcp://127.0.0.1:" << 13000 + n; }
+            else { os << "tcp://[::1]:" << 13000 + n; }
+            return os.str();
+        }
+
+        // Collects the samples from each of the peer threads.
+        struct sample_sink {
+
+            std::mutex mutex;
+
+            std::vector<uint64_t> samples;
+
+            void append(const std::vector<uint64_t>& more) {
+                std::lock_guard<std::mutex> guard(mutex);
+                samples.insert(samples.end(), more.begin(), more.end());
+            }
+        };
+
+        template<class Receiver_, class Sender_>
+        bench_result run_one_way(const bench_case& c, const std::string& addr, uint64_t messages
+            , const std::function<void(Receiver_&)>& prepare = nullptr) {
+
+            using O = option_names;
+
+            bench_result result = { c, 0, 0, 0, 0, latency_summary() };
+
+            Receiver_ receiver;
+            receiver.GetOptions()->SetDuration(O::recv_timeout_duration, receive_timeout);
+            if (prepare) { prepare(receiver); }
+            receiver.Listen(addr);
+
+            std::vector<std::unique_ptr<Sender_>> senders;
+            for (size_type i = 0; i < c.concurrency; i++) {
+                senders.push_back(std::make_unique<Sender_>());
+                senders.back()->Dial(addr);
+            }
+
+            std::this_thread::sleep_for(settle_time);
+
+            const auto per_sender = messages / c.concurrency;
+            const auto expected = per_sender * c.concurrency;
+
+            std::atomic<uint64_t> sent(0);
+            std::vector<uint64_t> samples;
+            samples.reserve(static_cast<size_t>(expected));
+
+            const auto allocations = __allocations.load();
+            const auto start = clock_type::now();
+
+            // Lossy protocols may drop, so the receiver gives up once the timeout elapses.
+            std::thread receiving([&]() {
+                allocated_buffer buf;
+                while (samples.size() < expected) {
+                    if (receiver.TryReceive(buf) != ec_enone) { break; }
+                    samples.push_back(elapsed_since_stamp(buf.data()));
+                    buf.free();
+                }
+            });
+
+            std::vector<std::thread> sending;
+            for (auto& sp : senders) {
+                const auto senderp = sp.get();
+                sending.emplace_back([&, senderp]() {
+                    buffer_vector_type buf(c.size);
+                    for (uint64_t i = 0; i < per_sender; i++) {
+                        stamp(buf);
+                        if (senderp->TrySend(buf) != ec_enone) { break; }
+                        ++sent;
+                    }
+                });
+            }
+
+            for (auto& t : sending) { t.join(); }
+            receiving.join();
+
+            result.seconds = std::chrono::duration<double>(clock_type::now() - start).count();
+            result.allocations = __allocations.load() - allocations;
+            result.sent = sent;
+            result.received = samples.size();
+            result.latency = summarize(samples);
+
+            return result;
+        }
+
+        bench_result run_round_trip(const bench_case& c, const std::string& addr, uint64_t messages) {
+
+            using namespace protocol;
+            using O = option_names;
+
+            bench_result result = { c, 0, 0, 0, 0, latency_summary() };
+
+            latest_rep_socket server;
+            server.Listen(addr);
+
+            std::vector<std::unique_ptr<latest_req_socket>> clients;
+            for (size_type i = 0; i < c.concurrency; i++) {
+                clients.push_back(std::make_unique<latest_req_socket>());
+                clients.back()->GetOptions()->SetDuration(O::recv_timeout_duration, receive_timeout);
+                clients.back()->Dial(addr);
+            }
+
+            std::this_thread::sleep_for(settle_time);
+
+            const auto per_client = messages / c.concurrency;
+
+            std::atomic<uint64_t> sent(0);
+            sample_sink sink;
+
+            const auto allocations = __allocations.load();
+            const auto start = clock_type::now();
+
+            // Echoes until the socket is closed out from under it.
+            std::thread serving([&]() {
+                binary_message bm;
+                while (server.TryReceive(bm) == ec_enone) {
+                    if (server.TrySend(bm) != ec_enone) { break; }
+                }
+            });
+
+            std::vector<std::thread> requesting;
+            for (auto& cp : clients) {
+                const auto clientp = cp.get();
+                requesting.emplace_back([&, clientp]() {
+                    std::vector<uint64_t> samples;
+                    samples.reserve(static_cast<size_t>(per_client));
+                    buffer_vector_type buf(c.size);
+                    allocated_buffer reply;
+                    for (uint64_t i = 0; i < per_client; i++) {
+                        stamp(buf);
+                        if (clientp->TrySend(buf) != ec_enone) { break; }
+                        ++sent;
+                        if (clientp->TryReceive(reply) != ec_enone) { break; }
+                        samples.push_back(elapsed_since_stamp(reply.data()));
+                        reply.free();
+                    }
+                    sink.append(samples);
+                });
+            }
+
+            for (auto& t : requesting) { t.join(); }
+
+            result.seconds = std::chrono::duration<double>(clock_type::now() - start).count();
+            result.allocations = __allocations.load() - allocations;
+
+            server.Close();
+            serving.join();
+
+            result.sent = sent;
+            result.received = sink.samples.size();
+            result.latency = summarize(sink.samples);
+
+            return result;
+        }
+
+        bench_result run_survey(const bench_case& c, const std::string& addr, uint64_t messages) {
+
+            using namespace protocol;
+            using O = option_names;
+
+            bench_result result = { c, 0, 0, 0, 0, latency_summary() };
+
+            latest_survey_socket surveyor;
+            surveyor.GetOptions()->SetDuration(O::surveyor_survey_duration, receive_timeout);
+            surveyor.Listen(addr);
+
+            std::vector<std::unique_ptr<latest_respond_socket>> respondents;
+            for (size_type i = 0; i < c.concurrency; i++) {
+                respondents.push_back(std::make_unique<latest_respond_socket>());
+                respondents.back()->Dial(addr);
+            }
+
+            std::this_thread::sleep_for(settle_time);
+
+            // Each survey is answered by every respondent, so that is what we count.
+            const auto surveys = messages / c.concurrency;
+
+            std::vector<uint64_t> samples;
+            samples.reserve(static_cast<size_t>(surveys * c.concurrency));
+
+            std::vector<std::thread> responding;
+            for (auto& rp : respondents) {
+                const auto respondentp = rp.get();
+                responding.emplace_back([respondentp]() {
+                    binary_message bm;
+                    while (respondentp->TryReceive(bm) == ec_enone) {
+                        if (respondentp->TrySend(bm) != ec_enone) { break; }
+                    }
+                });
+            }
+
+            const auto allocations = __allocations.load();
+            const auto start = clock_type::now();
+
+            buffer_vector_type buf(c.size);
+            allocated_buffer reply;
+
+            for (uint64_t i = 0; i < surveys; i++) {
+                stamp(buf);
+                if (surveyor.TrySend(buf) != ec_enone) { break; }
+                ++result.sent;
+                for (size_type j = 0; j < c.concurrency; j++) {
+                    if (surveyor.TryReceive(reply) != ec_enone) { break; }
+                    samples.push_back(elapsed_since_stamp(reply.data()));
+                    reply.free();
+                }
+            }
+
+            result.seconds = std::chrono::duration<double>(clock_type::now() - start).count();
+            result.allocations = __allocations.load() - allocations;
+
+            for (auto& rp : respondents) { rp->Close(); }
+            for (auto& t : responding) { t.join(); }
+
+            result.received = samples.size();
+            result.latency = summarize(samples);
+
+            return result;
+        }
+
+        bench_result run_case(const bench_case& c, int n, uint64_t messages) {
+
+            using namespace protocol;
+            using O = option_names;
+
+            const auto addr = get_addr(c.transport, n);
+
+            if (c.protocol == "pair0") {
+                return run_one_way<v0::pair_socket, v0::pair_socket>(c, addr, messages);
+            }
+            if (c.protocol == "pair1") {
+                return run_one_way<v1::pair_socket, v1::pair_socket>(c, addr, messages);
+            }
+            if (c.protocol == "pipeline") {
+                return run_one_way<latest_pull_socket, latest_push_socket>(c, addr, messages);
+            }
+            if (c.protocol == "pubsub") {
+                return run_one_way<latest_sub_socket, latest_pub_socket>(c, addr, messages
+                    , [](latest_sub_socket& s) { s.GetOptions()->SetString(O::sub_subscribe, ""); });
+            }
+            if (c.protocol == "bus") {
+                return run_one_way<_LatestBusSocket, _LatestBusSocket>(c, addr, messages);
+            }
+            if (c.protocol == "reqrep") {
+                return run_round_trip(c, addr, messages);
+            }
+            if (c.protocol == "survey") {
+                return run_survey(c, addr, messages);
+            }
+            throw std::invalid_argument("unknown protocol: " + c.protocol);
+        }
+
+        std::vector<std::string> split(const std::string& s) {
+            std::vector<std::string> result;
+            std::istringstream is(s);
+            std::string item;
+            while (std::getline(is, item, ',')) {
+                if (!item.empty()) { result.push_back(item); }
+            }
+            return result;
+        }
+
+        double get_msgs_per_sec(const bench_result& r) {
+            return r.seconds > 0 ? r.received / r.seconds : 0;
+        }
+
+        double get_mb_per_sec(const bench_result& r) {
+            return get_msgs_per_sec(r) * r.which.size / (1024 * 1024);
+        }
+
+        double get_allocs_per_msg(const bench_result& r) {
+            return r.received ? static_cast<double>(r.allocations) / r.received : 0;
+        }
+
+        void report(const bench_result& r) {
+            std::printf("%-9s %-7s %8llu %4llu %10llu %10llu %12.0f %10.2f %10.0f %10.0f %10.0f %8.2f\n"
+                , r.which.protocol.c_str(), r.which.transport.c_str()
+                , static_cast<unsigned long long>(r.which.size)
+                , static_cast<unsigned long long>(r.which.concurrency)
+                , static_cast<unsigned long long>(r.sent)
+                , static_cast<unsigned long long>(r.received)
+                , get_msgs_per_sec(r), get_mb_per_sec(r)
+                , r.latency.p50_ns, r.latency.p99_ns, r.latency.p999_ns
+                , get_allocs_per_msg(r));
+            std::fflush(stdout);
+        }
+
+        void write_json(const std::string& path, const std::vector<bench_result>& results) {
+
+            std::ofstream os(path);
+
+            os << "[" << std::endl;
+
+            for (size_t i = 0; i < results.size(); i++) {
+                const auto& r = results[i];
+                os << "  {"
+                    << "\"protocol\": \"" << json_escape(r.which.protocol) << "\", "
+                    << "\"transport\": \"" << json_escape(r.which.transport) << "\", "
+                    << "\"size\": " << r.which.size << ", "
+                    << "\"concurrency\": " << r.which.concurrency << ", "
+                    << "\"sent\": " << r.sent << ", "
+                    << "\"received\": " << r.received << ", "
+                    << "\"seconds\": " << r.seconds << ", "
+                    << "\"msgs_per_sec\": " << get_msgs_per_sec(r) << ", "
+                    << "\"mb_per_sec\": " << get_mb_per_sec(r) << ", "
+                    << "\"p50_ns\": " << r.latency.p50_ns << ", "
+                    << "\"p99_ns\": " << r.latency.p99_ns << ", "
+                    << "\"p999_ns\": " << r.latency.p999_ns << ", "
+                    << "\"mean_ns\": " << r.latency.mean_ns << ", "
+                    << "\"allocs_per_msg\": " << get_allocs_per_msg(r)
+                    << "}" << (i + 1 < results.size() ? "," : "") << std::endl;
+            }
+
+            os << "]" << std::endl;
+        }
+    }
+}
+
+int main(int argc, char* argv[]) {
+
+    using namespace std;
+    using namespace nng;
+    using namespace nng::bench;
+
+    uint64_t messages = 10000;
+    vector<size_type> sizes = { 64, 1024, 65536 };
+    vector<size_type> concurrencies = { 1, 4 };
+    const vector<string> all_protocols = { "pair0", "pair1", "pipeline", "pubsub", "reqrep", "survey", "bus" };
+    vector<string> protocols = all_protocols;
+    vector<string> transports = { "inproc", "ipc", "tcp", "tcp6" };
+    string json_path;
+
+    for (int i = 1; i + 1 < argc; i += 2) {
+        const string name = argv[i], value = argv[i + 1];
+        if (name == "--messages") { messages = stoull(value); }
+        else if (name == "--sizes") {
+            sizes.clear();
+            for (const auto& x : split(value)) { sizes.push_back(max<size_type>(stoul(x), stamp_size)); }
+        }
+        else if (name == "--concurrency") {
+            concurrencies.clear();
+            for (const auto& x : split(value)) { concurrencies.push_back(max<size_type>(stoul(x), 1)); }
+        }
+        else if (name == "--protocol") { protocols = split(value); }
+        else if (name == "--transport") { transports = split(value); }
+        else if (name == "--json") { json_path = value; }
+        else {
+            fprintf(stderr, "unknown option: %s\n", name.c_str());
+            return 1;
+        }
+    }
+
+    for (const auto& p : protocols) {
+        if (find(all_protocols.begin(), all_protocols.end(), p) != all_protocols.end()) { continue; }
+        fprintf(stderr, "unknown protocol: %s, expected one of:", p.c_str());
+        for (const auto& x : all_protocols) { fprintf(stderr, " %s", x.c_str()); }
+        fprintf(stderr, "\n");
+        return 1;
+    }
+
+    printf("%-9s %-7s %8s %4s %10s %10s %12s %10s %10s %10s %10s %8s\n"
+        , "protocol", "trans", "size", "conc", "sent", "received"
+        , "msgs/s", "MB/s", "p50 ns", "p99 ns", "p999 ns", "allocs");
+
+    vector<bench_result> results;
+
+    // Every case gets its own address, so that lingering TCP connections are not an issue.
+    int n = 0;
+
+    for (const auto& p : protocols) {
+        for (const auto& t : transports) {
+            for (const auto& sz : sizes) {
+                for (const auto& conc : concurrencies) {
+                    // Pair sockets accept exactly one peer.
+                    if (p.compare(0, 4, "pair") == 0 && conc != 1) { continue; }
+                    const bench_case c = { p, t, sz, conc };
+                    try {
+                        results.push_back(run_case(c, n++, messages));
+                        report(results.back());
+                    }
+                    catch (const std::exception& ex) {
+                        fprintf(stderr, "%s over %s failed: %s\n", p.c_str(), t.c_str(), ex.what());
+                    }
+                }
+            }
+        }
+    }
+
+    if (!json_path.empty()) { write_json(json_path, results); }
+
+    ::nng_fini();
+
+    return 0;
+}
@@ -31,6 +31,28 @@ namespace nng {
         virtual buffer_vector_type Receive(size_type& sz, flag_type flags = flag_none) = 0;
         virtual bool TryReceive(buffer_vector_type* const bufp, size_type& sz, flag_type flags = flag_none) = 0;
 
+        // Receives into a buffer allocated by NNG itself, i.e. NNG_FLAG_ALLOC, avoiding the vector round trip.
+        virtual allocated_buffer ReceiveAllocated(flag_type flags = flag_none) = 0;
+        virtual bool TryReceive(allocated_buffer* const abp, flag_type flags = flag_none) = 0;
+
+        // Return the NNG error code rather than throwing, i.e. ec_eagain when non-blocking and nothing is there.
+        virtual error_code_type TryReceive(binary_message& m, flag_type flags = flag_none) = 0;
+        virtual error_code_type TryReceive(allocated_buffer& buf, flag_type flags = flag_none) = 0;
+
+        /* Receives one message, copying its body into the segments in order, each filled before
+        the next. Bodies longer than the segments altogether are ec_emsgsize, in which case the
+        segments hold as much as fit, and the rest of the message is dropped. The body size is
+        reported through sz either way. */
+        virtual size_type ReceiveScatter(const mutable_buffer_segment* const segs, size_type count, flag_type flags = flag_none) = 0;
+        virtual error_code_type TryReceiveScatter(const mutable_buffer_segment* const segs, size_type count
+            , size_type& sz, flag_type flags = flag_none) = 0;
+
+        /* Waits up to timeout for the first message, then drains whatever else is immediately
+        available, up to max messages in total. Returns the status that ended the batch rather
+        than throwing; messages received prior to any failure are kept in the results. */
+        virtual error_code_type ReceiveBatch(std::vector<std::unique_ptr<binary_message>>& results
+            , size_type max, const duration_type& timeout) = 0;
+
         // TODO: TBD: ditto ISender re: extending even through send-only API.
         virtual void ReceiveAsync(basic_async_service* const svcp) = 0;
     };
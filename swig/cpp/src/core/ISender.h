@@ -28,6 +28,20 @@ namespace nng {
         virtual void Send(const buffer_vector_type& buf, flag_type flags = flag_none) = 0;
         virtual void Send(const buffer_vector_type& buf, size_type sz, flag_type flags = flag_none) = 0;
 
+        // Returns the NNG error code rather than throwing. The message is retained on failure.
+        virtual error_code_type TrySend(binary_message& m, flag_type flags = flag_none) = 0;
+        virtual error_code_type TrySend(const buffer_vector_type& buf, flag_type flags = flag_none) = 0;
+
+        /* Gathers the segments into a single message, allocated once at their combined size, and
+        sends that, so that headers, metadata and payloads need not be concatenated beforehand. */
+        virtual void SendGather(const const_buffer_segment* const segs, size_type count, flag_type flags = flag_none) = 0;
+        virtual error_code_type TrySendGather(const const_buffer_segment* const segs, size_type count, flag_type flags = flag_none) = 0;
+
+        /* Sends up to count messages in one call, reporting a status per message rather than
+        throwing. Sending stops at the first failure; the remaining messages are left with the
+        caller and reported as canceled. */
+        virtual std::vector<error_code_type> SendBatch(binary_message* const msgs, size_type count, flag_type flags = flag_none) = 0;
+
         // TODO: TBD: make sure that the async coverage extends, even through the recv-only API.
         virtual void SendAsync(const basic_async_service* const svcp) = 0;
     };
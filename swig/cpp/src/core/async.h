@@ -2,5 +2,9 @@
 #define NNGCPP_ASYNC_H
 
 #include "async/basic_async_service.h"
+#include "async/awaitable.h"
+#include "async/aio_pool.h"
+#include "async/aio_reaper.h"
+#include "async/async_future.h"
 
 #endif // NNGCPP_ASYNC_H
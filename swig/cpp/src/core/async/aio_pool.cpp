@@ -0,0 +1,182 @@
+#include "aio_pool.h"
+#include "../socket.h"
+#include "../invocation.hpp"
+#include "../exceptions.hpp"
+#include "../../messaging/binary_message.h"
+
+#include <limits>
+
+namespace nng {
+
+    const uint32_t __no_slot = std::numeric_limits<uint32_t>::max();
+
+    struct _AioSlot {
+
+        _AioPool* poolp;
+
+        ::nng_aio* aiop;
+
+        _AioPool::handler_type handler;
+
+        bool sending;
+
+        uint32_t index;
+
+        std::atomic<uint32_t> next;
+
+        _AioSlot()
+            : poolp(nullptr), aiop(nullptr), handler(), sending(false), index(__no_slot), next(__no_slot) {
+        }
+    };
+
+    // Which slot the calling thread is handling, if any, and whether its handler reissued it.
+    struct __aio_handler_context {
+        _AioSlot* slotp;
+        bool rearmed;
+    };
+
+    static thread_local __aio_handler_context* __current_contextp = nullptr;
+
+    uint64_t __make_head(uint64_t tag, uint32_t index) {
+        return (tag << 32) | index;
+    }
+
+    // Slot indexes are 32 bits wide, with the highest value reserved for no slot at all.
+    size_type __verify_count(size_type count) {
+        if (count > static_cast<size_type>(__no_slot - 1)) { THROW_NNG_EXCEPTION_EC(ec_einval); }
+        return count;
+    }
+
+    _AioPool::_AioPool(size_type count)
+        : _slots(new _AioSlot[__verify_count(count)]), _count(count)
+        , _head(__make_head(0, __no_slot)), _leased(0) {
+
+        init(nullptr);
+    }
+
+    _AioPool::_AioPool(size_type count, const duration_type& timeout)
+        : _slots(new _AioSlot[__verify_count(count)]), _count(count)
+        , _head(__make_head(0, __no_slot)), _leased(0) {
+
+        init(&timeout);
+    }
+
+    void _AioPool::init(const duration_type* const timeoutp) {
+
+        try {
+            for (size_type i = 0; i < _count; i++) {
+                auto& slot = _slots[i];
+                slot.poolp = this;
+                slot.index = static_cast<uint32_t>(i);
+                invocation::with_default_error_handling(&::nng_aio_alloc, &slot.aiop, &_AioPool::_aio_cb, (void*)&slot);
+                // The timeout is set once up front rather than per operation.
+                if (timeoutp) {
+                    ::nng_aio_set_timeout(slot.aiop, static_cast<duration_rep_type>(timeoutp->count()));
+                }
+                release(&slot);
+            }
+        }
+        catch (...) {
+            for (size_type i = 0; i < _count; i++) {
+                if (_slots[i].aiop) { ::nng_aio_free(_slots[i].aiop); }
+            }
+            throw;
+        }
+    }
+
+    _AioPool::~_AioPool() {
+        // Stop everything first, since the callbacks may still be returning slots to the pool.
+        for (size_type i = 0; i < _count; i++) {
+            ::nng_aio_stop(_slots[i].aiop);
+        }
+        for (size_type i = 0; i < _count; i++) {
+            ::nng_aio_free(_slots[i].aiop);
+        }
+    }
+
+    _AioSlot* _AioPool::lease() {
+        // A handler issuing an operation on its own pool picks up the AIO it is handling first.
+        const auto contextp = __current_contextp;
+        if (contextp && !contextp->rearmed && contextp->slotp->poolp == this) {
+            contextp->rearmed = true;
+            return contextp->slotp;
+        }
+        auto head = _head.load(std::memory_order_acquire);
+        for (;;) {
+            const auto index = static_cast<uint32_t>(head);
+            if (index == __no_slot) { return nullptr; }
+            auto& slot = _slots[index];
+            const auto next = slot.next.load(std::memory_order_relaxed);
+            // The tag changes on every update, so a stale head can never be swapped back in.
+            if (_head.compare_exchange_weak(head, __make_head((head >> 32) + 1, next)
+                , std::memory_order_acq_rel, std::memory_order_acquire)) {
+                ++_leased;
+                return &slot;
+            }
+        }
+    }
+
+    void _AioPool::release(_AioSlot* const slotp) {
+        auto head = _head.load(std::memory_order_acquire);
+        do {
+            slotp->next.store(static_cast<uint32_t>(head), std::memory_order_relaxed);
+        } while (!_head.compare_exchange_weak(head, __make_head((head >> 32) + 1, slotp->index)
+            , std::memory_order_acq_rel, std::memory_order_acquire));
+    }
+
+    void _AioPool::_aio_cb(void* slotp) {
+
+        auto __slotp = static_cast<_AioSlot*>(slotp);
+
+        const auto aiop = __slotp->aiop;
+        const auto ec = static_cast<error_code_type>(::nng_aio_result(aiop));
+        // Successful sends belong to NNG; otherwise the message, if any, is still ours.
+        const auto has_msg = __slotp->sending ? ec != ec_enone : ec == ec_enone;
+        binary_message m(has_msg ? ::nng_aio_get_msg(aiop) : nullptr);
+        ::nng_aio_set_msg(aiop, nullptr);
+
+        auto handler = std::move(__slotp->handler);
+        __slotp->handler = nullptr;
+
+        // The slot stays leased until the handler is done, so that no other lease reuses the AIO under it.
+        __aio_handler_context context = { __slotp, false };
+        const auto priorp = __current_contextp;
+        __current_contextp = &context;
+        if (handler) { handler(ec, m); }
+        __current_contextp = priorp;
+
+        // Reissued, so the slot is still in use, and may even be completing on another thread.
+        if (context.rearmed) { return; }
+
+        auto poolp = __slotp->poolp;
+        --poolp->_leased;
+        poolp->release(__slotp);
+    }
+
+    bool _AioPool::TrySend(_Socket& s, _Message& m, const handler_type& on_sent) {
+        auto slotp = lease();
+        if (slotp == nullptr) { return false; }
+        slotp->handler = on_sent;
+        slotp->sending = true;
+        ::nng_aio_set_msg(slotp->aiop, m.cede_message());
+        ::nng_send_aio(s.sid, slotp->aiop);
+        return true;
+    }
+
+    bool _AioPool::TryReceive(_Socket& s, const handler_type& on_received) {
+        auto slotp = lease();
+        if (slotp == nullptr) { return false; }
+        slotp->handler = on_received;
+        slotp->sending = false;
+        ::nng_recv_aio(s.sid, slotp->aiop);
+        return true;
+    }
+
+    size_type _AioPool::GetCapacity() const {
+        return _count;
+    }
+
+    size_type _AioPool::GetLeased() const {
+        return _leased.load(std::memory_order_relaxed);
+    }
+}
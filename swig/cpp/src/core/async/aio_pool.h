@@ -0,0 +1,93 @@
+#ifndef NNGCPP_AIO_POOL_H
+#define NNGCPP_AIO_POOL_H
+
+#define NNG_ONLY
+#include <nngcpp.h>
+
+#include "../types.h"
+#include "../enums.h"
+
+#include <atomic>
+#include <functional>
+#include <memory>
+
+namespace nng {
+
+#ifndef NNGCPP_SOCKET_H
+    class _Socket;
+#endif // NNGCPP_SOCKET_H
+
+#ifndef NNGCPP_BINARY_MESSAGE_H
+    class _Message;
+#endif // NNGCPP_BINARY_MESSAGE_H
+
+    // Defined alongside the trampoline callback.
+    struct _AioSlot;
+
+    /* Pre-allocates a fixed number of NNG AIOs and leases them out one operation at a time,
+    so that high rate SendAsync and ReceiveAsync style fan out does not pay for nng_aio_alloc
+    and nng_aio_free on every operation. Every AIO shares a trampoline callback which invokes
+    the handler, and only then returns the AIO to the pool. Handlers are free to issue the next
+    operation: the first one issued on the same pool reissues the AIO being handled, which
+    therefore never fails, even for a pool of one; any further ones lease another AIO.
+    Leasing and returning are lock free. Pools are limited to UINT32_MAX - 1 AIOs; larger counts
+    throw ec_einval.
+
+    The pool must not be destroyed from within one of its own handlers, since destroying it
+    waits for every operation in flight to complete, i.e. as canceled. */
+    class _AioPool {
+    public:
+
+        /* Handlers receive the result along with the message: the received message on success,
+        or the unsent message on failure. Whatever the handler does not cede is freed after it
+        returns. Handlers must not throw, since they run on NNG threads. */
+        typedef std::function<void(error_code_type, _Message&)> handler_type;
+
+    private:
+
+        typedef ::nng_aio aio_type;
+
+        std::unique_ptr<_AioSlot[]> _slots;
+
+        const size_type _count;
+
+        // Free list index in the low half, ABA tag in the high half.
+        std::atomic<uint64_t> _head;
+
+        std::atomic<size_type> _leased;
+
+        static void _aio_cb(void* slotp);
+
+        _AioSlot* lease();
+
+        void release(_AioSlot* const slotp);
+
+        void init(const duration_type* const timeoutp);
+
+    public:
+
+        _AioPool(size_type count);
+
+        _AioPool(size_type count, const duration_type& timeout);
+
+        _AioPool(const _AioPool&) = delete;
+
+        _AioPool& operator=(const _AioPool&) = delete;
+
+        virtual ~_AioPool();
+
+        // Returns false, leaving the message alone, when every AIO is already leased.
+        bool TrySend(_Socket& s, _Message& m, const handler_type& on_sent);
+
+        // Returns false when every AIO is already leased.
+        bool TryReceive(_Socket& s, const handler_type& on_received);
+
+        size_type GetCapacity() const;
+
+        size_type GetLeased() const;
+    };
+
+    typedef _AioPool aio_pool;
+}
+
+#endif // NNGCPP_AIO_POOL_H
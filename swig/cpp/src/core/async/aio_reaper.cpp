@@ -0,0 +1,96 @@
+#include "aio_reaper.h"
+#include "../types.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+namespace nng {
+
+    class __aio_reaper {
+    private:
+
+        typedef std::pair<_AioReaper::aio_type*, _AioReaper::stopped_func> item_type;
+
+        std::mutex _mutex;
+
+        std::condition_variable _cv;
+
+        std::deque<item_type> _items;
+
+        size_type _busy;
+
+        bool _stopping;
+
+        // Declared last so that everything else is ready by the time it runs.
+        std::thread _thread;
+
+        void run() {
+            std::unique_lock<std::mutex> lock(_mutex);
+            for (;;) {
+                _cv.wait(lock, [&]() { return _stopping || !_items.empty(); });
+                if (_items.empty()) { return; }
+                auto item = std::move(_items.front());
+                _items.pop_front();
+                ++_busy;
+                lock.unlock();
+                // Waits for any callback in flight, which is the whole point of doing this here.
+                ::nng_aio_stop(item.first);
+                item.second();
+                lock.lock();
+                --_busy;
+                _cv.notify_all();
+            }
+        }
+
+    public:
+
+        __aio_reaper()
+            : _mutex(), _cv(), _items(), _busy(0), _stopping(false)
+            , _thread(&__aio_reaper::run, this) {
+        }
+
+        ~__aio_reaper() {
+            {
+                std::lock_guard<std::mutex> guard(_mutex);
+                _stopping = true;
+            }
+            _cv.notify_all();
+            _thread.join();
+        }
+
+        void reap(_AioReaper::aio_type* const aiop, const _AioReaper::stopped_func& on_stopped) {
+            {
+                std::lock_guard<std::mutex> guard(_mutex);
+                _items.emplace_back(aiop, on_stopped);
+            }
+            _cv.notify_all();
+        }
+
+        void drain() {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _cv.wait(lock, [&]() { return _items.empty() && _busy == 0; });
+        }
+    };
+
+    // So that draining does not start a thread when nothing was ever reaped.
+    static std::atomic<bool> __reaper_started(false);
+
+    __aio_reaper& __get_reaper() {
+        static __aio_reaper reaper;
+        __reaper_started = true;
+        return reaper;
+    }
+
+    void _AioReaper::Reap(aio_type* const aiop, const stopped_func& on_stopped) {
+        __get_reaper().reap(aiop, on_stopped);
+    }
+
+    void _AioReaper::Drain() {
+        if (!__reaper_started) { return; }
+        __get_reaper().drain();
+    }
+}
@@ -0,0 +1,31 @@
+#ifndef NNGCPP_AIO_REAPER_H
+#define NNGCPP_AIO_REAPER_H
+
+#define NNG_ONLY
+#include <nngcpp.h>
+
+#include <functional>
+
+namespace nng {
+
+    /* An AIO cannot be stopped, nor freed, from within its own callback, since either one waits
+    for that callback to return. Operations that only learn they are finished from that callback
+    hand their AIO off here instead: a single background thread stops it, then invokes the given
+    function, which is responsible for freeing the AIO along with whatever state went with it. */
+    class _AioReaper {
+    public:
+
+        typedef ::nng_aio aio_type;
+
+        typedef std::function<void()> stopped_func;
+
+        static void Reap(aio_type* const aiop, const stopped_func& on_stopped);
+
+        // Blocks until everything handed off so far has been reaped, i.e. prior to nng_fini.
+        static void Drain();
+    };
+
+    typedef _AioReaper aio_reaper;
+}
+
+#endif // NNGCPP_AIO_REAPER_H
@@ -0,0 +1,269 @@
+#include "async_future.h"
+#include "aio_reaper.h"
+#include "../exceptions/nng_exception.h"
+#include "../../messaging/binary_message.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <limits>
+#include <mutex>
+
+namespace nng {
+
+    using nng::exceptions::nng_exception;
+
+    struct _AsyncFutureState {
+
+        std::mutex mutex;
+
+        std::condition_variable cv;
+
+        bool ready;
+
+        error_code_type ec;
+
+        std::unique_ptr<binary_message> msgp;
+
+        size_type index;
+
+        std::vector<_AsyncFuture::ready_func> callbacks;
+
+        _AsyncFutureState()
+            : mutex(), cv(), ready(false), ec(ec_enone), msgp()
+            , index(std::numeric_limits<size_type>::max()), callbacks() {
+        }
+    };
+
+    _AsyncFuture::_AsyncFuture(const std::shared_ptr<_AsyncFutureState>& statep)
+        : _statep(statep) {
+    }
+
+    _AsyncFuture::~_AsyncFuture() {
+    }
+
+    bool _AsyncFuture::IsReady() const {
+        std::lock_guard<std::mutex> guard(_statep->mutex);
+        return _statep->ready;
+    }
+
+    void _AsyncFuture::Wait() const {
+        std::unique_lock<std::mutex> lock(_statep->mutex);
+        _statep->cv.wait(lock, [&]() { return _statep->ready; });
+    }
+
+    bool _AsyncFuture::WaitFor(const duration_type& timeout) const {
+        std::unique_lock<std::mutex> lock(_statep->mutex);
+        return _statep->cv.wait_for(lock, timeout, [&]() { return _statep->ready; });
+    }
+
+    error_code_type _AsyncFuture::GetResult() const {
+        Wait();
+        std::lock_guard<std::mutex> guard(_statep->mutex);
+        return _statep->ec;
+    }
+
+    std::unique_ptr<_Message> _AsyncFuture::Get() {
+        Wait();
+        std::lock_guard<std::mutex> guard(_statep->mutex);
+        // The message, if any, stays put for Cede.
+        if (_statep->ec != ec_enone) { throw nng_exception(_statep->ec); }
+        return std::move(_statep->msgp);
+    }
+
+    std::unique_ptr<_Message> _AsyncFuture::Cede() {
+        Wait();
+        std::lock_guard<std::mutex> guard(_statep->mutex);
+        return std::move(_statep->msgp);
+    }
+
+    size_type _AsyncFuture::GetIndex() const {
+        Wait();
+        std::lock_guard<std::mutex> guard(_statep->mutex);
+        return _statep->index;
+    }
+
+    void _AsyncFuture::OnReady(const ready_func& on_ready) const {
+        {
+            std::lock_guard<std::mutex> guard(_statep->mutex);
+            if (!_statep->ready) {
+                _statep->callbacks.push_back(on_ready);
+                return;
+            }
+        }
+        _AsyncFuture f(_statep);
+        on_ready(f);
+    }
+
+    _AsyncFuture _AsyncFuture::Then(const continuation_func& continuation) const {
+        const _AsyncPromise next;
+        OnReady([next, continuation](_AsyncFuture& f) {
+            try {
+                continuation(f).OnReady([next](_AsyncFuture& g) {
+                    next.SetResult(g.GetResult(), g.Cede());
+                });
+            }
+            catch (const nng_exception& ex) {
+                next.SetResult(ex.error_code);
+            }
+            catch (...) {
+                next.SetResult(ec_einternal);
+            }
+        });
+        return next.GetFuture();
+    }
+
+    struct __future_op {
+
+        ::nng_aio* aiop;
+
+        _AsyncPromise promise;
+
+        bool sending;
+
+        __future_op(bool sending)
+            : aiop(nullptr), promise(), sending(sending) {
+        }
+    };
+
+    _AsyncPromise::_AsyncPromise()
+        : _statep(std::make_shared<_AsyncFutureState>()) {
+    }
+
+    _AsyncPromise::~_AsyncPromise() {
+    }
+
+    _AsyncFuture _AsyncPromise::GetFuture() const {
+        return _AsyncFuture(_statep);
+    }
+
+    bool _AsyncPromise::SetResult(error_code_type ec, std::unique_ptr<_Message> msgp) const {
+
+        std::vector<_AsyncFuture::ready_func> callbacks;
+
+        {
+            std::lock_guard<std::mutex> guard(_statep->mutex);
+            if (_statep->ready) { return false; }
+            _statep->ready = true;
+            _statep->ec = ec;
+            _statep->msgp = std::move(msgp);
+            callbacks.swap(_statep->callbacks);
+        }
+
+        _statep->cv.notify_all();
+
+        _AsyncFuture f(_statep);
+
+        for (auto& on_ready : callbacks) {
+            on_ready(f);
+        }
+
+        return true;
+    }
+
+    void _AsyncPromise::_aio_cb(void* opp) {
+
+        auto __opp = static_cast<__future_op*>(opp);
+
+        const auto aiop = __opp->aiop;
+        const auto ec = static_cast<error_code_type>(::nng_aio_result(aiop));
+        // Successful sends belong to NNG; otherwise the message, if any, is still ours.
+        const auto has_msg = __opp->sending ? ec != ec_enone : ec == ec_enone;
+
+        std::unique_ptr<binary_message> msgp;
+        if (has_msg) { msgp = std::make_unique<binary_message>(::nng_aio_get_msg(aiop)); }
+        ::nng_aio_set_msg(aiop, nullptr);
+
+        __opp->promise.SetResult(ec, std::move(msgp));
+
+        // The reaper waits for this callback to return before freeing anything.
+        _AioReaper::Reap(aiop, [__opp]() {
+            ::nng_aio_free(__opp->aiop);
+            delete __opp;
+        });
+    }
+
+    _AsyncFuture _AsyncPromise::start(nng_type sid, bool sending, msg_type* const msgp, const duration_type* const timeoutp) {
+
+        auto opp = new __future_op(sending);
+        const auto future = opp->promise.GetFuture();
+
+        const auto errnum = ::nng_aio_alloc(&opp->aiop, &_AsyncPromise::_aio_cb, (void*)opp);
+
+        if (errnum != 0) {
+            // Failures are delivered through the future, along with any unsent message.
+            const auto promise = opp->promise;
+            delete opp;
+            promise.SetResult(static_cast<error_code_type>(errnum)
+                , msgp ? std::make_unique<binary_message>(msgp) : nullptr);
+            return future;
+        }
+
+        if (timeoutp) {
+            ::nng_aio_set_timeout(opp->aiop, static_cast<duration_rep_type>(timeoutp->count()));
+        }
+
+        if (sending) {
+            ::nng_aio_set_msg(opp->aiop, msgp);
+            ::nng_send_aio(sid, opp->aiop);
+        }
+        else {
+            ::nng_recv_aio(sid, opp->aiop);
+        }
+
+        return future;
+    }
+
+    _AsyncFuture when_all(const std::vector<_AsyncFuture>& futures) {
+
+        const _AsyncPromise promise;
+
+        if (futures.empty()) {
+            promise.SetResult(ec_enone);
+            return promise.GetFuture();
+        }
+
+        // Each result is written once, and only read after the last one has been counted.
+        const auto resultsp = std::make_shared<std::vector<error_code_type>>(futures.size(), ec_enone);
+        const auto remainingp = std::make_shared<std::atomic<size_type>>(futures.size());
+
+        for (size_type i = 0; i < futures.size(); i++) {
+            futures[i].OnReady([promise, resultsp, remainingp, i](_AsyncFuture& f) {
+                (*resultsp)[i] = f.GetResult();
+                if (--*remainingp != 0) { return; }
+                const auto it = std::find_if(resultsp->begin(), resultsp->end()
+                    , [](error_code_type ec) { return ec != ec_enone; });
+                promise.SetResult(it == resultsp->end() ? ec_enone : *it);
+            });
+        }
+
+        return promise.GetFuture();
+    }
+
+    _AsyncFuture when_any(const std::vector<_AsyncFuture>& futures) {
+
+        const _AsyncPromise promise;
+        const auto result = promise.GetFuture();
+
+        if (futures.empty()) {
+            promise.SetResult(ec_einval);
+            return result;
+        }
+
+        const auto firedp = std::make_shared<std::atomic<bool>>(false);
+
+        for (size_type i = 0; i < futures.size(); i++) {
+            futures[i].OnReady([promise, result, firedp, i](_AsyncFuture& f) {
+                if (firedp->exchange(true)) { return; }
+                {
+                    std::lock_guard<std::mutex> guard(result._statep->mutex);
+                    result._statep->index = i;
+                }
+                // The message stays with the winning future, i.e. futures[GetIndex()].
+                promise.SetResult(f.GetResult());
+            });
+        }
+
+        return result;
+    }
+}
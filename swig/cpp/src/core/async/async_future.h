@@ -0,0 +1,116 @@
+#ifndef NNGCPP_ASYNC_FUTURE_H
+#define NNGCPP_ASYNC_FUTURE_H
+
+#define NNG_ONLY
+#include <nngcpp.h>
+
+#include "../types.h"
+#include "../enums.h"
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace nng {
+
+#ifndef NNGCPP_SOCKET_H
+    class _Socket;
+#endif // NNGCPP_SOCKET_H
+
+#ifndef NNGCPP_BINARY_MESSAGE_H
+    class _Message;
+#endif // NNGCPP_BINARY_MESSAGE_H
+
+    // Shared between a future and its promise; defined alongside the AIO callback.
+    struct _AsyncFutureState;
+
+    class _AsyncPromise;
+
+    /* A lightweight, copyable handle on the result of an asynchronous operation, which is an
+    error code along with a message: the received message on success, or the unsent message
+    when a send fails. Continuations run on whichever thread completes the future, which is
+    usually an NNG thread, so they should be brief and must not throw. */
+    class _AsyncFuture {
+    public:
+
+        typedef std::function<void(_AsyncFuture&)> ready_func;
+
+        typedef std::function<_AsyncFuture(_AsyncFuture&)> continuation_func;
+
+    private:
+
+        friend class _AsyncPromise;
+
+        friend _AsyncFuture when_any(const std::vector<_AsyncFuture>& futures);
+
+        std::shared_ptr<_AsyncFutureState> _statep;
+
+        _AsyncFuture(const std::shared_ptr<_AsyncFutureState>& statep);
+
+    public:
+
+        virtual ~_AsyncFuture();
+
+        bool IsReady() const;
+
+        void Wait() const;
+
+        // Returns whether the future is ready.
+        bool WaitFor(const duration_type& timeout) const;
+
+        // Waits for the result without throwing.
+        error_code_type GetResult() const;
+
+        // Waits, then throws nng_exception on failure; otherwise cedes the message, if any.
+        std::unique_ptr<_Message> Get();
+
+        // Waits, then cedes the message, if any, regardless of the result.
+        std::unique_ptr<_Message> Cede();
+
+        // Identifies the future that completed first, for when_any.
+        size_type GetIndex() const;
+
+        // Invokes the function once the future is ready, immediately if it already is.
+        void OnReady(const ready_func& on_ready) const;
+
+        /* Invokes the continuation once the future is ready. The returned future completes along
+        with whichever future the continuation returns, which allows operations to be chained. */
+        _AsyncFuture Then(const continuation_func& continuation) const;
+    };
+
+    class _AsyncPromise {
+    private:
+
+        friend class _Socket;
+
+        typedef ::nng_socket nng_type;
+
+        std::shared_ptr<_AsyncFutureState> _statep;
+
+        static void _aio_cb(void* opp);
+
+        static _AsyncFuture start(nng_type sid, bool sending, msg_type* const msgp, const duration_type* const timeoutp);
+
+    public:
+
+        _AsyncPromise();
+
+        virtual ~_AsyncPromise();
+
+        _AsyncFuture GetFuture() const;
+
+        // Completes the future once; returns false when it was already complete.
+        bool SetResult(error_code_type ec, std::unique_ptr<_Message> msgp = nullptr) const;
+    };
+
+    // Completes once every future has, with the first failure in order, if any.
+    _AsyncFuture when_all(const std::vector<_AsyncFuture>& futures);
+
+    // Completes along with the first future to do so, which is identified by GetIndex.
+    _AsyncFuture when_any(const std::vector<_AsyncFuture>& futures);
+
+    typedef _AsyncFuture async_future;
+    typedef _AsyncPromise async_promise;
+}
+
+#endif // NNGCPP_ASYNC_FUTURE_H
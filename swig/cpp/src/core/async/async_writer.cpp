@@ -4,16 +4,14 @@
 namespace nng {
 
     _AsyncOptionWriter::_AsyncOptionWriter()
-        : _setopt_duration() {
+        : _aiop(nullptr), _setopt_duration(nullptr) {
     }
 
     _AsyncOptionWriter::~_AsyncOptionWriter() {}
 
-    void _AsyncOptionWriter::set_setters(
-        const setopt_duration_func& setopt_duration) {
-
-        // Cast the constness away from the setters long enough to install the new ones.
-        const_cast<setopt_duration_func&>(_setopt_duration) = setopt_duration;
+    void _AsyncOptionWriter::set_setters(aio_type* const aiop, setopt_duration_func setopt_duration) {
+        _aiop = aiop;
+        _setopt_duration = setopt_duration;
     }
 
     void _AsyncOptionWriter::SetTimeoutDuration(const duration_type& val) {
@@ -21,6 +19,7 @@ namespace nng {
     }
 
     void _AsyncOptionWriter::SetTimeoutMilliseconds(duration_rep_type val) {
-        invocation::with_void_return_value(_setopt_duration, val);
+        if (_aiop == nullptr) { return; }
+        invocation::with_void_return_value(_setopt_duration, _aiop, val);
     }
 }
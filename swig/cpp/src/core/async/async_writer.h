@@ -3,7 +3,6 @@
 
 #include "../types.h"
 
-#include <functional>
 
 namespace nng {
 
@@ -18,9 +17,13 @@ namespace nng {
     struct _AsyncOptionWriter {
     private:
 
-        typedef std::function<void(duration_rep_type)> setopt_duration_func;
+        typedef ::nng_aio aio_type;
 
-        const setopt_duration_func _setopt_duration;
+        typedef void(*setopt_duration_func)(aio_type*, duration_rep_type);
+
+        aio_type* _aiop;
+
+        setopt_duration_func _setopt_duration;
 
     protected:
 
@@ -29,7 +32,7 @@ namespace nng {
         friend class _BasicAsyncService;
 
         // TODO: TBD: ditto sticky friendship web...
-        void set_setters(const setopt_duration_func& setopt_duration);
+        void set_setters(aio_type* const aiop, setopt_duration_func setopt_duration);
 
         _AsyncOptionWriter();
 
@@ -0,0 +1,136 @@
+#include "awaitable.h"
+
+#ifdef NNGCPP_ENABLE_COROUTINES
+
+#include "aio_reaper.h"
+#include "../invocation.hpp"
+#include "../../messaging/binary_message.h"
+
+#include <atomic>
+
+namespace nng {
+
+    enum __await_status : int {
+        __await_idle
+        , __await_pending
+        , __await_completed
+        , __await_abandoned
+    };
+
+    struct _AwaitState {
+
+        ::nng_aio* aiop;
+
+        std::coroutine_handle<> h;
+
+        std::atomic<int> status;
+
+        bool sending;
+
+        _AwaitState()
+            : aiop(nullptr), h(), status(__await_idle), sending(false) {
+        }
+
+        ~_AwaitState() {
+            if (aiop == nullptr) { return; }
+            auto msgp = ::nng_aio_get_msg(aiop);
+            const auto rv = ::nng_aio_result(aiop);
+            // Failed sends leave their message with the AIO, as do receives that nobody resumed to claim.
+            if (msgp && (sending ? rv != 0 : rv == 0)) {
+                ::nng_msg_free(msgp);
+            }
+            ::nng_aio_free(aiop);
+        }
+    };
+
+    void __on_await_complete(void* arg) {
+        auto statep = static_cast<_AwaitState*>(arg);
+        auto expected = static_cast<int>(__await_pending);
+        // Abandoned operations belong to the reaper; there is nothing left to resume.
+        if (!statep->status.compare_exchange_strong(expected, __await_completed)) { return; }
+        // Nothing may touch the state after this, since the coroutine may well hand it to the reaper.
+        statep->h.resume();
+    }
+
+    _AwaitableBase::_AwaitableBase(nng_type sid)
+        : _statep(new _AwaitState()), _sid(sid) {
+
+        try {
+            invocation::with_default_error_handling(&::nng_aio_alloc, &_statep->aiop
+                , &__on_await_complete, (void*)_statep);
+        }
+        catch (...) {
+            delete _statep;
+            throw;
+        }
+    }
+
+    _AwaitableBase::~_AwaitableBase() {
+        auto expected = static_cast<int>(__await_pending);
+        if (_statep->status.compare_exchange_strong(expected, __await_abandoned)) {
+            // The coroutine was destroyed while suspended, so there is no one left to resume.
+            ::nng_aio_cancel(_statep->aiop);
+        }
+        else if (expected == __await_idle) {
+            // Never started, so there cannot be a callback in flight.
+            delete _statep;
+            return;
+        }
+        const auto statep = _statep;
+        _AioReaper::Reap(statep->aiop, [statep]() { delete statep; });
+    }
+
+    bool _AwaitableBase::await_ready() const noexcept {
+        return false;
+    }
+
+    ::nng_aio* _AwaitableBase::prepare(std::coroutine_handle<> h) {
+        _statep->h = h;
+        _statep->status = __await_pending;
+        return _statep->aiop;
+    }
+
+    ::nng_aio* _AwaitableBase::get_aio() const {
+        return _statep->aiop;
+    }
+
+    _ReceiveAwaitable::_ReceiveAwaitable(nng_type sid)
+        : _AwaitableBase(sid) {
+    }
+
+    void _ReceiveAwaitable::await_suspend(std::coroutine_handle<> h) {
+        ::nng_recv_aio(_sid, prepare(h));
+    }
+
+    std::unique_ptr<_Message> _ReceiveAwaitable::await_resume() {
+        const auto aiop = get_aio();
+        invocation::with_default_error_handling(&::nng_aio_result, aiop);
+        auto msgp = ::nng_aio_get_msg(aiop);
+        // The message is ours now, so make sure it is not freed along with the AIO.
+        ::nng_aio_set_msg(aiop, nullptr);
+        return std::make_unique<binary_message>(msgp);
+    }
+
+    _SendAwaitable::_SendAwaitable(nng_type sid, _Message& m)
+        : _AwaitableBase(sid), _m(m) {
+
+        _statep->sending = true;
+    }
+
+    void _SendAwaitable::await_suspend(std::coroutine_handle<> h) {
+        ::nng_aio_set_msg(get_aio(), _m.cede_message());
+        ::nng_send_aio(_sid, prepare(h));
+    }
+
+    void _SendAwaitable::await_resume() {
+        const auto aiop = get_aio();
+        if (invocation::with_error_code(&::nng_aio_result, aiop) != ec_enone) {
+            // NNG only assumes ownership on success, so the message goes back to the caller.
+            _m.retain(::nng_aio_get_msg(aiop));
+            ::nng_aio_set_msg(aiop, nullptr);
+        }
+        invocation::with_default_error_handling(&::nng_aio_result, aiop);
+    }
+}
+
+#endif // NNGCPP_ENABLE_COROUTINES
@@ -0,0 +1,99 @@
+#ifndef NNGCPP_AWAITABLE_H
+#define NNGCPP_AWAITABLE_H
+
+// Coroutine support is opt-in, i.e. NNGCPP_ENABLE_COROUTINES, since it requires C++20.
+#ifdef NNGCPP_ENABLE_COROUTINES
+
+#define NNG_ONLY
+#include <nngcpp.h>
+
+#include "../types.h"
+#include "../enums.h"
+
+#include <coroutine>
+#include <memory>
+
+namespace nng {
+
+#ifndef NNGCPP_SOCKET_H
+    class _Socket;
+#endif // NNGCPP_SOCKET_H
+
+#ifndef NNGCPP_BINARY_MESSAGE_H
+    class _Message;
+#endif // NNGCPP_BINARY_MESSAGE_H
+
+    // Defined alongside the AIO callback; awaitables only ever see it by pointer.
+    struct _AwaitState;
+
+    /* Suspends the awaiting coroutine on an NNG AIO. The AIO completion callback resumes the
+    coroutine directly, on whichever NNG thread completed the operation. Destroying a coroutine
+    that is suspended here cancels the operation. The AIO itself is never stopped or freed in
+    line, since that may happen from within its own callback; rather, it is handed off to the
+    AIO reaper. */
+    class _AwaitableBase {
+    protected:
+
+        typedef ::nng_socket nng_type;
+
+        _AwaitState* _statep;
+
+        nng_type _sid;
+
+        _AwaitableBase(nng_type sid);
+
+        // Records the coroutine to resume, after which the operation may complete at any moment.
+        ::nng_aio* prepare(std::coroutine_handle<> h);
+
+        ::nng_aio* get_aio() const;
+
+    public:
+
+        _AwaitableBase(const _AwaitableBase&) = delete;
+
+        _AwaitableBase& operator=(const _AwaitableBase&) = delete;
+
+        virtual ~_AwaitableBase();
+
+        bool await_ready() const noexcept;
+    };
+
+    class _ReceiveAwaitable : public _AwaitableBase {
+    private:
+
+        friend class _Socket;
+
+        _ReceiveAwaitable(nng_type sid);
+
+    public:
+
+        void await_suspend(std::coroutine_handle<> h);
+
+        // Throws nng_exception when the receive failed, i.e. timed out.
+        std::unique_ptr<_Message> await_resume();
+    };
+
+    class _SendAwaitable : public _AwaitableBase {
+    private:
+
+        friend class _Socket;
+
+        _Message& _m;
+
+        _SendAwaitable(nng_type sid, _Message& m);
+
+    public:
+
+        void await_suspend(std::coroutine_handle<> h);
+
+        // Throws nng_exception when the send failed, after the message is returned to the caller.
+        void await_resume();
+    };
+
+    typedef _ReceiveAwaitable receive_awaitable;
+    typedef _SendAwaitable send_awaitable;
+}
+
+#endif // NNGCPP_ENABLE_COROUTINES
+
+#endif // NNGCPP_AWAITABLE_H
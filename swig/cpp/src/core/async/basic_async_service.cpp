@@ -4,8 +4,6 @@
 
 namespace nng {
 
-    using std::bind;
-    using std::placeholders::_1;
     using nng::exceptions::invalid_operation;
 
     _BasicAsyncService::_BasicAsyncService()
@@ -14,9 +12,7 @@ namespace nng {
 
     _BasicAsyncService::_BasicAsyncService(const basic_callback_func& on_cb)
         : IHaveOne(), ICanClose(), IHaveOptions()
-        , _aiop(nullptr), _on_cb()
-        , _free(), _wait(), _stop(), _cancel()
-        , _result(), _get_msg(), _set_msg() {
+        , _aiop(nullptr), _metricsp(), _sending(false), _sz(0), _started(), _on_cb() {
 
         Start(on_cb);
     }
@@ -27,7 +23,7 @@ namespace nng {
 
     void _BasicAsyncService::free() {
         if (!HasOne()) { return; }
-        invocation::with_void_return_value(_free);
+        invocation::with_void_return_value(&::nng_aio_free, _aiop);
         _aiop = nullptr;
     }
 
@@ -35,26 +31,53 @@ namespace nng {
 
         auto op = GetOptions();
 
-        op->set_setters(
-            bind(&::nng_aio_set_timeout, aiop, _1)
-        );
-
-        _free = bind(&::nng_aio_free, aiop);
-        _wait = bind(&::nng_aio_wait, aiop);
-        _stop = bind(&::nng_aio_stop, aiop);
-        _cancel = bind(&::nng_aio_cancel, aiop);
-        _result = bind(&::nng_aio_result, aiop);
-        _get_msg = bind(&::nng_aio_get_msg, aiop);
-        _set_msg = bind(&::nng_aio_set_msg, aiop, _1);
+        op->set_setters(aiop, &::nng_aio_set_timeout);
     }
 
     void _BasicAsyncService::_aoi_cb(void* selfp) {
         // There is not much we can do if it isn't "this".
         auto __selfp = static_cast<basic_async_service*>(selfp);
         if (!__selfp) throw invalid_operation("Invalid asynchronous callback");
+        if (__selfp->_metricsp) { __selfp->on_completed(); }
         __selfp->_on_cb();
     }
 
+    void _BasicAsyncService::on_starting(const std::shared_ptr<_Metrics>& metricsp, bool sending) const {
+        // Leaves the shared pointer alone in the usual case, where neither has metrics.
+        if (!metricsp && !_metricsp) { return; }
+        _metricsp = metricsp;
+        if (!_metricsp) { return; }
+        _sending = sending;
+        // A successful send leaves nothing behind to measure, so we do that up front.
+        const auto msgp = sending ? ::nng_aio_get_msg(_aiop) : nullptr;
+        _sz = msgp ? ::nng_msg_header_len(msgp) + ::nng_msg_len(msgp) : 0;
+        _started = _Metrics::clock_type::now();
+    }
+
+    void _BasicAsyncService::on_completed() {
+
+        const auto& mp = _metricsp;
+        const auto ec = invocation::with_error_code(&::nng_aio_result, _aiop);
+
+        mp->Count(metric_aio_completions);
+        mp->Record(metric_aio_latency, _started);
+
+        if (ec == ec_etimedout) {
+            mp->Count(metric_timeouts);
+        }
+        else if (ec != ec_enone) {
+            return;
+        }
+        else if (_sending) {
+            mp->Count(metric_messages_sent);
+            mp->Count(metric_bytes_sent, _sz);
+        }
+        else if (const auto msgp = ::nng_aio_get_msg(_aiop)) {
+            mp->Count(metric_messages_received);
+            mp->Count(metric_bytes_received, ::nng_msg_header_len(msgp) + ::nng_msg_len(msgp));
+        }
+    }
+
     bool _BasicAsyncService::HasOne() const {
         return _aiop != nullptr;
     }
@@ -80,25 +103,27 @@ namespace nng {
     void _BasicAsyncService::Start() {
         // This version of Start leaves the Callback intact, whatever was once upon a time.
         if (HasOne()) { return; }
-        auto alloc = bind(&::nng_aio_alloc, _1, &basic_async_service::_aoi_cb, this);
-        invocation::with_default_error_handling(alloc, &_aiop);
+        invocation::with_default_error_handling(&::nng_aio_alloc, &_aiop, &basic_async_service::_aoi_cb, (void*)this);
         configure(_aiop);
     }
 
     void _BasicAsyncService::Wait() const {
-        invocation::with_void_return_value(_wait);
+        if (!HasOne()) { return; }
+        invocation::with_void_return_value(&::nng_aio_wait, _aiop);
     }
     
     void _BasicAsyncService::Stop() const {
-        invocation::with_void_return_value(_stop);
+        if (!HasOne()) { return; }
+        invocation::with_void_return_value(&::nng_aio_stop, _aiop);
     }
     
     void _BasicAsyncService::Cancel() const {
-        invocation::with_void_return_value(_cancel);
+        if (!HasOne()) { return; }
+        invocation::with_void_return_value(&::nng_aio_cancel, _aiop);
     }
 
     bool _BasicAsyncService::Success() const {
-        invocation::with_default_error_handling(_result);
+        invocation::with_default_error_handling(&::nng_aio_result, _aiop);
         return true;
     }
 
@@ -112,6 +137,11 @@ namespace nng {
         }
     }
 
+    error_code_type _BasicAsyncService::GetResult() const {
+        if (!HasOne()) { return ec_estate; }
+        return invocation::with_error_code(&::nng_aio_result, _aiop);
+    }
+
     void _BasicAsyncService::TimedWait(const duration_type& timeout) {
         GetOptions()->SetTimeoutDuration(timeout);
         Wait();
@@ -125,13 +155,13 @@ namespace nng {
     // TODO: TBD: really, these should probably be more an effect of engaging the Socket with the AIO service.
     void _BasicAsyncService::Retain(_Message& m) const {
         // Similarly with Socket send/receive, Message Cedes ownership to the AIO.
-        invocation::with_void_return_value(_set_msg, m.cede_message());
+        invocation::with_void_return_value(&::nng_aio_set_msg, _aiop, m.cede_message());
     }
 
     void _BasicAsyncService::Cede(_Message& m) const {
         msg_type* msgp = nullptr;
         // Ditto re: Ceding/resuming ownership.
-        invocation::with_result(_get_msg, &msgp);
+        invocation::with_result(&::nng_aio_get_msg, &msgp, _aiop);
         if (!msgp) { return; }
         m.retain(msgp);
     }
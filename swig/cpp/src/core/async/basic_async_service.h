@@ -5,6 +5,9 @@
 #include <nngcpp.h>
 
 #include "../types.h"
+#include "../enums.h"
+
+#include "../metrics.h"
 
 #include "../IHaveOne.hpp"
 #include "../ICanClose.hpp"
@@ -13,6 +16,7 @@
 #include "../../options/IHaveOptions.hpp"
 
 #include <functional>
+#include <memory>
 
 namespace nng {
 
@@ -37,22 +41,21 @@ namespace nng {
 
         static void _aoi_cb(void* selfp);
 
-        typedef std::function<void()> void_noarg_func;
-        typedef std::function<int()> int_noarg_func;
+        // Operations call straight through to the nng_aio_* API on the AIO itself.
+        void configure(aio_type* const aiop);
 
-        typedef std::function<msg_type*()> msg_ptr_func;
-        typedef std::function<void(msg_type*)> void_ptr_msg_func;
+        // The socket starting the operation passes along its metrics, if any.
+        mutable std::shared_ptr<_Metrics> _metricsp;
 
-        void_noarg_func _free;
-        void_noarg_func _wait;
-        void_noarg_func _stop;
-        void_noarg_func _cancel;
-        int_noarg_func _result;
+        mutable bool _sending;
 
-        msg_ptr_func _get_msg;
-        void_ptr_msg_func _set_msg;
+        mutable size_type _sz;
 
-        void configure(aio_type* const aiop);
+        mutable _Metrics::clock_type::time_point _started;
+
+        void on_starting(const std::shared_ptr<_Metrics>& metricsp, bool sending) const;
+
+        void on_completed();
 
     public:
 
@@ -86,6 +89,9 @@ namespace nng {
 
         virtual bool TrySuccess() const;
 
+        // Returns the result of the last operation without throwing.
+        virtual error_code_type GetResult() const;
+
         virtual void TimedWait(const duration_type& timeout);
 
         virtual void TimedWait(duration_rep_type val);
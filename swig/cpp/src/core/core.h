@@ -9,6 +9,8 @@
 #include "endpoint.h"
 #include "enums.h"
 #include "listener.h"
+#include "metrics.h"
+#include "reactor.h"
 #include "IReceiver.h"
 #include "ISender.h"
 #include "session.h"
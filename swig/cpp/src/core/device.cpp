@@ -21,7 +21,14 @@ namespace nng {
 
     device::device(_Socket* const asockp, _Socket* const bsockp, bool shouldCloseSockets)
         : _pathp(std::make_unique<device_path>(asockp, bsockp, shouldCloseSockets))
-            , _threadp(std::make_unique<std::thread>(nng::install_device_sockets_callback, _pathp.get())) {
+            , _threadp(std::make_unique<std::thread>(nng::install_device_sockets_callback, _pathp.get()))
+            , _forwarderp() {
+    }
+
+    device::device(_Socket* const asockp, _Socket* const bsockp, bool shouldCloseSockets, size_type workers_per_direction)
+        : _pathp(std::make_unique<device_path>(asockp, bsockp, shouldCloseSockets))
+            , _threadp()
+            , _forwarderp(std::make_unique<device_forwarder>(*asockp, *bsockp, workers_per_direction)) {
     }
 
     device::~device() {
@@ -32,7 +39,18 @@ namespace nng {
 
         _pathp.release();
 
+        // Which cancels anything the forwarder still has in flight.
+        _forwarderp.reset();
+
         // Then we should be able to re-join the thread.
-        _threadp->join();
+        if (_threadp) { _threadp->join(); }
+    }
+
+    bool device::Stop(const duration_type& timeout) {
+        return _forwarderp ? _forwarderp->Stop(timeout) : false;
+    }
+
+    device_stats device::GetStats() const {
+        return _forwarderp ? _forwarderp->GetStats() : device_stats();
     }
 }
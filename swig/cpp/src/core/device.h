@@ -2,6 +2,7 @@
 #define NNGCPP_DEVICE_H
 
 #include "socket.h"
+#include "device_forwarder.h"
 
 #include <memory>
 #include <thread>
@@ -26,11 +27,22 @@ namespace nng {
 
             std::unique_ptr<std::thread> _threadp;
 
+            std::unique_ptr<device_forwarder> _forwarderp;
+
         public:
 
             device(_Socket* const asockp, _Socket* const bsockp, bool shouldCloseSockets);
 
+            // Forwards natively with a number of worker loops per direction rather than via nng_device.
+            device(_Socket* const asockp, _Socket* const bsockp, bool shouldCloseSockets, size_type workers_per_direction);
+
             virtual ~device();
+
+            // Always false for the nng_device mode, which cannot be stopped short of closing its sockets.
+            virtual bool Stop(const duration_type& timeout);
+
+            // Counters are only kept in the native forwarding mode.
+            virtual device_stats GetStats() const;
     };
 }
 
@@ -0,0 +1,214 @@
+#include "device_forwarder.h"
+#include "socket.h"
+#include "invocation.hpp"
+#include "exceptions.hpp"
+#include "enums.h"
+
+namespace nng {
+
+    _DeviceDirectionStats::_DeviceDirectionStats()
+        : messages(0), bytes(0), drops(0) {
+    }
+
+    struct _ForwarderDirection {
+
+        ::nng_socket from;
+
+        ::nng_socket to;
+
+        std::atomic<uint64_t> messages;
+
+        std::atomic<uint64_t> bytes;
+
+        std::atomic<uint64_t> drops;
+
+        _ForwarderDirection(::nng_socket from, ::nng_socket to)
+            : from(from), to(to), messages(0), bytes(0), drops(0) {
+        }
+
+        _DeviceDirectionStats get_stats() const {
+            _DeviceDirectionStats result;
+            result.messages = messages.load();
+            result.bytes = bytes.load();
+            result.drops = drops.load();
+            return result;
+        }
+    };
+
+    struct _ForwarderWorker {
+
+        enum phase_type {
+            phase_idle,
+            phase_receiving,
+            phase_sending
+        };
+
+        _DeviceForwarder* const fwdp;
+
+        _ForwarderDirection* const dirp;
+
+        ::nng_aio* aiop;
+
+        // Guards phase transitions against Stop canceling the wrong operation.
+        std::mutex mutex;
+
+        phase_type phase;
+
+        size_type sz;
+
+        _ForwarderWorker(_DeviceForwarder* const fwdp, _ForwarderDirection* const dirp)
+            : fwdp(fwdp), dirp(dirp), aiop(nullptr), mutex(), phase(phase_idle), sz(0) {
+
+            invocation::with_default_error_handling(&::nng_aio_alloc, &aiop, &_ForwarderWorker::_aio_cb, (void*)this);
+        }
+
+        ~_ForwarderWorker() {
+            ::nng_aio_free(aiop);
+        }
+
+        // Expects the mutex to be held.
+        void start_receive() {
+            phase = phase_receiving;
+            ::nng_recv_aio(dirp->from, aiop);
+        }
+
+        // Expects the mutex to be held.
+        void finish() {
+            phase = phase_idle;
+            fwdp->on_worker_finished();
+        }
+
+        static void _aio_cb(void* workerp) {
+
+            auto __workerp = static_cast<_ForwarderWorker*>(workerp);
+            auto& w = *__workerp;
+
+            std::lock_guard<std::mutex> guard(w.mutex);
+
+            const auto aiop = w.aiop;
+            const auto ec = invocation::with_error_code(&::nng_aio_result, aiop);
+
+            if (w.phase == phase_receiving) {
+                if (ec != ec_enone) {
+                    // Closed or canceled means we are done; anything else is worth another try.
+                    if (ec == ec_eclosed || ec == ec_ecanceled || w.fwdp->_stopping) {
+                        w.finish();
+                    }
+                    else {
+                        w.start_receive();
+                    }
+                    return;
+                }
+                const auto msgp = ::nng_aio_get_msg(aiop);
+                w.sz = ::nng_msg_header_len(msgp) + ::nng_msg_len(msgp);
+                w.phase = phase_sending;
+                // The message is still attached to the AIO, which is all the send needs.
+                ::nng_send_aio(w.dirp->to, aiop);
+                return;
+            }
+
+            if (ec == ec_enone) {
+                ++w.dirp->messages;
+                w.dirp->bytes += w.sz;
+            }
+            else {
+                // NNG only assumes ownership on success.
+                ::nng_msg_free(::nng_aio_get_msg(aiop));
+                ::nng_aio_set_msg(aiop, nullptr);
+                ++w.dirp->drops;
+                if (ec == ec_eclosed) {
+                    w.finish();
+                    return;
+                }
+            }
+
+            if (w.fwdp->_stopping) {
+                w.finish();
+                return;
+            }
+
+            w.start_receive();
+        }
+    };
+
+    // Cooked sockets would consume the routing headers that the far side depends upon.
+    void __verify_raw(_Socket& s) {
+        if (!s.GetOptions()->GetInt32(_OptionNames::raw)) { THROW_NNG_EXCEPTION_EC(ec_einval); }
+    }
+
+    _DeviceForwarder::_DeviceForwarder(_Socket& a, _Socket& b, size_type workers_per_direction)
+        : _forwardp(std::make_unique<_ForwarderDirection>(a.sid, b.sid))
+        , _backwardp(std::make_unique<_ForwarderDirection>(b.sid, a.sid))
+        , _workers()
+        , _mutex(), _cv(), _active(0), _stopping(false), _stopped(false) {
+
+        // The same as nng_device, which refuses anything other than a pair of raw sockets.
+        __verify_raw(a);
+        __verify_raw(b);
+
+        if (workers_per_direction == 0) { workers_per_direction = 1; }
+
+        for (size_type i = 0; i < workers_per_direction; i++) {
+            _workers.push_back(std::make_unique<_ForwarderWorker>(this, _forwardp.get()));
+            _workers.push_back(std::make_unique<_ForwarderWorker>(this, _backwardp.get()));
+        }
+
+        // Allocate everything before starting anything, so that a failure leaves nothing running.
+        _active = _workers.size();
+
+        for (auto& wp : _workers) {
+            std::lock_guard<std::mutex> guard(wp->mutex);
+            wp->start_receive();
+        }
+    }
+
+    _DeviceForwarder::~_DeviceForwarder() {
+        Stop(duration_type::zero());
+    }
+
+    void _DeviceForwarder::on_worker_finished() {
+        {
+            std::lock_guard<std::mutex> guard(_mutex);
+            --_active;
+        }
+        _cv.notify_all();
+    }
+
+    bool _DeviceForwarder::Stop(const duration_type& timeout) {
+
+        if (_stopped) { return true; }
+
+        _stopping = true;
+
+        // Only idle receives are canceled; messages already received get the chance to drain.
+        for (auto& wp : _workers) {
+            std::lock_guard<std::mutex> guard(wp->mutex);
+            if (wp->phase == _ForwarderWorker::phase_receiving) {
+                ::nng_aio_cancel(wp->aiop);
+            }
+        }
+
+        bool drained;
+
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            drained = _cv.wait_for(lock, timeout, [&]() { return _active == 0; });
+        }
+
+        // Whatever remains is canceled, and stopping waits for every callback to return.
+        for (auto& wp : _workers) {
+            ::nng_aio_stop(wp->aiop);
+        }
+
+        _stopped = true;
+
+        return drained;
+    }
+
+    _DeviceStats _DeviceForwarder::GetStats() const {
+        _DeviceStats result;
+        result.forward = _forwardp->get_stats();
+        result.backward = _backwardp->get_stats();
+        return result;
+    }
+}
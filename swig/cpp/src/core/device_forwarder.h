@@ -0,0 +1,94 @@
+#ifndef NNGCPP_DEVICE_FORWARDER_H
+#define NNGCPP_DEVICE_FORWARDER_H
+
+#define NNG_ONLY
+#include <nngcpp.h>
+
+#include "types.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace nng {
+
+#ifndef NNGCPP_SOCKET_H
+    class _Socket;
+#endif // NNGCPP_SOCKET_H
+
+    struct _DeviceDirectionStats {
+
+        // Messages forwarded successfully.
+        uint64_t messages;
+
+        // Header plus body bytes forwarded successfully.
+        uint64_t bytes;
+
+        // Messages received but not forwarded, i.e. the send failed or was canceled.
+        uint64_t drops;
+
+        _DeviceDirectionStats();
+    };
+
+    struct _DeviceStats {
+
+        // From the A socket to the B socket.
+        _DeviceDirectionStats forward;
+
+        // From the B socket to the A socket.
+        _DeviceDirectionStats backward;
+    };
+
+    // Defined alongside the AIO callback.
+    struct _ForwarderDirection;
+    struct _ForwarderWorker;
+
+    /* Forwards messages between two raw mode sockets using a number of AIO driven worker loops
+    in each direction, each of which receives a message and then sends it on. Unlike nng_device,
+    this may use more than one core, counts what it forwards, and may be stopped gracefully.
+    Throws ec_einval up front when either socket is not in raw mode. */
+    class _DeviceForwarder {
+    private:
+
+        friend struct _ForwarderWorker;
+
+        std::unique_ptr<_ForwarderDirection> _forwardp;
+
+        std::unique_ptr<_ForwarderDirection> _backwardp;
+
+        std::vector<std::unique_ptr<_ForwarderWorker>> _workers;
+
+        std::mutex _mutex;
+
+        std::condition_variable _cv;
+
+        size_type _active;
+
+        std::atomic<bool> _stopping;
+
+        bool _stopped;
+
+        void on_worker_finished();
+
+    public:
+
+        _DeviceForwarder(_Socket& a, _Socket& b, size_type workers_per_direction);
+
+        virtual ~_DeviceForwarder();
+
+        /* Stops receiving, then waits up to the timeout for messages already received to be sent
+        on. Anything still in flight after that is canceled, i.e. dropped. Returns whether the
+        forwarder drained in time. Must not be called from an NNG callback. */
+        bool Stop(const duration_type& timeout);
+
+        _DeviceStats GetStats() const;
+    };
+
+    typedef _DeviceDirectionStats device_direction_stats;
+    typedef _DeviceStats device_stats;
+    typedef _DeviceForwarder device_forwarder;
+}
+
+#endif // NNGCPP_DEVICE_FORWARDER_H
@@ -5,8 +5,6 @@
 namespace nng {
 
     using std::placeholders::_1;
-    using std::placeholders::_2;
-    using std::placeholders::_3;
     using std::bind;
 
     // TODO: TBD: ditto "listener" ...
@@ -16,8 +14,10 @@ namespace nng {
 
     _Dialer::_Dialer(const _Socket& s, const std::string& addr) : _EndPoint(), did(0) {
 
+        _metricsp = s._metricsp;
+
         const auto& op = bind(&::nng_dialer_create, &did, s.sid, _1);
-        invocation::with_default_error_handling(op, addr.c_str());
+        throw_if_failed(op(addr.c_str()));
         configure_options(did);
     }
 
@@ -32,27 +32,30 @@ namespace nng {
     void _Dialer::configure_options(nng_type did) {
 
         // Configure the EP related bindings.
-        configure_endpoint(
-            bind(&::nng_dialer_start, did, _1)
-            , bind(&::nng_dialer_close, did)
+        configure_endpoint(did
+            , &::nng_dialer_start
+            , &::nng_dialer_close
         );
 
         // Also pick up the Options bindings.
         auto op = GetOptions();
 
-        op->set_getters(
-            bind(&::nng_dialer_getopt, did, _1, _2, _3)
-            , bind(&::nng_dialer_getopt_int, did, _1, _2)
-            , bind(&::nng_dialer_getopt_size, did, _1, _2)
-            , bind(&::nng_dialer_getopt_ms, did, _1, _2)
+        op->set_getters(did
+            , &::nng_dialer_getopt
+            , &::nng_dialer_getopt_int
+            , &::nng_dialer_getopt_size
+            , &::nng_dialer_getopt_ms
         );
 
-        op->set_setters(
-            bind(&::nng_dialer_setopt, did, _1, _2, _3)
-            , bind(&::nng_dialer_setopt_int, did, _1, _2)
-            , bind(&::nng_dialer_setopt_size, did, _1, _2)
-            , bind(&::nng_dialer_setopt_ms, did, _1, _2)
+        op->set_setters(did
+            , &::nng_dialer_setopt
+            , &::nng_dialer_setopt_int
+            , &::nng_dialer_setopt_size
+            , &::nng_dialer_setopt_ms
         );
+
+        // Whatever was cached belonged to the endpoint as it was.
+        op->InvalidateCache();
     }
 
     bool _Dialer::HasOne() const {
@@ -64,16 +67,26 @@ namespace nng {
     }
 
     void _Dialer::Start(SocketFlag flags) {
-        invocation::with_default_error_handling(__start, flags);
+        throw_if_failed(__start(__id, static_cast<int>(flags)));
+        // Addresses are only settled once started, i.e. the port bound for port zero.
+        GetOptions()->InvalidateCache();
     }
 
     void _Dialer::Close() {
         if (!HasOne()) { return; }
-        invocation::with_default_error_handling(__close);
+        throw_if_failed(__close(__id));
         configure_options(did = 0);
     }
 
     _Dialer::options_type* const _Dialer::GetOptions() {
         return ep_type::GetOptions();
     }
+
+    _OptionProfile _Dialer::Snapshot() {
+        return have_options_type::GetOptions()->Snapshot(profile_dialer_fields);
+    }
+
+    void _Dialer::Apply(const _OptionProfile& profile) {
+        have_options_type::GetOptions()->Apply(profile, profile_dialer_fields);
+    }
 }
@@ -5,17 +5,24 @@ namespace nng {
 
     _EndPoint::_EndPoint()
         : IHaveOne(), ICanClose(), IHaveOptions()
-        , __start(), __close() {
+        , __id(0), __start(nullptr), __close(nullptr), _metricsp() {
     }
 
     _EndPoint::~_EndPoint() {
     }
 
-    void _EndPoint::configure_endpoint(
-        const start_func& start
-        , const close_func& close) {
+    void _EndPoint::configure_endpoint(handle_type id
+        , start_func start
+        , close_func close) {
 
-        const_cast<start_func&>(__start) = start;
-        const_cast<close_func&>(__close) = close;
+        __id = id;
+        __start = start;
+        __close = close;
+    }
+
+    void _EndPoint::throw_if_failed(int errnum) const {
+        if (errnum == 0) { return; }
+        if (_metricsp) { _metricsp->Count(metric_exceptions); }
+        THROW_NNG_EXCEPTION_EC(errnum);
     }
 }
@@ -2,6 +2,7 @@
 #define NNGCPP_ENDPOINT_H
 
 #include "enums.h"
+#include "metrics.h"
 
 #include "IHaveOne.hpp"
 #include "ICanClose.hpp"
@@ -9,6 +10,8 @@
 #include "../options/reader_writer.h"
 #include "../options/IHaveOptions.hpp"
 
+#include <memory>
+
 namespace nng {
 
     // TODO: TBD: carries along with it information about ::nng_pipe ... just a matter of how to present it to the C++ (or SWIG) community...
@@ -21,15 +24,26 @@ namespace nng {
 
         typedef _EndPoint ep_type;
 
-        typedef std::function<int(int)> start_func;
-        typedef std::function<int()> close_func;
+        // Dialers and listeners are both 32-bit handles, so we may call NNG directly.
+        typedef uint32_t handle_type;
+
+        typedef int(*start_func)(handle_type, int);
+        typedef int(*close_func)(handle_type);
+
+        handle_type __id;
+
+        start_func __start;
+        close_func __close;
 
-        const start_func __start;
-        const close_func __close;
+        // Shared with the socket, when it has metrics enabled.
+        std::shared_ptr<_Metrics> _metricsp;
 
-        void configure_endpoint(
-            const start_func& start
-            , const close_func& close);
+        // Throws the same as the default error handling would, counting the exception.
+        void throw_if_failed(int errnum) const;
+
+        void configure_endpoint(handle_type id
+            , start_func start
+            , close_func close);
 
         _EndPoint();
 
@@ -40,6 +54,11 @@ namespace nng {
         virtual void Start() = 0;
 
         virtual void Start(SocketFlag flags) = 0;
+
+        // Snapshots, or applies, only those options which apply to this sort of endpoint.
+        virtual _OptionProfile Snapshot() = 0;
+
+        virtual void Apply(const _OptionProfile& profile) = 0;
     };
 }
 
@@ -20,6 +20,12 @@
              THROW_NNG_EXCEPTION_IF_NOT_ONE_OF(errnum, ecs);
          }
 
+         // For the non-throwing API: expected conditions such as EAGAIN are simply returned.
+         template<typename Op_, typename... Args_>
+         error_code_type with_error_code(const Op_& op, Args_... args) {
+             return static_cast<error_code_type>(op(args...));
+         }
+
          template<typename Op_, typename... Args_>
          void with_void_return_value(const Op_& op, Args_... args) {
              op(args...);
@@ -5,8 +5,6 @@
 namespace nng {
 
     using std::placeholders::_1;
-    using std::placeholders::_2;
-    using std::placeholders::_3;
     using std::bind;
 
     // TODO: TBD: is "listener" its own thing? or simply another kind of "socket"? i.e. perhaps a receive-only socket, as the name would suggest
@@ -16,8 +14,10 @@ namespace nng {
 
     _Listener::_Listener(const _Socket& s, const std::string& addr) : _EndPoint(), lid(0) {
 
+        _metricsp = s._metricsp;
+
         const auto op = bind(&::nng_listener_create, &lid, s.sid, _1);
-        invocation::with_default_error_handling(op, addr.c_str());
+        throw_if_failed(op(addr.c_str()));
         configure_options(lid);
     }
 
@@ -32,27 +32,30 @@ namespace nng {
     void _Listener::configure_options(nng_type lid) {
 
         // Configure the EP related bindings.
-        configure_endpoint(
-            bind(&::nng_listener_start, lid, _1)
-            , bind(&::nng_listener_close, lid)
+        configure_endpoint(lid
+            , &::nng_listener_start
+            , &::nng_listener_close
         );
 
         // Also convey the Options bindings.
         auto op = GetOptions();
 
-        op->set_getters(
-            bind(&::nng_listener_getopt, lid, _1, _2, _3)
-            , bind(&::nng_listener_getopt_int, lid, _1, _2)
-            , bind(&::nng_listener_getopt_size, lid, _1, _2)
-            , bind(&::nng_listener_getopt_ms, lid, _1, _2)
+        op->set_getters(lid
+            , &::nng_listener_getopt
+            , &::nng_listener_getopt_int
+            , &::nng_listener_getopt_size
+            , &::nng_listener_getopt_ms
         );
 
-        op->set_setters(
-            bind(&::nng_listener_setopt, lid, _1, _2, _3)
-            , bind(&::nng_listener_setopt_int, lid, _1, _2)
-            , bind(&::nng_listener_setopt_size, lid, _1, _2)
-            , bind(&::nng_listener_setopt_ms, lid, _1, _2)
+        op->set_setters(lid
+            , &::nng_listener_setopt
+            , &::nng_listener_setopt_int
+            , &::nng_listener_setopt_size
+            , &::nng_listener_setopt_ms
         );
+
+        // Whatever was cached belonged to the endpoint as it was.
+        op->InvalidateCache();
     }
 
     bool _Listener::HasOne() const {
@@ -64,16 +67,26 @@ namespace nng {
     }
 
     void _Listener::Start(SocketFlag flags) {
-        invocation::with_default_error_handling(__start, flags);
+        throw_if_failed(__start(__id, static_cast<int>(flags)));
+        // Addresses are only settled once started, i.e. the port bound for port zero.
+        GetOptions()->InvalidateCache();
     }
 
     void _Listener::Close() {
         if (!HasOne()) { return; }
-        invocation::with_default_error_handling(__close);
+        throw_if_failed(__close(__id));
         configure_options(lid = 0);
     }
 
     _Listener::options_type* const _Listener::GetOptions() {
         return have_options_type::GetOptions();
     }
+
+    _OptionProfile _Listener::Snapshot() {
+        return have_options_type::GetOptions()->Snapshot(profile_listener_fields);
+    }
+
+    void _Listener::Apply(const _OptionProfile& profile) {
+        have_options_type::GetOptions()->Apply(profile, profile_listener_fields);
+    }
 }
@@ -46,6 +46,10 @@ namespace nng {
         virtual bool HasOne() const override;
 
         virtual _OptionReaderWriter* const GetOptions() override;
+
+        virtual _OptionProfile Snapshot() override;
+
+        virtual void Apply(const _OptionProfile& profile) override;
     };
 
     typedef _Listener listener;
@@ -0,0 +1,194 @@
+#include "metrics.h"
+
+#include <atomic>
+
+namespace nng {
+
+    namespace {
+
+        const size_type shard_count = 8;
+
+        const size_type sub_bucket_bits = 3;
+
+        const size_type sub_bucket_count = 1 << sub_bucket_bits;
+
+        // Values below the sub-bucket count are exact; beyond that, eight per power of two.
+        const size_type bucket_count = (64 - sub_bucket_bits + 1) * sub_bucket_count;
+
+        size_type get_msb(uint64_t x) {
+            size_type msb = 0;
+            for (size_type shift = 32; shift > 0; shift >>= 1) {
+                if (x >> shift) { x >>= shift; msb += shift; }
+            }
+            return msb;
+        }
+
+        std::atomic<size_type> __next_shard(0);
+
+        size_type get_shard_index() {
+            // Threads are dealt shards round robin, once, the first time they record anything.
+            thread_local const size_type index = __next_shard++ % shard_count;
+            return index;
+        }
+    }
+
+    struct alignas(64) _MetricsShard {
+
+        std::atomic<uint64_t> counters[metric_counter_count];
+
+        std::atomic<uint64_t> buckets[metric_histogram_count][bucket_count];
+
+        std::atomic<uint64_t> sums[metric_histogram_count];
+
+        std::atomic<uint64_t> maxes[metric_histogram_count];
+
+        _MetricsShard() {
+            clear();
+        }
+
+        void clear() {
+            for (auto& x : counters) { x.store(0, std::memory_order_relaxed); }
+            for (size_type i = 0; i < metric_histogram_count; i++) {
+                for (auto& x : buckets[i]) { x.store(0, std::memory_order_relaxed); }
+                sums[i].store(0, std::memory_order_relaxed);
+                maxes[i].store(0, std::memory_order_relaxed);
+            }
+        }
+    };
+
+    _HistogramSnapshot::_HistogramSnapshot()
+        : buckets(bucket_count, 0), count(0), sum_ns(0), max_ns(0) {
+    }
+
+    double _HistogramSnapshot::GetMean() const {
+        return count ? static_cast<double>(sum_ns) / count : 0;
+    }
+
+    uint64_t _HistogramSnapshot::GetPercentile(double q) const {
+
+        if (count == 0) { return 0; }
+
+        // Nearest rank, never below the first sample.
+        auto rank = static_cast<uint64_t>(q * count + 0.5);
+        if (rank < 1) { rank = 1; }
+
+        uint64_t seen = 0;
+
+        for (size_type i = 0; i < buckets.size(); i++) {
+            if ((seen += buckets[i]) >= rank) {
+                // The bucket bound may overstate the largest sample actually recorded.
+                const auto bound = GetBucketUpperBound(i);
+                return bound < max_ns ? bound : max_ns;
+            }
+        }
+
+        return max_ns;
+    }
+
+    size_type _HistogramSnapshot::GetBucketCount() {
+        return bucket_count;
+    }
+
+    uint64_t _HistogramSnapshot::GetBucketUpperBound(size_type i) {
+
+        if (i < sub_bucket_count) { return i; }
+
+        const auto msb = i / sub_bucket_count + sub_bucket_bits - 1;
+        const auto sub = static_cast<uint64_t>(i % sub_bucket_count);
+        const auto shift = msb - sub_bucket_bits;
+
+        return ((sub_bucket_count + sub) << shift) + ((uint64_t(1) << shift) - 1);
+    }
+
+    _MetricsSnapshot::_MetricsSnapshot() : counters(), histograms() {
+    }
+
+    uint64_t _MetricsSnapshot::GetCounter(metric_counter_type which) const {
+        return counters[which];
+    }
+
+    const _HistogramSnapshot& _MetricsSnapshot::GetHistogram(metric_histogram_type which) const {
+        return histograms[which];
+    }
+
+    _Metrics::_Metrics() : _shardsp(new _MetricsShard[shard_count]) {
+    }
+
+    _Metrics::~_Metrics() {
+    }
+
+    size_type _Metrics::get_bucket_index(uint64_t ns) {
+
+        if (ns < sub_bucket_count) { return static_cast<size_type>(ns); }
+
+        const auto msb = get_msb(ns);
+        const auto sub = static_cast<size_type>(ns >> (msb - sub_bucket_bits)) & (sub_bucket_count - 1);
+
+        return (msb - sub_bucket_bits + 1) * sub_bucket_count + sub;
+    }
+
+    _MetricsShard& _Metrics::get_shard() {
+        return _shardsp[get_shard_index()];
+    }
+
+    void _Metrics::Count(metric_counter_type which, uint64_t n) {
+        get_shard().counters[which].fetch_add(n, std::memory_order_relaxed);
+    }
+
+    void _Metrics::Record(metric_histogram_type which, uint64_t ns) {
+
+        auto& shard = get_shard();
+
+        shard.buckets[which][get_bucket_index(ns)].fetch_add(1, std::memory_order_relaxed);
+        shard.sums[which].fetch_add(ns, std::memory_order_relaxed);
+
+        // Only this thread is likely to be writing the shard, so this rarely loops.
+        auto& max = shard.maxes[which];
+        auto current = max.load(std::memory_order_relaxed);
+        while (ns > current && !max.compare_exchange_weak(current, ns, std::memory_order_relaxed)) {
+        }
+    }
+
+    void _Metrics::Record(metric_histogram_type which, const clock_type::time_point& start) {
+        using namespace std::chrono;
+        Record(which, static_cast<uint64_t>(duration_cast<nanoseconds>(clock_type::now() - start).count()));
+    }
+
+    _MetricsSnapshot _Metrics::GetSnapshot() const {
+
+        _MetricsSnapshot result;
+
+        for (size_type s = 0; s < shard_count; s++) {
+
+            const auto& shard = _shardsp[s];
+
+            for (size_type i = 0; i < metric_counter_count; i++) {
+                result.counters[i] += shard.counters[i].load(std::memory_order_relaxed);
+            }
+
+            for (size_type i = 0; i < metric_histogram_count; i++) {
+
+                auto& h = result.histograms[i];
+
+                for (size_type j = 0; j < bucket_count; j++) {
+                    const auto n = shard.buckets[i][j].load(std::memory_order_relaxed);
+                    h.buckets[j] += n;
+                    h.count += n;
+                }
+
+                h.sum_ns += shard.sums[i].load(std::memory_order_relaxed);
+
+                const auto max = shard.maxes[i].load(std::memory_order_relaxed);
+                if (max > h.max_ns) { h.max_ns = max; }
+            }
+        }
+
+        return result;
+    }
+
+    void _Metrics::Reset() {
+        for (size_type s = 0; s < shard_count; s++) {
+            _shardsp[s].clear();
+        }
+    }
+}
@@ -0,0 +1,114 @@
+#ifndef NNGCPP_METRICS_H
+#define NNGCPP_METRICS_H
+
+#include "types.h"
+
+#include <chrono>
+#include <memory>
+#include <vector>
+
+namespace nng {
+
+    enum metric_counter_type : int {
+        metric_messages_sent,
+        metric_bytes_sent,
+        metric_messages_received,
+        metric_bytes_received,
+        metric_eagain,
+        metric_timeouts,
+        metric_exceptions,
+        metric_aio_completions,
+        metric_counter_count
+    };
+
+    enum metric_histogram_type : int {
+        // Synchronous sends, successful or not.
+        metric_send_latency,
+        // Synchronous receives, including any time spent waiting for a message.
+        metric_receive_latency,
+        // From starting an AIO operation through to its completion.
+        metric_aio_latency,
+        metric_histogram_count
+    };
+
+    /* Counts per log linear bucket, after the fashion of HDR histograms: each power of two is
+    split into eight linear sub-buckets, which bounds the relative error at one eighth. */
+    struct _HistogramSnapshot {
+
+        std::vector<uint64_t> buckets;
+
+        uint64_t count;
+
+        uint64_t sum_ns;
+
+        uint64_t max_ns;
+
+        _HistogramSnapshot();
+
+        double GetMean() const;
+
+        // Returns the upper bound of the bucket containing the quantile, i.e. 0.99 for p99.
+        uint64_t GetPercentile(double q) const;
+
+        static size_type GetBucketCount();
+
+        // Returns the largest value the bucket counts.
+        static uint64_t GetBucketUpperBound(size_type i);
+    };
+
+    struct _MetricsSnapshot {
+
+        uint64_t counters[metric_counter_count];
+
+        _HistogramSnapshot histograms[metric_histogram_count];
+
+        _MetricsSnapshot();
+
+        uint64_t GetCounter(metric_counter_type which) const;
+
+        const _HistogramSnapshot& GetHistogram(metric_histogram_type which) const;
+    };
+
+    // Defined alongside the metrics.
+    struct _MetricsShard;
+
+    /* Counters and histograms are spread over a handful of cache line aligned shards, and each
+    thread records into its own shard using relaxed atomics, so recording never takes a lock nor
+    contends with other threads for the most part. Reads aggregate over the shards. */
+    class _Metrics {
+    public:
+
+        typedef std::chrono::steady_clock clock_type;
+
+    private:
+
+        std::unique_ptr<_MetricsShard[]> _shardsp;
+
+        _MetricsShard& get_shard();
+
+    public:
+
+        _Metrics();
+
+        virtual ~_Metrics();
+
+        void Count(metric_counter_type which, uint64_t n = 1);
+
+        void Record(metric_histogram_type which, uint64_t ns);
+
+        void Record(metric_histogram_type which, const clock_type::time_point& start);
+
+        _MetricsSnapshot GetSnapshot() const;
+
+        // Recording may race with the reset, in which case it lands on either side of it.
+        void Reset();
+
+        static size_type get_bucket_index(uint64_t ns);
+    };
+
+    typedef _HistogramSnapshot histogram_snapshot;
+    typedef _MetricsSnapshot metrics_snapshot;
+    typedef _Metrics metrics;
+}
+
+#endif // NNGCPP_METRICS_H
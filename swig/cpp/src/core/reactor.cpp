@@ -0,0 +1,270 @@
+#include "reactor.h"
+#include "socket.h"
+#include "exceptions.hpp"
+#include "../messaging/binary_message.h"
+#include "../options/options.h"
+
+
+#ifdef __linux__
+#   include <cerrno>
+#   include <sys/epoll.h>
+#   include <sys/eventfd.h>
+#   include <unistd.h>
+#endif // __linux__
+
+namespace nng {
+
+    struct _ReactorRegistration {
+
+        _Socket* const sp;
+
+        const _Reactor::handler_type handler;
+
+        const int events;
+
+        int recv_fd;
+
+        int send_fd;
+
+        _ReactorRegistration(_Socket* const sp, const _Reactor::handler_type& handler, int events)
+            : sp(sp), handler(handler), events(events), recv_fd(-1), send_fd(-1) {
+        }
+    };
+
+    namespace {
+
+        // Zero is the wake descriptor; registrations put their ID above the writable bit.
+        const uint64_t wake_data = 0;
+
+        const uint64_t writable_bit = 1;
+
+        const int max_events = 256;
+    }
+
+#ifdef __linux__
+
+    void __throw_system_error(const char* const what) {
+        throw exceptions::system_error(ec_esyserr | errno, what);
+    }
+
+    _Reactor::_Reactor()
+        : _epfd(-1), _wakefd(-1), _stopping(false), _mutex(), _next_id(1), _registrations(), _ids() {
+
+        if ((_epfd = ::epoll_create1(EPOLL_CLOEXEC)) < 0) {
+            __throw_system_error("epoll_create1 failed");
+        }
+
+        if ((_wakefd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)) < 0) {
+            const auto ec = errno;
+            ::close(_epfd);
+            errno = ec;
+            __throw_system_error("eventfd failed");
+        }
+
+        try {
+            watch(_wakefd, wake_data);
+        }
+        catch (...) {
+            ::close(_wakefd);
+            ::close(_epfd);
+            throw;
+        }
+    }
+
+    _Reactor::~_Reactor() {
+        ::close(_wakefd);
+        ::close(_epfd);
+    }
+
+    void _Reactor::watch(int fd, uint64_t data) {
+        ::epoll_event ev = {};
+        // Edge triggered, so each transition to ready is reported once.
+        ev.events = EPOLLIN | EPOLLET;
+        ev.data.u64 = data;
+        if (::epoll_ctl(_epfd, EPOLL_CTL_ADD, fd, &ev) != 0) {
+            __throw_system_error("epoll_ctl failed");
+        }
+    }
+
+    void _Reactor::unwatch(int fd) {
+        // Closing the socket closes its descriptors, which also takes them out of the set.
+        if (fd >= 0) { ::epoll_ctl(_epfd, EPOLL_CTL_DEL, fd, nullptr); }
+    }
+
+#else // __linux__
+
+    _Reactor::_Reactor()
+        : _epfd(-1), _wakefd(-1), _stopping(false), _mutex(), _next_id(1), _registrations(), _ids() {
+
+        THROW_NOT_IMPLEMENTED(_Reactor);
+    }
+
+    _Reactor::~_Reactor() {
+    }
+
+    void _Reactor::watch(int fd, uint64_t data) {
+        THROW_NOT_IMPLEMENTED_FUNC(_Reactor, watch);
+    }
+
+    void _Reactor::unwatch(int fd) {
+    }
+
+#endif // __linux__
+
+    void _Reactor::Add(_Socket& s, const handler_type& handler, int events) {
+
+        using O = option_names;
+
+        const auto rp = std::make_shared<_ReactorRegistration>(&s, handler, events);
+
+        // Sockets without a receive side, or a send side, throw here, which is as it should be.
+        if (events & reactor_readable) { rp->recv_fd = s.GetOptions()->GetInt32(O::recv_fd); }
+        if (events & reactor_writable) { rp->send_fd = s.GetOptions()->GetInt32(O::send_fd); }
+
+        std::lock_guard<std::mutex> guard(_mutex);
+
+        if (_ids.find(&s) != _ids.end()) { THROW_NNG_EXCEPTION_EC(ec_ebusy); }
+
+        const auto id = _next_id++;
+
+        if (rp->recv_fd >= 0) {
+            watch(rp->recv_fd, id << 1);
+        }
+
+        if (rp->send_fd >= 0) {
+            try {
+                watch(rp->send_fd, (id << 1) | writable_bit);
+            }
+            catch (...) {
+                unwatch(rp->recv_fd);
+                throw;
+            }
+        }
+
+        _registrations.emplace(id, rp);
+        _ids.emplace(&s, id);
+    }
+
+    void _Reactor::AddReceiver(_Socket& s, const message_handler_type& on_message) {
+        Add(s, [on_message](_Socket& s, int) { Drain(s, on_message); }, reactor_readable);
+    }
+
+    bool _Reactor::Remove(_Socket& s) {
+
+        std::lock_guard<std::mutex> guard(_mutex);
+
+        const auto it = _ids.find(&s);
+
+        if (it == _ids.end()) { return false; }
+
+        const auto rit = _registrations.find(it->second);
+        const auto& rp = rit->second;
+
+        unwatch(rp->recv_fd);
+        unwatch(rp->send_fd);
+
+        // Events already collected for it find nothing, and are dropped.
+        _registrations.erase(rit);
+        _ids.erase(it);
+
+        return true;
+    }
+
+    bool _Reactor::Contains(const _Socket& s) const {
+        std::lock_guard<std::mutex> guard(_mutex);
+        return _ids.find(&s) != _ids.end();
+    }
+
+    size_type _Reactor::GetCount() const {
+        std::lock_guard<std::mutex> guard(_mutex);
+        return _ids.size();
+    }
+
+    size_type _Reactor::RunOnce(const duration_type& timeout) {
+
+#ifdef __linux__
+
+        ::epoll_event events[max_events];
+
+        const auto timeout_ms = timeout.count() < 0 ? -1 : static_cast<int>(timeout.count());
+
+        const auto count = ::epoll_wait(_epfd, events, max_events, timeout_ms);
+
+        if (count < 0) {
+            if (errno == EINTR) { return 0; }
+            __throw_system_error("epoll_wait failed");
+        }
+
+        size_type dispatched = 0;
+
+        for (auto i = 0; i < count; i++) {
+
+            const auto data = events[i].data.u64;
+
+            if (data == wake_data) {
+                uint64_t value;
+                while (::read(_wakefd, &value, sizeof(value)) > 0) {}
+                continue;
+            }
+
+            registration_ptr_type rp;
+
+            {
+                std::lock_guard<std::mutex> guard(_mutex);
+                const auto it = _registrations.find(data >> 1);
+                if (it == _registrations.end()) { continue; }
+                rp = it->second;
+            }
+
+            // Handlers run without the lock, so that they may add and remove sockets.
+            rp->handler(*rp->sp, data & writable_bit ? reactor_writable : reactor_readable);
+
+            ++dispatched;
+        }
+
+        return dispatched;
+
+#else // __linux__
+
+        THROW_NOT_IMPLEMENTED_FUNC(_Reactor, RunOnce);
+
+#endif // __linux__
+    }
+
+    void _Reactor::Run() {
+
+        while (!_stopping) {
+            RunOnce();
+        }
+
+        // Ready to run again.
+        _stopping = false;
+    }
+
+    void _Reactor::Stop() {
+
+        _stopping = true;
+
+#ifdef __linux__
+        const uint64_t one = 1;
+        // Only ever fails when the counter is already pending, which wakes the reactor just the same.
+        const auto written = ::write(_wakefd, &one, sizeof(one));
+        (void)written;
+#endif // __linux__
+    }
+
+    size_type _Reactor::Drain(_Socket& s, const message_handler_type& on_message) {
+
+        size_type count = 0;
+
+        binary_message bm;
+
+        // Anything other than a message, usually ec_eagain, means there is nothing more for now.
+        while (s.TryReceive(bm, flag_nonblock) == ec_enone) {
+            ++count;
+            on_message(bm);
+        }
+
+        return count;
+    }
+}
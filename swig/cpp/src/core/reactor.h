@@ -0,0 +1,110 @@
+#ifndef NNGCPP_REACTOR_H
+#define NNGCPP_REACTOR_H
+
+#include "types.h"
+#include "enums.h"
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace nng {
+
+#ifndef NNGCPP_SOCKET_H
+    class _Socket;
+#endif // NNGCPP_SOCKET_H
+
+    class _Message;
+
+    enum reactor_event_type {
+        reactor_none = 0,
+        reactor_readable = 1,
+        reactor_writable = 2
+    };
+
+    // Defined alongside the reactor.
+    struct _ReactorRegistration;
+
+    /* Multiplexes many sockets onto one thread by way of their notification descriptors, i.e.
+    the recv_fd and send_fd options, all in one epoll set. Readiness is edge triggered, so a
+    handler must drain the socket, i.e. TryReceive with flag_nonblock until ec_eagain, or it will
+    not hear about that socket again. Drain does exactly that.
+
+    Sockets must outlive their registration. Sockets may be added and removed from any thread,
+    including from handlers, while the reactor runs. Only Linux is supported for the time being;
+    elsewhere the reactor throws not_implemented on construction. */
+    class _Reactor {
+    public:
+
+        // Receives the socket and which of reactor_readable and reactor_writable it became.
+        typedef std::function<void(_Socket&, int)> handler_type;
+
+        typedef std::function<void(_Message&)> message_handler_type;
+
+    private:
+
+        typedef std::shared_ptr<_ReactorRegistration> registration_ptr_type;
+
+        int _epfd;
+
+        // Wakes Run when Stop is called from another thread.
+        int _wakefd;
+
+        std::atomic<bool> _stopping;
+
+        mutable std::mutex _mutex;
+
+        uint64_t _next_id;
+
+        std::unordered_map<uint64_t, registration_ptr_type> _registrations;
+
+        std::unordered_map<const _Socket*, uint64_t> _ids;
+
+        void watch(int fd, uint64_t data);
+
+        // Quietly ignores descriptors that were never watched, or are already closed.
+        void unwatch(int fd);
+
+    public:
+
+        _Reactor();
+
+        _Reactor(const _Reactor&) = delete;
+
+        _Reactor& operator=(const _Reactor&) = delete;
+
+        virtual ~_Reactor();
+
+        // Events is a combination of reactor_readable and reactor_writable. Adding a socket twice is ec_ebusy.
+        void Add(_Socket& s, const handler_type& handler, int events = reactor_readable);
+
+        // Adds the socket, draining each message into the handler whenever it becomes readable.
+        void AddReceiver(_Socket& s, const message_handler_type& on_message);
+
+        // Returns whether the socket was registered.
+        bool Remove(_Socket& s);
+
+        bool Contains(const _Socket& s) const;
+
+        size_type GetCount() const;
+
+        /* Waits for readiness, up to the timeout, negative meaning forever, and dispatches it.
+        Returns how many handlers were invoked. */
+        size_type RunOnce(const duration_type& timeout = duration_type(-1));
+
+        // Dispatches until stopped.
+        void Run();
+
+        // May be called from any thread, including from a handler.
+        void Stop();
+
+        // Receives without blocking until ec_eagain, handing each message over. Returns the message count.
+        static size_type Drain(_Socket& s, const message_handler_type& on_message);
+    };
+
+    typedef _Reactor reactor;
+}
+
+#endif // NNGCPP_REACTOR_H
@@ -1,6 +1,5 @@
 #include "session.h"
-
-#include <algorithm>
+#include "async/aio_reaper.h"
 
 namespace nng {
 
@@ -13,42 +12,40 @@ namespace nng {
         , _pull_sockets()
         , _req_sockets()
         , _rep_sockets()
+        , _message_pool(std::make_shared<message_pool>())
+        , _messages()
         , _devices() {
     }
 
-    template<class Type_>
-    void __release_all(std::vector<std::shared_ptr<Type_>>& values) {
-        for (auto & x : values) {
-            x.reset();
-        }
-        values.clear();
-    }
-
     session::~session() {
-        __release_all(_dialer_eps);
-        __release_all(_listener_eps);
-        __release_all(_bus_sockets);
-        __release_all(_pair_sockets);
-        __release_all(_push_sockets);
-        __release_all(_pull_sockets);
-        __release_all(_req_sockets);
-        __release_all(_rep_sockets);
-        __release_all(_devices);
+        // Devices forward between sockets, and endpoints belong to them, so those go first.
+        _devices.Clear();
+        _dialer_eps.Clear();
+        _listener_eps.Clear();
+        _bus_sockets.Clear();
+        _pair_sockets.Clear();
+        _push_sockets.Clear();
+        _pull_sockets.Clear();
+        _req_sockets.Clear();
+        _rep_sockets.Clear();
+        _messages.Clear();
+        // Return any cached messages, from every thread, to NNG prior to finalizing.
+        _message_pool->Drain();
+        // As well as any AIOs still waiting to be reaped.
+        _AioReaper::Drain();
         ::nng_fini();
     }
 
     template<class Type_, typename ...Args_>
-    std::shared_ptr<Type_> __create(std::vector<std::shared_ptr<Type_>>& values, Args_ &&...args) {
+    std::shared_ptr<Type_> __create(_SlotMap<Type_>& values, Args_ &&...args) {
         auto sp = std::make_shared<Type_>(args...);
-        values.push_back(sp);
+        values.Insert(sp);
         return sp;
     }
 
     template<class Type_>
-    void __remove(std::vector<std::shared_ptr<Type_>>& values, const Type_* const valuep) {
-        std::remove_if(values.begin(), values.end(), [&](const std::shared_ptr<Type_>& sp) {
-            return sp.get() == valuep;
-        });
+    void __remove(_SlotMap<Type_>& values, const Type_* const valuep) {
+        values.Remove(valuep);
     }
 
     std::shared_ptr<dialer> session::create_dialer_ep() {
@@ -97,10 +94,18 @@ namespace nng {
         return __create(_push_sockets);
     }
 
+    void session::remove_push_socket(const protocol::latest_push_socket* const sp) {
+        __remove(_push_sockets, sp);
+    }
+
     std::shared_ptr<protocol::latest_pull_socket> session::create_pull_socket() {
         return __create(_pull_sockets);
     }
 
+    void session::remove_pull_socket(const protocol::latest_pull_socket* const sp) {
+        __remove(_pull_sockets, sp);
+    }
+
     std::shared_ptr<protocol::latest_req_socket> session::create_req_socket() {
         return __create(_req_sockets);
     }
@@ -121,16 +126,46 @@ namespace nng {
         return __create(_devices, asockp, bsockp, shouldCloseSockets);
     }
 
+    std::shared_ptr<device> session::create_device(_Socket* const asockp, _Socket* const bsockp, bool shouldCloseSockets, size_type workers_per_direction) {
+        return __create(_devices, asockp, bsockp, shouldCloseSockets, workers_per_direction);
+    }
+
     void session::remove_device(const device* const dp) {
         __remove(_devices, dp);
     }
 
     // TODO: TBD: string based? or vector based?
     std::shared_ptr<binary_message> session::create_message() {
-        return __create(_messages);
+        return create_message(0);
+    }
+
+    std::shared_ptr<binary_message> session::create_message(size_type sz) {
+        std::shared_ptr<binary_message> sp = _message_pool->Acquire(sz);
+        _messages.Insert(sp);
+        return sp;
     }
 
     void session::remove_message(const binary_message* const mp) {
         __remove(_messages, mp);
     }
+
+    slot_handle_type session::get_message_handle(const binary_message* const mp) const {
+        return _messages.Find(mp);
+    }
+
+    std::shared_ptr<binary_message> session::get_message(slot_handle_type handle) const {
+        return _messages.Get(handle);
+    }
+
+    void session::remove_message(slot_handle_type handle) {
+        _messages.Remove(handle);
+    }
+
+    size_type session::get_message_count() const {
+        return _messages.GetCount();
+    }
+
+    std::shared_ptr<message_pool> session::get_message_pool() const {
+        return _message_pool;
+    }
 }
@@ -8,6 +8,7 @@
 #include "listener.h"
 #include "dialer.h"
 #include "device.h"
+#include "slot_map.hpp"
 
 #include <memory>
 #include <vector>
@@ -19,22 +20,25 @@ namespace nng {
     class session {
         private:
 
-            std::vector<std::shared_ptr<dialer>> _dialer_eps;
-            std::vector<std::shared_ptr<listener>> _listener_eps;
+            // Each kind keeps its own registry, which the destructor tears down in dependency order.
+            _SlotMap<dialer> _dialer_eps;
+            _SlotMap<listener> _listener_eps;
 
-            std::vector<std::shared_ptr<protocol::_LatestBusSocket>> _bus_sockets;
+            _SlotMap<protocol::_LatestBusSocket> _bus_sockets;
 
-            std::vector<std::shared_ptr<protocol::latest_pair_socket>> _pair_sockets;
+            _SlotMap<protocol::latest_pair_socket> _pair_sockets;
 
-            std::vector<std::shared_ptr<protocol::latest_push_socket>> _push_sockets;
-            std::vector<std::shared_ptr<protocol::latest_pull_socket>> _pull_sockets;
+            _SlotMap<protocol::latest_push_socket> _push_sockets;
+            _SlotMap<protocol::latest_pull_socket> _pull_sockets;
 
-            std::vector<std::shared_ptr<protocol::latest_req_socket>> _req_sockets;
-            std::vector<std::shared_ptr<protocol::latest_rep_socket>> _rep_sockets;
+            _SlotMap<protocol::latest_req_socket> _req_sockets;
+            _SlotMap<protocol::latest_rep_socket> _rep_sockets;
 
-            std::vector<std::shared_ptr<binary_message>> _messages;
+            std::shared_ptr<message_pool> _message_pool;
 
-            std::vector<std::shared_ptr<device>> _devices;
+            _SlotMap<binary_message> _messages;
+
+            _SlotMap<device> _devices;
 
         public:
 
@@ -59,7 +63,10 @@ namespace nng {
             void remove_pair_socket(const protocol::latest_pair_socket* const sp);
 
             std::shared_ptr<protocol::latest_push_socket> create_push_socket();
+            void remove_push_socket(const protocol::latest_push_socket* const sp);
+
             std::shared_ptr<protocol::latest_pull_socket> create_pull_socket();
+            void remove_pull_socket(const protocol::latest_pull_socket* const sp);
 
             std::shared_ptr<protocol::latest_req_socket> create_req_socket();
             void remove_req_socket(const protocol::latest_req_socket* const rp);
@@ -68,10 +75,23 @@ namespace nng {
             void remove_rep_socket(const protocol::latest_rep_socket* const rp);
 
             std::shared_ptr<device> create_device(_Socket* const asockp, _Socket* const bsockp, bool shouldCloseSockets);
+            std::shared_ptr<device> create_device(_Socket* const asockp, _Socket* const bsockp, bool shouldCloseSockets, size_type workers_per_direction);
             void remove_device(const device* const dp);
 
             std::shared_ptr<binary_message> create_message();
+            std::shared_ptr<binary_message> create_message(size_type sz);
             void remove_message(const binary_message* const mp);
+
+            /* Messages are by far the busiest kind, so they may also be tracked by handle, which
+            stays stale once the message is removed, even when its slot has been reused. */
+            slot_handle_type get_message_handle(const binary_message* const mp) const;
+            std::shared_ptr<binary_message> get_message(slot_handle_type handle) const;
+            void remove_message(slot_handle_type handle);
+
+            size_type get_message_count() const;
+
+            // Messages created by the session are drawn from, and recycled into, this pool.
+            std::shared_ptr<message_pool> get_message_pool() const;
     };
 }
 
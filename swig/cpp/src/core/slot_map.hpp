@@ -0,0 +1,194 @@
+#ifndef NNGCPP_SLOT_MAP_HPP
+#define NNGCPP_SLOT_MAP_HPP
+
+#include "types.h"
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace nng {
+
+    // Slot index in the low half, generation in the high half; zero is never a valid handle.
+    typedef uint64_t slot_handle_type;
+
+    /* Owns shared objects in reusable slots, handing out generational handles for them. Insert,
+    Remove and Get are all constant time, and removed slots are recycled, so churning through
+    objects does not grow the map. A handle whose object has been removed stays stale even after
+    its slot is reused, since the slot's generation moves on. Objects may also be found, and
+    removed, by address. Not synchronized, the same as the session that owns it. */
+    template<class Type_>
+    class _SlotMap {
+    public:
+
+        typedef Type_ value_type;
+        typedef std::shared_ptr<Type_> pointer_type;
+
+    private:
+
+        static const uint32_t no_slot = static_cast<uint32_t>(-1);
+
+        struct slot_type {
+
+            pointer_type value;
+
+            uint32_t generation;
+
+            // Next in the free list, while the slot is not in use.
+            uint32_t next_free;
+
+            slot_type() : value(), generation(1), next_free(no_slot) {}
+        };
+
+        std::vector<slot_type> _slots;
+
+        uint32_t _free_head;
+
+        std::unordered_map<const Type_*, uint32_t> _indexes;
+
+        static slot_handle_type to_handle(uint32_t index, uint32_t generation) {
+            return (static_cast<slot_handle_type>(generation) << 32) | index;
+        }
+
+        static uint32_t get_index(slot_handle_type handle) {
+            return static_cast<uint32_t>(handle);
+        }
+
+        static uint32_t get_generation(slot_handle_type handle) {
+            return static_cast<uint32_t>(handle >> 32);
+        }
+
+        const slot_type* find_slot(slot_handle_type handle) const {
+            const auto index = get_index(handle);
+            if (index >= _slots.size()) { return nullptr; }
+            const auto& slot = _slots[index];
+            return slot.value && slot.generation == get_generation(handle) ? &slot : nullptr;
+        }
+
+        void remove_at(uint32_t index) {
+
+            auto& slot = _slots[index];
+
+            _indexes.erase(slot.value.get());
+
+            // Zero would make for a zero handle, which is never valid.
+            if (++slot.generation == 0) { slot.generation = 1; }
+
+            slot.next_free = _free_head;
+            _free_head = index;
+
+            // Last of all, in case releasing the object reenters the map.
+            pointer_type released;
+            released.swap(slot.value);
+        }
+
+    public:
+
+        _SlotMap() : _slots(), _free_head(no_slot), _indexes() {
+        }
+
+        _SlotMap(const _SlotMap&) = delete;
+
+        _SlotMap& operator=(const _SlotMap&) = delete;
+
+        virtual ~_SlotMap() {
+            Clear();
+        }
+
+        // Null objects are not inserted, and yield a zero handle. Inserting an object that is
+        // already in the map yields its existing handle rather than taking a second slot.
+        slot_handle_type Insert(const pointer_type& value) {
+
+            if (!value) { return 0; }
+
+            const auto it = _indexes.find(value.get());
+
+            if (it != _indexes.end()) {
+                return to_handle(it->second, _slots[it->second].generation);
+            }
+
+            uint32_t index;
+
+            if (_free_head != no_slot) {
+                index = _free_head;
+                _free_head = _slots[index].next_free;
+            }
+            else {
+                index = static_cast<uint32_t>(_slots.size());
+                _slots.emplace_back();
+            }
+
+            auto& slot = _slots[index];
+
+            slot.value = value;
+            slot.next_free = no_slot;
+
+            _indexes[value.get()] = index;
+
+            return to_handle(index, slot.generation);
+        }
+
+        // Returns null for stale or bogus handles.
+        pointer_type Get(slot_handle_type handle) const {
+            const auto slotp = find_slot(handle);
+            return slotp ? slotp->value : nullptr;
+        }
+
+        // Returns the zero handle when the object is not in the map.
+        slot_handle_type Find(const Type_* const valuep) const {
+            const auto it = _indexes.find(valuep);
+            return it == _indexes.end() ? 0 : to_handle(it->second, _slots[it->second].generation);
+        }
+
+        bool Contains(slot_handle_type handle) const {
+            return find_slot(handle) != nullptr;
+        }
+
+        bool Remove(slot_handle_type handle) {
+            if (!find_slot(handle)) { return false; }
+            remove_at(get_index(handle));
+            return true;
+        }
+
+        bool Remove(const Type_* const valuep) {
+            const auto it = _indexes.find(valuep);
+            if (it == _indexes.end()) { return false; }
+            remove_at(it->second);
+            return true;
+        }
+
+        size_type GetCount() const {
+            return _indexes.size();
+        }
+
+        bool IsEmpty() const {
+            return _indexes.empty();
+        }
+
+        // Releases every object, latest slots first. Every outstanding handle goes stale.
+        void Clear() {
+
+            std::vector<pointer_type> released;
+            released.reserve(_indexes.size());
+
+            _indexes.clear();
+            _free_head = no_slot;
+
+            for (auto index = static_cast<uint32_t>(_slots.size()); index-- > 0;) {
+                auto& slot = _slots[index];
+                if (slot.value) {
+                    released.push_back(std::move(slot.value));
+                    if (++slot.generation == 0) { slot.generation = 1; }
+                }
+                // Leaves the lowest slots at the head of the free list.
+                slot.next_free = _free_head;
+                _free_head = index;
+            }
+
+            // Ditto reentrancy, releasing in the order collected.
+            for (auto& x : released) { x.reset(); }
+        }
+    };
+}
+
+#endif // NNGCPP_SLOT_MAP_HPP
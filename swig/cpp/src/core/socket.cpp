@@ -7,11 +7,6 @@
 
 namespace nng {
 
-    using std::placeholders::_1;
-    using std::placeholders::_2;
-    using std::placeholders::_3;
-    using std::bind;
-
     _Socket::_Socket(const nng_ctor_func& nng_ctor) : IHaveOne(), IProtocol(), ICanClose()
         , ICanListen(), ICanDial(), ISender(), IReceiver(), IHaveOptions()
         , sid(0) {
@@ -33,26 +28,25 @@ namespace nng {
         // As well as the Options API.
         auto op = GetOptions();
 
-        op->set_getters(
-            bind(&::nng_getopt, sid, _1, _2, _3)
-            , bind(&::nng_getopt_int, sid, _1, _2)
-            , bind(&::nng_getopt_size, sid, _1, _2)
-            , bind(&::nng_getopt_ms, sid, _1, _2)
+        op->set_getters(sid
+            , &::nng_getopt
+            , &::nng_getopt_int
+            , &::nng_getopt_size
+            , &::nng_getopt_ms
         );
 
-        op->set_setters(
-            bind(&::nng_setopt, sid, _1, _2, _3)
-            , bind(&::nng_setopt_int, sid, _1, _2)
-            , bind(&::nng_setopt_size, sid, _1, _2)
-            , bind(&::nng_setopt_ms, sid, _1, _2)
+        op->set_setters(sid
+            , &::nng_setopt
+            , &::nng_setopt_int
+            , &::nng_setopt_size
+            , &::nng_setopt_ms
         );
     }
 
     void _Socket::Close() {
         if (!HasOne()) { return; }
         // Close is its own operation apart from Shutdown.
-        const auto op = bind(&::nng_close, sid);
-        invocation::with_default_error_handling(op);
+        invocation::with_default_error_handling(&::nng_close, sid);
         // Closed is closed.
         configure_options(sid = 0);
     }
@@ -61,66 +55,183 @@ namespace nng {
         return sid > 0;
     }
 
+    // Throws the same as the default error handling would, counting the exception.
+    void __throw_if_failed(_Metrics* const mp, error_code_type ec) {
+        if (ec == ec_enone) { return; }
+        if (mp) { mp->Count(metric_exceptions); }
+        THROW_NNG_EXCEPTION_EC(ec);
+    }
+
     // TODO: TBD: ditto ec handling...
     void _Socket::Listen(const std::string& addr, flag_type flags) {
-        const auto& op = bind(&::nng_listen, sid, _1, _2, _3);
-        invocation::with_default_error_handling(op, addr.c_str(), nullptr, static_cast<int>(flags));
+        __throw_if_failed(_metricsp.get(), invocation::with_error_code(&::nng_listen, sid, addr.c_str()
+            , (::nng_listener*)nullptr, static_cast<int>(flags)));
     }
 
     void _Socket::Listen(const std::string& addr, _Listener* const lp, flag_type flags) {
-        const auto& op = bind(&::nng_listen, sid, _1, _2, _3);
-        invocation::with_default_error_handling(op, addr.c_str()
-            , lp ? &(lp->lid) : nullptr, static_cast<int>(flags));
-        if (lp) { lp->on_listened(); }
+        __throw_if_failed(_metricsp.get(), invocation::with_error_code(&::nng_listen, sid, addr.c_str()
+            , lp ? &(lp->lid) : nullptr, static_cast<int>(flags)));
+        if (lp) {
+            lp->_metricsp = _metricsp;
+            lp->on_listened();
+        }
     }
 
     void _Socket::Dial(const std::string& addr, flag_type flags) {
-        const auto& op = bind(&::nng_dial, sid, _1, _2, _3);
-        invocation::with_default_error_handling(op, addr.c_str(), nullptr, flags);
+        __throw_if_failed(_metricsp.get(), invocation::with_error_code(&::nng_dial, sid, addr.c_str()
+            , (::nng_dialer*)nullptr, static_cast<int>(flags)));
     }
 
     void _Socket::Dial(const std::string& addr, _Dialer* const dp, flag_type flags) {
-        const auto& op = bind(&::nng_dial, sid, _1, _2, _3);
-        invocation::with_default_error_handling(op, addr.c_str()
-            , dp ? &(dp->did) : nullptr, static_cast<int>(flags));
-        if (dp) { dp->on_dialed(); }
+        __throw_if_failed(_metricsp.get(), invocation::with_error_code(&::nng_dial, sid, addr.c_str()
+            , dp ? &(dp->did) : nullptr, static_cast<int>(flags)));
+        if (dp) {
+            dp->_metricsp = _metricsp;
+            dp->on_dialed();
+        }
     }
 
+    /* Records the outcome of a synchronous operation when metrics are enabled. Otherwise this
+    costs a null check or two, which is what allows metrics to be opt-in on the hot paths. */
+    class __metrics_probe {
+    private:
+
+        typedef _Metrics::clock_type clock_type;
+
+        _Metrics* const _mp;
+
+        const metric_histogram_type _which;
+
+        const clock_type::time_point _start;
+
+    public:
+
+        __metrics_probe(_Metrics* const mp, metric_histogram_type which)
+            : _mp(mp), _which(which)
+            , _start(mp ? clock_type::now() : clock_type::time_point()) {
+        }
+
+        // Returns zero when there is nothing to record, which saves asking NNG.
+        size_type get_size(msg_type* const msgp) const {
+            return _mp && msgp ? ::nng_msg_header_len(msgp) + ::nng_msg_len(msgp) : 0;
+        }
+
+        error_code_type operator()(error_code_type ec, size_type sz) const {
+
+            if (!_mp) { return ec; }
+
+            _mp->Record(_which, _start);
+
+            switch (ec) {
+            case ec_enone:
+                if (_which == metric_send_latency) {
+                    _mp->Count(metric_messages_sent);
+                    _mp->Count(metric_bytes_sent, sz);
+                }
+                else {
+                    _mp->Count(metric_messages_received);
+                    _mp->Count(metric_bytes_received, sz);
+                }
+                break;
+            case ec_eagain:
+                _mp->Count(metric_eagain);
+                break;
+            case ec_etimedout:
+                _mp->Count(metric_timeouts);
+                break;
+            default:
+                break;
+            }
+
+            return ec;
+        }
+
+        void throw_if_failed(error_code_type ec) const {
+            __throw_if_failed(_mp, ec);
+        }
+    };
+
     template<class Buffer_>
-    void send(int sid, const Buffer_& buf, std::size_t sz, flag_type flags) {
+    void send(nng_socket sid, const Buffer_& buf, std::size_t sz, flag_type flags, _Metrics* const mp) {
+        const __metrics_probe probe(mp, metric_send_latency);
         // &buf[0] ????
-        const auto& op = bind(&::nng_send, sid, _1, _2, _3);
-        invocation::with_default_error_handling(op, (void*)buf.data(), sz
-            , static_cast<int>(flags));
+        probe.throw_if_failed(probe(invocation::with_error_code(&::nng_send, sid, (void*)buf.data(), sz
+            , static_cast<int>(flags)), sz));
     }
     
     void _Socket::Send(const buffer_vector_type& buf, flag_type flags) {
-        nng::send(sid, buf, buf.size(), flags);
+        nng::send(sid, buf, buf.size(), flags, _metricsp.get());
     }
 
     void _Socket::Send(const buffer_vector_type& buf, size_type sz, flag_type flags) {
-        nng::send(sid, buf, std::min(buf.size(), sz), flags);
+        nng::send(sid, buf, std::min(buf.size(), sz), flags, _metricsp.get());
     }
 
     void _Socket::Send(binary_message& m, flag_type flags) {
         auto* msgp = m.cede_message();
         if (msgp == nullptr) { return; }
-        const auto op = bind(&::nng_sendmsg, sid, msgp, _1);
-        invocation::with_default_error_handling(op, static_cast<int>(flags));
+        const __metrics_probe probe(_metricsp.get(), metric_send_latency);
+        const auto sz = probe.get_size(msgp);
+        probe.throw_if_failed(probe(invocation::with_error_code(&::nng_sendmsg, sid, msgp
+            , static_cast<int>(flags)), sz));
+    }
+
+    error_code_type _Socket::TrySend(binary_message& m, flag_type flags) {
+        auto* msgp = m.cede_message();
+        if (msgp == nullptr) { return ec_enone; }
+        const __metrics_probe probe(_metricsp.get(), metric_send_latency);
+        const auto sz = probe.get_size(msgp);
+        const auto ec = probe(invocation::with_error_code(&::nng_sendmsg, sid, msgp, static_cast<int>(flags)), sz);
+        // NNG only assumes ownership on success, so the message goes back to the caller.
+        if (ec != ec_enone) { m.retain(msgp); }
+        return ec;
+    }
+
+    error_code_type _Socket::TrySend(const buffer_vector_type& buf, flag_type flags) {
+        const __metrics_probe probe(_metricsp.get(), metric_send_latency);
+        return probe(invocation::with_error_code(&::nng_send, sid, (void*)buf.data(), buf.size()
+            , static_cast<int>(flags)), buf.size());
+    }
+
+    void _Socket::SendGather(const const_buffer_segment* const segs, size_type count, flag_type flags) {
+        binary_message bm;
+        __throw_if_failed(_metricsp.get(), gather(bm, segs, count));
+        _Socket::Send(bm, flags);
+    }
+
+    error_code_type _Socket::TrySendGather(const const_buffer_segment* const segs, size_type count, flag_type flags) {
+        binary_message bm;
+        const auto ec = gather(bm, segs, count);
+        // Nothing was sent, so NNG keeps nothing, and the gathered message goes with bm.
+        return ec == ec_enone ? _Socket::TrySend(bm, flags) : ec;
+    }
+
+    std::vector<error_code_type> _Socket::SendBatch(binary_message* const msgs, size_type count, flag_type flags) {
+
+        // Everything is canceled until proven otherwise.
+        std::vector<error_code_type> results(count, ec_ecanceled);
+
+        // The error channel is the result vector, so we call NNG directly and pay for the set up only once.
+        for (size_type i = 0; i < count; i++) {
+            if ((results[i] = TrySend(msgs[i], flags)) != ec_enone) { break; }
+        }
+
+        return results;
     }
 
     void _Socket::SendAsync(const basic_async_service* const svcp) {
-        const auto& op = bind(&::nng_send_aio, sid, svcp->_aiop);
-        invocation::with_void_return_value(op);
+        svcp->on_starting(_metricsp, true);
+        invocation::with_void_return_value(&::nng_send_aio, sid, svcp->_aiop);
     }
 
     template<class Buffer_>
-    bool try_receive(int sid, Buffer_& buf, std::size_t& sz, flag_type flags) {
+    bool try_receive(nng_socket sid, Buffer_& buf, std::size_t& sz, flag_type flags, _Metrics* const mp) {
+        const __metrics_probe probe(mp, metric_receive_latency);
         buf.resize(sz);
         // &buf[0] ????
-        const auto& op = bind(&::nng_recv, sid, _1, _2, _3);
-        invocation::with_default_error_handling(op, (void*)buf.data(), &sz
-            , static_cast<int>(flags));
+        // NNG writes sz, so it must be read only after the call has returned.
+        const auto ec = invocation::with_error_code(&::nng_recv, sid, (void*)buf.data(), &sz, static_cast<int>(flags));
+        probe.throw_if_failed(probe(ec, sz));
         return sz > 0;
     }
 
@@ -136,22 +247,16 @@ namespace nng {
         ownership semantics. The cost has to be paid at some point, either on the front side or
         the back side, so we pay for it here in additional semantics. */
         msg_type* msgp = nullptr;
-        try {
-            const auto& recv_ = bind(&::nng_recvmsg, sid, &msgp, _1);
-            invocation::with_default_error_handling(recv_, static_cast<int>(flags));
-        }
-#if 0
-        catch (std::exception& ex) {
-#else
-        catch (...) {
-#endif
+        const __metrics_probe probe(_metricsp.get(), metric_receive_latency);
+        const auto ec = invocation::with_error_code(&::nng_recvmsg, sid, &msgp, static_cast<int>(flags));
+        probe(ec, probe.get_size(msgp));
+        if (ec != ec_enone) {
             // TODO: TBD: this is probably (PROBABLY) about as good as we can expect here...
             if (msgp) {
-                const auto& free_ = bind(&::nng_msg_free, msgp);
-                invocation::with_void_return_value(free_);
+                invocation::with_void_return_value(&::nng_msg_free, msgp);
             }
-            // Re-throw the exception after taking care of potential memory allocation.
-            throw;
+            // Throw the exception after taking care of potential memory allocation.
+            probe.throw_if_failed(ec);
         }
         bmp->retain(msgp);
         return bmp->HasOne();
@@ -165,11 +270,169 @@ namespace nng {
     }
 
     bool _Socket::TryReceive(buffer_vector_type* const bufp, size_type& sz, flag_type flags) {
-        return nng::try_receive(sid, *bufp, sz, flags);
+        return nng::try_receive(sid, *bufp, sz, flags, _metricsp.get());
+    }
+
+    allocated_buffer _Socket::ReceiveAllocated(flag_type flags) {
+        allocated_buffer buf;
+        _Socket::TryReceive(&buf, flags);
+        return buf;
+    }
+
+    bool _Socket::TryReceive(allocated_buffer* const abp, flag_type flags) {
+        /* In this mode NNG hands us its own allocation, sized to the message, so there is no
+        resize or zero-fill, nor is there any truncation. NNG allocates nothing on failure. */
+        void* ptr = nullptr;
+        size_type sz = 0;
+        const __metrics_probe probe(_metricsp.get(), metric_receive_latency);
+        // Ditto reading sz only after NNG has written it.
+        const auto ec = invocation::with_error_code(&::nng_recv, sid, (void*)&ptr, &sz
+            , static_cast<int>(flags) | static_cast<int>(flag_alloc));
+        probe.throw_if_failed(probe(ec, sz));
+        abp->retain(ptr, sz);
+        return abp->HasOne();
+    }
+
+    error_code_type _Socket::TryReceive(binary_message& m, flag_type flags) {
+        msg_type* msgp = nullptr;
+        const __metrics_probe probe(_metricsp.get(), metric_receive_latency);
+        const auto ec = invocation::with_error_code(&::nng_recvmsg, sid, &msgp, static_cast<int>(flags));
+        probe(ec, probe.get_size(msgp));
+        if (ec == ec_enone) { m.retain(msgp); }
+        return ec;
+    }
+
+    error_code_type _Socket::TryReceive(allocated_buffer& buf, flag_type flags) {
+        void* ptr = nullptr;
+        size_type sz = 0;
+        const __metrics_probe probe(_metricsp.get(), metric_receive_latency);
+        const auto ec = invocation::with_error_code(&::nng_recv, sid, (void*)&ptr, &sz
+            , static_cast<int>(flags) | static_cast<int>(flag_alloc));
+        probe(ec, sz);
+        if (ec == ec_enone) { buf.retain(ptr, sz); }
+        return ec;
+    }
+
+    size_type _Socket::ReceiveScatter(const mutable_buffer_segment* const segs, size_type count, flag_type flags) {
+        size_type sz = 0;
+        __throw_if_failed(_metricsp.get(), _Socket::TryReceiveScatter(segs, count, sz, flags));
+        return sz;
+    }
+
+    error_code_type _Socket::TryReceiveScatter(const mutable_buffer_segment* const segs, size_type count
+        , size_type& sz, flag_type flags) {
+
+        sz = 0;
+
+        binary_message bm;
+
+        const auto ec = _Socket::TryReceive(bm, flags);
+
+        if (ec != ec_enone) { return ec; }
+
+        // One copy, straight out of the NNG message, which is freed along with bm.
+        return scatter(bm, segs, count, sz) ? ec_enone : ec_emsgsize;
+    }
+
+    error_code_type _Socket::ReceiveBatch(std::vector<std::unique_ptr<binary_message>>& results
+        , size_type max, const duration_type& timeout) {
+
+        if (max == 0) { return ec_enone; }
+
+        // Results may already hold messages, which do not count against max.
+        const auto target = results.size() + max;
+
+        msg_type* msgp = nullptr;
+
+        // Wait for the first message with a one-off AIO so that the socket receive timeout is left alone.
+        if (timeout.count() != dur_zero) {
+            const __metrics_probe probe(_metricsp.get(), metric_receive_latency);
+            basic_async_service svc;
+            svc.GetOptions()->SetTimeoutDuration(timeout);
+            ::nng_recv_aio(sid, svc._aiop);
+            svc.Wait();
+            const auto ec = invocation::with_error_code(&::nng_aio_result, svc._aiop);
+            msgp = ec == ec_enone ? ::nng_aio_get_msg(svc._aiop) : nullptr;
+            if (probe(ec, probe.get_size(msgp)) != ec_enone) { return ec; }
+            results.push_back(std::make_unique<binary_message>(msgp));
+        }
+
+        // Then drain what is already queued without blocking.
+        while (results.size() < target) {
+            msgp = nullptr;
+            const auto errnum = ::nng_recvmsg(sid, &msgp, static_cast<int>(flag_nonblock));
+            if (errnum == ec_eagain) { break; }
+            if (errnum != 0) { return static_cast<error_code_type>(errnum); }
+            // Already queued, so there is no latency worth recording.
+            if (_metricsp) {
+                _metricsp->Count(metric_messages_received);
+                _metricsp->Count(metric_bytes_received, ::nng_msg_header_len(msgp) + ::nng_msg_len(msgp));
+            }
+            results.push_back(std::make_unique<binary_message>(msgp));
+        }
+
+        return ec_enone;
     }
 
     void _Socket::ReceiveAsync(basic_async_service* const svcp) {
-        const auto& op = bind(&::nng_recv_aio, sid, svcp->_aiop);
-        invocation::with_void_return_value(op);
+        svcp->on_starting(_metricsp, false);
+        invocation::with_void_return_value(&::nng_recv_aio, sid, svcp->_aiop);
+    }
+
+    std::shared_ptr<_Metrics> _Socket::EnableMetrics() {
+        if (!_metricsp) { _metricsp = std::make_shared<_Metrics>(); }
+        return _metricsp;
+    }
+
+    bool _Socket::HasMetrics() const {
+        return _metricsp != nullptr;
     }
+
+    metrics_snapshot _Socket::GetMetrics() const {
+        return _metricsp ? _metricsp->GetSnapshot() : metrics_snapshot();
+    }
+
+    void _Socket::throw_if_failed(error_code_type ec) const {
+        __throw_if_failed(_metricsp.get(), ec);
+    }
+
+    uint32_t _Socket::get_profile_fields() const {
+        return profile_socket_fields;
+    }
+
+    _OptionProfile _Socket::Snapshot() {
+        return have_options_type::GetOptions()->Snapshot(get_profile_fields());
+    }
+
+    void _Socket::Apply(const _OptionProfile& profile) {
+        have_options_type::GetOptions()->Apply(profile, get_profile_fields());
+    }
+
+    async_future _Socket::ReceiveFuture() {
+        return async_promise::start(sid, false, nullptr, nullptr);
+    }
+
+    async_future _Socket::ReceiveFuture(const duration_type& timeout) {
+        return async_promise::start(sid, false, nullptr, &timeout);
+    }
+
+    async_future _Socket::SendFuture(binary_message&& m) {
+        return async_promise::start(sid, true, m.cede_message(), nullptr);
+    }
+
+    async_future _Socket::SendFuture(binary_message&& m, const duration_type& timeout) {
+        return async_promise::start(sid, true, m.cede_message(), &timeout);
+    }
+
+#ifdef NNGCPP_ENABLE_COROUTINES
+
+    receive_awaitable _Socket::AsyncReceive() {
+        return receive_awaitable(sid);
+    }
+
+    send_awaitable _Socket::AsyncSend(binary_message& m) {
+        return send_awaitable(sid, m);
+    }
+
+#endif // NNGCPP_ENABLE_COROUTINES
 }
@@ -15,6 +15,10 @@
 #include "ICanDial.hpp"
 
 #include "exceptions.hpp"
+#include "metrics.h"
+
+#include "async/awaitable.h"
+#include "async/async_future.h"
 
 #define THROW_SOCKET_INV_OP(s, op) throw nng::exceptions::invalid_operation(#s " cannot " #op)
 
@@ -45,12 +49,17 @@ namespace nng {
 
         friend class _Listener;
         friend class _Dialer;
+        friend class _AioPool;
+        friend class _DeviceForwarder;
 
         // For use with Device Thread Callback.
         friend void install_device_sockets_callback(const device_path* const);
 
         nng_type sid;
 
+        // Null until metrics are enabled, which is all the instrumented paths check.
+        std::shared_ptr<_Metrics> _metricsp;
+
         friend nng_type get_sid(const _Socket&);
 
         void configure_options(nng_type sid);
@@ -61,6 +70,12 @@ namespace nng {
 
         _Socket(const nng_ctor_func& nng_ctor);
 
+        // Throws the same as the default error handling would, counting the exception when metrics are enabled.
+        void throw_if_failed(error_code_type ec) const;
+
+        // Which profile fields Snapshot and Apply cover; protocols with options of their own extend these.
+        virtual uint32_t get_profile_fields() const;
+
     public:
 
         virtual ~_Socket();
@@ -83,6 +98,14 @@ namespace nng {
         virtual void Send(const buffer_vector_type& buf, flag_type flags = flag_none) override;
         virtual void Send(const buffer_vector_type& buf, size_type sz, flag_type flags = flag_none) override;
 
+        virtual error_code_type TrySend(binary_message& m, flag_type flags = flag_none) override;
+        virtual error_code_type TrySend(const buffer_vector_type& buf, flag_type flags = flag_none) override;
+
+        virtual void SendGather(const const_buffer_segment* const segs, size_type count, flag_type flags = flag_none) override;
+        virtual error_code_type TrySendGather(const const_buffer_segment* const segs, size_type count, flag_type flags = flag_none) override;
+
+        virtual std::vector<error_code_type> SendBatch(binary_message* const msgs, size_type count, flag_type flags = flag_none) override;
+
         virtual void SendAsync(const basic_async_service* const svcp) override;
 
         virtual std::unique_ptr<binary_message> Receive(flag_type flags = flag_none) override;
@@ -91,7 +114,54 @@ namespace nng {
         virtual buffer_vector_type Receive(size_type& sz, flag_type flags = flag_none) override;
         virtual bool TryReceive(buffer_vector_type* const bufp, size_type& sz, flag_type flags = flag_none) override;
 
+        virtual allocated_buffer ReceiveAllocated(flag_type flags = flag_none) override;
+        virtual bool TryReceive(allocated_buffer* const abp, flag_type flags = flag_none) override;
+
+        virtual error_code_type TryReceive(binary_message& m, flag_type flags = flag_none) override;
+        virtual error_code_type TryReceive(allocated_buffer& buf, flag_type flags = flag_none) override;
+
+        virtual size_type ReceiveScatter(const mutable_buffer_segment* const segs, size_type count, flag_type flags = flag_none) override;
+        virtual error_code_type TryReceiveScatter(const mutable_buffer_segment* const segs, size_type count
+            , size_type& sz, flag_type flags = flag_none) override;
+
+        virtual error_code_type ReceiveBatch(std::vector<std::unique_ptr<binary_message>>& results
+            , size_type max, const duration_type& timeout) override;
+
         virtual void ReceiveAsync(basic_async_service* const svcp) override;
+
+        /* Metrics are opt-in. Enabling them is not synchronized with the operations that record
+        them, so do so before sharing the socket among threads. Listeners and dialers created
+        afterwards, as well as asynchronous services started here, record into the same metrics. */
+        std::shared_ptr<_Metrics> EnableMetrics();
+
+        bool HasMetrics() const;
+
+        // Returns an empty snapshot when metrics are not enabled.
+        metrics_snapshot GetMetrics() const;
+
+        // Reads every option a profile may carry for this protocol of socket.
+        _OptionProfile Snapshot();
+
+        // Sets the whole profile in one call, having validated all of it first.
+        void Apply(const _OptionProfile& profile);
+
+        // Failures are delivered through the future rather than thrown.
+        async_future ReceiveFuture();
+        async_future ReceiveFuture(const duration_type& timeout);
+
+        // The message is returned through the future when the send fails.
+        async_future SendFuture(binary_message&& m);
+        async_future SendFuture(binary_message&& m, const duration_type& timeout);
+
+#ifdef NNGCPP_ENABLE_COROUTINES
+
+        // i.e. auto bmp = co_await s.AsyncReceive();
+        receive_awaitable AsyncReceive();
+
+        // i.e. co_await s.AsyncSend(m);
+        send_awaitable AsyncSend(binary_message& m);
+
+#endif // NNGCPP_ENABLE_COROUTINES
     };
 }
 
@@ -0,0 +1,86 @@
+#include "allocated_buffer.h"
+
+namespace nng {
+
+    _AllocatedBuffer::_AllocatedBuffer()
+        : IHaveOne()
+        , _ptr(nullptr), _sz(0) {
+    }
+
+    _AllocatedBuffer::_AllocatedBuffer(void* ptr, size_type sz)
+        : IHaveOne()
+        , _ptr(ptr), _sz(ptr == nullptr ? 0 : sz) {
+    }
+
+    _AllocatedBuffer::_AllocatedBuffer(_AllocatedBuffer&& other)
+        : IHaveOne()
+        , _ptr(nullptr), _sz(0) {
+
+        size_type sz = 0;
+        auto ptr = other.cede(&sz);
+        retain(ptr, sz);
+    }
+
+    _AllocatedBuffer::~_AllocatedBuffer() {
+        free();
+    }
+
+    _AllocatedBuffer& _AllocatedBuffer::operator=(_AllocatedBuffer&& other) {
+        if (this != &other) {
+            size_type sz = 0;
+            auto ptr = other.cede(&sz);
+            retain(ptr, sz);
+        }
+        return *this;
+    }
+
+    bool _AllocatedBuffer::HasOne() const {
+        return _ptr != nullptr;
+    }
+
+    size_type _AllocatedBuffer::GetSize() const {
+        return _sz;
+    }
+
+    const _AllocatedBuffer::value_type* _AllocatedBuffer::data() const {
+        return static_cast<const value_type*>(_ptr);
+    }
+
+    _AllocatedBuffer::value_type* _AllocatedBuffer::data() {
+        return static_cast<value_type*>(_ptr);
+    }
+
+    _AllocatedBuffer::const_iterator _AllocatedBuffer::begin() const {
+        return data();
+    }
+
+    _AllocatedBuffer::const_iterator _AllocatedBuffer::end() const {
+        return data() + _sz;
+    }
+
+    const _AllocatedBuffer::value_type& _AllocatedBuffer::operator[](size_type i) const {
+        return data()[i];
+    }
+
+    void _AllocatedBuffer::free() {
+        if (!HasOne()) { return; }
+        // NNG requires the original allocation size when freeing.
+        ::nng_free(_ptr, _sz);
+        _ptr = nullptr;
+        _sz = 0;
+    }
+
+    void* _AllocatedBuffer::cede(size_type* const szp) {
+        auto ptr = _ptr;
+        if (szp) { *szp = _sz; }
+        _ptr = nullptr;
+        _sz = 0;
+        return ptr;
+    }
+
+    void _AllocatedBuffer::retain(void* ptr, size_type sz) {
+        free();
+        _ptr = ptr;
+        _sz = ptr == nullptr ? 0 : sz;
+    }
+}
@@ -0,0 +1,70 @@
+#ifndef NNGCPP_ALLOCATED_BUFFER_H
+#define NNGCPP_ALLOCATED_BUFFER_H
+
+#include "../core/types.h"
+#include "../core/IHaveOne.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace nng {
+
+    /* Owns a buffer that NNG allocated on our behalf, i.e. via NNG_FLAG_ALLOC. The buffer is
+    released back to NNG via nng_free, so it is strictly move-only: there is no sense in which
+    two handles could own the same allocation. This allows receivers to avoid paying for a
+    vector allocation, and its zero-fill, on every message. */
+    class _AllocatedBuffer : public IHaveOne {
+    public:
+
+        typedef uint8_t value_type;
+        typedef const value_type* const_iterator;
+
+    private:
+
+        void* _ptr;
+
+        size_type _sz;
+
+    public:
+
+        _AllocatedBuffer();
+
+        _AllocatedBuffer(void* ptr, size_type sz);
+
+        _AllocatedBuffer(_AllocatedBuffer&& other);
+
+        _AllocatedBuffer(const _AllocatedBuffer&) = delete;
+
+        virtual ~_AllocatedBuffer();
+
+        _AllocatedBuffer& operator=(_AllocatedBuffer&& other);
+
+        _AllocatedBuffer& operator=(const _AllocatedBuffer&) = delete;
+
+        virtual bool HasOne() const override;
+
+        size_type GetSize() const;
+
+        const value_type* data() const;
+
+        value_type* data();
+
+        const_iterator begin() const;
+
+        const_iterator end() const;
+
+        const value_type& operator[](size_type i) const;
+
+        // Releases the buffer back to NNG.
+        void free();
+
+        // Relinquishes ownership; the caller is responsible for nng_free (ptr, sz).
+        void* cede(size_type* const szp = nullptr);
+
+        void retain(void* ptr, size_type sz);
+    };
+
+    typedef _AllocatedBuffer allocated_buffer;
+}
+
+#endif // NNGCPP_ALLOCATED_BUFFER_H
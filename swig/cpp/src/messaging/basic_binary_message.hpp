@@ -73,12 +73,9 @@ namespace nng {
         }
 
         virtual operator std::string() {
-            std::string s;
-            const auto buf = GetBody()->Get();
-            for (auto it = buf.begin(); it != buf.end(); it++) {
-                s.push_back(((std::string::value_type*)*it)[0]);
-            }
-            return s;
+            // Straight from the message body, in one copy.
+            const auto view = GetBody()->GetView();
+            return std::string(reinterpret_cast<const std::string::value_type*>(view.data()), view.GetSize());
         }
     };
 }
@@ -40,6 +40,13 @@ namespace nng {
         return ICanGetType::Get();
     }
 
+    buffer_view _BodyMessagePart::GetView() const {
+        const auto msgp = get_message();
+        if (msgp == nullptr) { return buffer_view(); }
+        // Points directly into the message, so there is no copy to be made here.
+        return buffer_view(::nng_msg_body(msgp), ::nng_msg_len(msgp));
+    }
+
     bool _BodyMessagePart::TryGet(buffer_vector_type const* resultp) {
 
         if (!HasOne()) { return false; }
@@ -52,16 +59,26 @@ namespace nng {
 
         const auto convert_ = [sz](PolTy::intermediate_type xp, PolTy::result_type yp) {
             if (xp == nullptr) { return false; }
-            auto* src = (const buffer_vector_type::value_type*)xp;
-            for (size_type i = 0; i < sz; i++) {
-                yp->push_back((src + i)[0]);
-            }
+            auto* const src = (const buffer_vector_type::value_type*)xp;
+            // One bulk copy rather than growing the vector byte by byte.
+            yp->assign(src, src + sz);
             return yp->size() > 0;
         };
 
         return policy_type::TryGet(const_cast<PolTy::result_type>(resultp), get_message(), get_, convert_);
     }
 
+    void _BodyMessagePart::append(const void* const datap, size_type sz) {
+        // Also save calories if there are no bytes to append.
+        if (!HasOne() || sz == 0) { return; }
+        invocation::with_default_error_handling(&::nng_msg_append, get_message(), datap, sz);
+    }
+
+    void _BodyMessagePart::prepend(const void* const datap, size_type sz) {
+        if (!HasOne() || sz == 0) { return; }
+        invocation::with_default_error_handling(&::nng_msg_insert, get_message(), datap, sz);
+    }
+
     void _BodyMessagePart::Clear() {
         if (!HasOne()) { return; }
         const auto op = std::bind(&::nng_msg_clear, get_message());
@@ -69,19 +86,12 @@ namespace nng {
     }
 
     void _BodyMessagePart::Append(const buffer_vector_type& buf) {
-        // Also save calories if there are no bytes to append.
-        if (!(HasOne() || buf.size())) { return; }
-        // Bind to concrete message ptr along same lines as with options API.
-        const auto op = std::bind(&::nng_msg_append, get_message(), _1, _2);
-        invocation::with_default_error_handling(op, (const void*)&buf[0], buf.size());
+        append(buf.data(), buf.size());
     }
 
     void _BodyMessagePart::Append(const std::string& s) {
-        // Also bypass when the string is empty.
-        if (!(HasOne() || s.length())) { return; }
-        buffer_vector_type buf(s.cbegin(), s.cend());
-        // Which is a little redundant, but it saves calories.
-        Append(buf);
+        // Straight into the message, without copying into a buffer first.
+        append(s.data(), s.length());
     }
 
     void _BodyMessagePart::Append(uint32_t val) {
@@ -91,18 +101,11 @@ namespace nng {
     }
 
     void _BodyMessagePart::Prepend(const buffer_vector_type& buf) {
-        // Also save calories if there are no bytes to prepend.
-        if (!(HasOne() || buf.size())) { return; }
-        const auto op = std::bind(&::nng_msg_insert, get_message(), _1, _2);
-        invocation::with_default_error_handling(op, (const void*)&buf[0], buf.size());
+        prepend(buf.data(), buf.size());
     }
 
     void _BodyMessagePart::Prepend(const std::string& s) {
-        // Also bypass when the string is empty.
-        if (!(HasOne() || s.length())) { return; }
-        buffer_vector_type buf(s.cbegin(), s.cend());
-        // Which is a little redundant, but it saves calories.
-        Prepend(buf);
+        prepend(s.data(), s.length());
     }
 
     void _BodyMessagePart::Prepend(uint32_t val) {
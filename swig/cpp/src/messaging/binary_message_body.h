@@ -25,6 +25,12 @@ namespace nng {
 #endif //NNGCPP_STRING_BASED_MESSAGE_H
 
     class _BodyMessagePart : public _MessagePart {
+    private:
+
+        void append(const void* const datap, size_type sz);
+
+        void prepend(const void* const datap, size_type sz);
+
     protected:
 
         template<class Body_, class Header_> friend class _BasicMessage;
@@ -41,6 +47,8 @@ namespace nng {
 
         virtual const buffer_vector_type Get() override;
 
+        virtual buffer_view GetView() const override;
+
         virtual size_type GetSize() override;
 
         virtual void Clear() override;
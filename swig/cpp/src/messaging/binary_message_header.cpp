@@ -44,6 +44,13 @@ namespace nng {
         return ICanGetType::Get();
     }
 
+    buffer_view _HeaderMessagePart::GetView() const {
+        const auto msgp = get_message();
+        if (msgp == nullptr) { return buffer_view(); }
+        // Points directly into the message, so there is no copy to be made here.
+        return buffer_view(::nng_msg_header(msgp), ::nng_msg_header_len(msgp));
+    }
+
     // TODO: TBD: this is fairly redundant with body: there has got to be a better way to capture this as a cross cutting concern...
     bool _HeaderMessagePart::TryGet(buffer_vector_type const* resultp) {
 
@@ -58,9 +65,8 @@ namespace nng {
         const auto convert_ = [sz](PolTy::intermediate_type xp, PolTy::result_type yp) {
             if (xp == nullptr) { return false; }
             auto* const src = (const buffer_vector_type::value_type*)xp;
-            for (size_type i = 0; i < sz; i++) {
-                yp->push_back((src + i)[0]);
-            }
+            // One bulk copy rather than growing the vector byte by byte.
+            yp->assign(src, src + sz);
             return yp->size() > 0;
         };
 
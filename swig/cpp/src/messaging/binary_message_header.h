@@ -43,6 +43,8 @@ namespace nng {
 
         virtual const buffer_vector_type Get() override;
 
+        virtual buffer_view GetView() const override;
+
         virtual size_type GetSize() override;
 
         // TODO: TBD: so if header is truly "read-only" then it is debatable whether "clear" should be exposed via header...
@@ -0,0 +1,75 @@
+#include "buffer_segment.h"
+#include "../core/invocation.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace nng {
+
+    _ConstBufferSegment::_ConstBufferSegment() : data(nullptr), size(0) {
+    }
+
+    _ConstBufferSegment::_ConstBufferSegment(const void* const data, size_type size)
+        : data(data), size(data == nullptr ? 0 : size) {
+    }
+
+    _ConstBufferSegment::_ConstBufferSegment(const buffer_vector_type& buf)
+        : data(buf.data()), size(buf.size()) {
+    }
+
+    _MutableBufferSegment::_MutableBufferSegment() : data(nullptr), size(0) {
+    }
+
+    _MutableBufferSegment::_MutableBufferSegment(void* const data, size_type size)
+        : data(data), size(data == nullptr ? 0 : size) {
+    }
+
+    _MutableBufferSegment::_MutableBufferSegment(buffer_vector_type& buf)
+        : data(buf.data()), size(buf.size()) {
+    }
+
+    error_code_type gather(binary_message& m, const _ConstBufferSegment* const segs, size_type count) {
+
+        size_type total = 0;
+
+        for (size_type i = 0; i < count; i++) { total += segs[i].size; }
+
+        msg_type* msgp = nullptr;
+
+        const auto ec = invocation::with_error_code(&::nng_msg_alloc, &msgp, total);
+
+        if (ec != ec_enone) { return ec; }
+
+        auto* p = static_cast<uint8_t*>(::nng_msg_body(msgp));
+
+        for (size_type i = 0; i < count; i++) {
+            if (!segs[i].size) { continue; }
+            std::memcpy(p, segs[i].data, segs[i].size);
+            p += segs[i].size;
+        }
+
+        m.retain(msgp);
+
+        return ec_enone;
+    }
+
+    bool scatter(const binary_message& m, const _MutableBufferSegment* const segs, size_type count, size_type& sz) {
+
+        const auto msgp = m.get_message();
+
+        sz = msgp ? ::nng_msg_len(msgp) : 0;
+
+        const auto* p = msgp ? static_cast<const uint8_t*>(::nng_msg_body(msgp)) : nullptr;
+
+        auto remaining = sz;
+
+        for (size_type i = 0; i < count && remaining; i++) {
+            const auto n = std::min(segs[i].size, remaining);
+            std::memcpy(segs[i].data, p, n);
+            p += n;
+            remaining -= n;
+        }
+
+        return remaining == 0;
+    }
+}
@@ -0,0 +1,53 @@
+#ifndef NNGCPP_BUFFER_SEGMENT_H
+#define NNGCPP_BUFFER_SEGMENT_H
+
+#include "../core/types.h"
+#include "../core/enums.h"
+
+#include "binary_message.h"
+
+namespace nng {
+
+    // Borrowed, read-only region of memory, i.e. a header struct, or part of a larger payload.
+    struct _ConstBufferSegment {
+
+        const void* data;
+
+        size_type size;
+
+        _ConstBufferSegment();
+
+        _ConstBufferSegment(const void* const data, size_type size);
+
+        _ConstBufferSegment(const buffer_vector_type& buf);
+    };
+
+    // Borrowed, writable region of memory, which scattered receives fill.
+    struct _MutableBufferSegment {
+
+        void* data;
+
+        size_type size;
+
+        _MutableBufferSegment();
+
+        _MutableBufferSegment(void* const data, size_type size);
+
+        _MutableBufferSegment(buffer_vector_type& buf);
+    };
+
+    typedef _ConstBufferSegment const_buffer_segment;
+    typedef _MutableBufferSegment mutable_buffer_segment;
+
+    /* Replaces the message with one allocated at the combined size of the segments, each of
+    them copied in, in order. That is one allocation, and one copy, regardless of the segment
+    count. Returns ec_enomem, leaving the message alone, when NNG cannot allocate. */
+    error_code_type gather(binary_message& m, const _ConstBufferSegment* const segs, size_type count);
+
+    /* Copies the body into the segments in order, filling each before moving on to the next.
+    The body size is reported through sz. Returns false when the body is longer than all of
+    the segments together, in which case they hold as much of it as fit. */
+    bool scatter(const binary_message& m, const _MutableBufferSegment* const segs, size_type count, size_type& sz);
+}
+
+#endif // NNGCPP_BUFFER_SEGMENT_H
@@ -0,0 +1,53 @@
+#include "buffer_view.h"
+
+namespace nng {
+
+    _BufferView::_BufferView()
+        : _datap(nullptr), _sz(0) {
+    }
+
+    _BufferView::_BufferView(const void* datap, size_type sz)
+        : _datap(static_cast<const value_type*>(datap)), _sz(datap == nullptr ? 0 : sz) {
+    }
+
+    _BufferView::_BufferView(const _BufferView& other)
+        : _datap(other._datap), _sz(other._sz) {
+    }
+
+    _BufferView::~_BufferView() {
+    }
+
+    _BufferView& _BufferView::operator=(const _BufferView& other) {
+        _datap = other._datap;
+        _sz = other._sz;
+        return *this;
+    }
+
+    const _BufferView::value_type* _BufferView::data() const {
+        return _datap;
+    }
+
+    size_type _BufferView::GetSize() const {
+        return _sz;
+    }
+
+    bool _BufferView::IsEmpty() const {
+        return _sz == 0;
+    }
+
+    _BufferView::const_iterator _BufferView::begin() const {
+        return _datap;
+    }
+
+    _BufferView::const_iterator _BufferView::end() const {
+        return _datap + _sz;
+    }
+
+    const _BufferView::value_type& _BufferView::operator[](size_type i) const {
+        return _datap[i];
+    }
+
+    std::vector<_BufferView::value_type> _BufferView::ToBuffer() const {
+        return std::vector<value_type>(begin(), end());
+    }
+}
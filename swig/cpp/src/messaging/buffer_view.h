@@ -0,0 +1,57 @@
+#ifndef NNGCPP_BUFFER_VIEW_H
+#define NNGCPP_BUFFER_VIEW_H
+
+#include "../core/types.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace nng {
+
+    /* A read-only, non-owning pointer plus length over bytes owned by someone else, usually
+    an NNG message. The view remains valid only until the underlying message is mutated or
+    freed, after which it must be obtained again. Use ToBuffer when a copy is required. */
+    class _BufferView {
+    public:
+
+        typedef uint8_t value_type;
+        typedef const value_type* const_iterator;
+
+    private:
+
+        const value_type* _datap;
+
+        size_type _sz;
+
+    public:
+
+        _BufferView();
+
+        _BufferView(const void* datap, size_type sz);
+
+        _BufferView(const _BufferView& other);
+
+        ~_BufferView();
+
+        _BufferView& operator=(const _BufferView& other);
+
+        const value_type* data() const;
+
+        size_type GetSize() const;
+
+        bool IsEmpty() const;
+
+        const_iterator begin() const;
+
+        const_iterator end() const;
+
+        const value_type& operator[](size_type i) const;
+
+        std::vector<value_type> ToBuffer() const;
+    };
+
+    typedef _BufferView buffer_view;
+}
+
+#endif // NNGCPP_BUFFER_VIEW_H
@@ -13,21 +13,21 @@ namespace nng {
 
     _MessageBase::_MessageBase()
         : IHaveOne(), IClearable(), supports_getting_msg()
-        , _msgp(nullptr) {
+        , _recyclerp(), _msgp(nullptr) {
 
         allocate();
     }
 
     _MessageBase::_MessageBase(size_type sz)
         : IHaveOne(), IClearable(), supports_getting_msg()
-        , _msgp(nullptr) {
+        , _recyclerp(), _msgp(nullptr) {
 
         allocate(sz);
     }
 
     _MessageBase::_MessageBase(msg_type* msgp)
         : IHaveOne(), IClearable(), supports_getting_msg()
-        , _msgp(msgp) {
+        , _recyclerp(), _msgp(msgp) {
     }
 
     _MessageBase::~_MessageBase() {
@@ -60,8 +60,17 @@ namespace nng {
         retain(msgp);
     }
 
+    void _MessageBase::set_recycler(const std::shared_ptr<IMessageRecycler>& recyclerp) {
+        _recyclerp = recyclerp;
+    }
+
     void _MessageBase::free() {
         if (!HasOne()) { return; }
+        // Give the recycler, when there is one, first right of refusal.
+        if (_recyclerp && _recyclerp->TryRecycle(_msgp)) {
+            _msgp = nullptr;
+            return;
+        }
         const auto op = bind(&::nng_msg_free, _msgp);
         invocation::with_void_return_value(op);
         // Just set the member directly since we own it.
@@ -8,6 +8,7 @@
 #include <cstdint>
 #include <vector>
 #include <functional>
+#include <memory>
 
 namespace nng {
 
@@ -22,6 +23,20 @@ namespace nng {
 
     typedef std::vector<uint8_t> buffer_vector_type;
 
+    /* Allows a message to hand its NNG message back to whomever issued it, i.e. a pool,
+    rather than freeing it outright. */
+    struct IMessageRecycler {
+
+        virtual ~IMessageRecycler() {}
+
+        // Returns true when the message was taken back, otherwise the caller must free it.
+        virtual bool TryRecycle(msg_type* const msgp) = 0;
+    };
+
+#ifndef NNGCPP_MESSAGE_POOL_H
+    class _MessagePool;
+#endif // NNGCPP_MESSAGE_POOL_H
+
     class _MessageBase
         : public IHaveOne
         , public IClearable
@@ -30,6 +45,12 @@ namespace nng {
 
         void allocate(size_type sz = 0);
 
+        friend class _MessagePool;
+
+        std::shared_ptr<IMessageRecycler> _recyclerp;
+
+        void set_recycler(const std::shared_ptr<IMessageRecycler>& recyclerp);
+
     protected:
 
         msg_type* _msgp;
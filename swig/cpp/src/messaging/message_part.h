@@ -11,6 +11,7 @@ namespace nng {
         , public IClearable
         , public supports_getting_msg
         , public ICanGet<buffer_vector_type>
+        , public ICanView<buffer_view>
         , public ICanAppend<const buffer_vector_type&>
         , public ICanAppend<const std::string&>
         , public ICanAppend<uint32_t>
@@ -69,11 +69,11 @@ namespace nng {
 
         auto op = GetOptions();
 
-        op->set_getters(
-            bind(&::nng_pipe_getopt, pid, _1, _2, _3)
-            , bind(&::nng_pipe_getopt_int, pid, _1, _2)
-            , bind(&::nng_pipe_getopt_size, pid, _1, _2)
-            , bind(&::nng_pipe_getopt_ms, pid, _1, _2)
+        op->set_getters(pid
+            , &::nng_pipe_getopt
+            , &::nng_pipe_getopt_int
+            , &::nng_pipe_getopt_size
+            , &::nng_pipe_getopt_ms
         );
     }
 
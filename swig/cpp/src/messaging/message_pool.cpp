@@ -0,0 +1,240 @@
+#include "message_pool.h"
+#include "../core/invocation.hpp"
+
+#include <unordered_map>
+
+namespace nng {
+
+    using std::placeholders::_1;
+    using std::bind;
+
+    _MessageSizeClass::_MessageSizeClass(size_type size, size_type high_water)
+        : size(size), high_water(high_water) {
+    }
+
+    _MessagePoolStats::_MessagePoolStats()
+        : hits(0), misses(0), recycled(0), released(0) {
+    }
+
+    typedef std::vector<std::vector<msg_type*>> __free_lists_type;
+
+    void __free_all(__free_lists_type& lists) {
+        for (auto& list : lists) {
+            for (auto& msgp : list) {
+                ::nng_msg_free(msgp);
+            }
+            list.clear();
+        }
+    }
+
+    struct _MessagePoolCache : public IMessageRecycler {
+
+        // Only ever contended by a cross-thread return, or by a drain.
+        std::mutex mutex;
+
+        __free_lists_type lists;
+
+        // Messages keep their pool alive, so this is valid whenever one of them comes back.
+        _MessagePool* const poolp;
+
+        _MessagePoolCache(_MessagePool* const poolp, size_type count)
+            : IMessageRecycler(), mutex(), lists(count), poolp(poolp) {
+        }
+
+        virtual ~_MessagePoolCache() {
+            __free_all(lists);
+        }
+
+        void free_all() {
+            std::lock_guard<std::mutex> guard(mutex);
+            __free_all(lists);
+        }
+
+        virtual bool TryRecycle(msg_type* const msgp) override {
+            return poolp->recycle(*this, msgp);
+        }
+    };
+
+    /* Each thread keeps its own free lists, keyed by pool identifier, so that Acquire never
+    contends with other threads. Identifiers are never reused, so a stale entry left behind by
+    a destroyed pool can never be mistaken for a live one. */
+    struct __thread_message_cache {
+
+        std::unordered_map<uint64_t, std::shared_ptr<_MessagePoolCache>> pools;
+
+        ~__thread_message_cache() {
+            for (auto& x : pools) {
+                x.second->free_all();
+            }
+        }
+    };
+
+    static thread_local __thread_message_cache __cache;
+
+    uint64_t __next_pool_id() {
+        static std::atomic<uint64_t> next_id(1);
+        return next_id++;
+    }
+
+    const _MessagePool::size_class_vector_type _MessagePool::default_size_classes = {
+        size_class_type(64, 1024)
+        , size_class_type(256, 1024)
+        , size_class_type(1024, 512)
+        , size_class_type(4096, 256)
+        , size_class_type(16384, 64)
+        , size_class_type(65536, 32)
+    };
+
+    _MessagePool::_MessagePool()
+        : _MessagePool(default_size_classes) {
+    }
+
+    _MessagePool::_MessagePool(const size_class_vector_type& classes)
+        : IMessageRecycler(), std::enable_shared_from_this<_MessagePool>()
+        , _id(__next_pool_id())
+        , _classes(classes)
+        , _hits(0), _misses(0), _recycled(0), _released(0)
+        , _caches_mutex(), _caches() {
+    }
+
+    _MessagePool::~_MessagePool() {
+        // Not Trim, which relies on the calling thread's cache, that may already be gone.
+        Drain();
+    }
+
+    _MessagePoolCache& _MessagePool::get_cache() {
+
+        auto& cachep = __cache.pools[_id];
+
+        if (!cachep) {
+            cachep = std::make_shared<_MessagePoolCache>(this, _classes.size());
+            std::lock_guard<std::mutex> guard(_caches_mutex);
+            _caches.push_back(cachep);
+        }
+
+        return *cachep;
+    }
+
+    size_type _MessagePool::get_class_index(size_type sz) const {
+        size_type i = 0;
+        // Classes are expected to be few and in ascending order, so a linear scan is fine.
+        for (; i < _classes.size(); i++) {
+            if (sz <= _classes[i].size) { break; }
+        }
+        return i;
+    }
+
+    msg_type* _MessagePool::allocate(size_type sz) {
+        msg_type* msgp = nullptr;
+        const auto op = bind(&::nng_msg_alloc, &msgp, _1);
+        invocation::with_default_error_handling(op, sz);
+        return msgp;
+    }
+
+    std::unique_ptr<binary_message> _MessagePool::Acquire(size_type sz) {
+
+        msg_type* msgp = nullptr;
+
+        const auto i = get_class_index(sz);
+
+        auto& cache = get_cache();
+
+        if (i < _classes.size()) {
+            std::lock_guard<std::mutex> guard(cache.mutex);
+            auto& list = cache.lists[i];
+            if (!list.empty()) {
+                msgp = list.back();
+                list.pop_back();
+            }
+        }
+
+        if (msgp) {
+            ++_hits;
+            try {
+                // Recycled messages are cleared with class capacity, so this does not allocate.
+                const auto op = bind(&::nng_msg_realloc, msgp, _1);
+                invocation::with_default_error_handling(op, sz);
+            }
+            catch (...) {
+                ::nng_msg_free(msgp);
+                throw;
+            }
+        }
+        else {
+            ++_misses;
+            // Allocate to class capacity up front so that the message recycles without growing.
+            msgp = allocate(i < _classes.size() ? _classes[i].size : sz);
+            if (i < _classes.size()) {
+                ::nng_msg_chop(msgp, _classes[i].size - sz);
+            }
+        }
+
+        auto bmup = std::make_unique<binary_message>(msgp);
+        // Shares ownership of the pool, but routes the message back to this thread's cache.
+        bmup->set_recycler(std::shared_ptr<IMessageRecycler>(shared_from_this(), &cache));
+        return bmup;
+    }
+
+    bool _MessagePool::TryRecycle(msg_type* const msgp) {
+        return recycle(get_cache(), msgp);
+    }
+
+    bool _MessagePool::recycle(_MessagePoolCache& cache, msg_type* const msgp) {
+
+        if (msgp == nullptr) { return false; }
+
+        const auto i = get_class_index(::nng_msg_len(msgp));
+
+        // Oversized messages go back to NNG.
+        if (i == _classes.size()) {
+            ++_released;
+            return false;
+        }
+
+        const auto& c = _classes[i];
+
+        std::lock_guard<std::mutex> guard(cache.mutex);
+
+        auto& list = cache.lists[i];
+
+        // Ensure class capacity, which only allocates the first time a received message comes through.
+        if (list.size() >= c.high_water || ::nng_msg_realloc(msgp, c.size) != 0) {
+            ++_released;
+            return false;
+        }
+
+        ::nng_msg_clear(msgp);
+        ::nng_msg_header_clear(msgp);
+
+        list.push_back(msgp);
+        ++_recycled;
+        return true;
+    }
+
+    void _MessagePool::Trim() {
+        // The cache itself stays registered, since outstanding messages may still return to it.
+        const auto it = __cache.pools.find(_id);
+        if (it == __cache.pools.end()) { return; }
+        it->second->free_all();
+    }
+
+    void _MessagePool::Drain() {
+        std::lock_guard<std::mutex> guard(_caches_mutex);
+        for (auto& x : _caches) {
+            x->free_all();
+        }
+    }
+
+    const _MessagePool::size_class_vector_type& _MessagePool::GetSizeClasses() const {
+        return _classes;
+    }
+
+    _MessagePool::stats_type _MessagePool::GetStats() const {
+        stats_type result;
+        result.hits = _hits.load();
+        result.misses = _misses.load();
+        result.recycled = _recycled.load();
+        result.released = _released.load();
+        return result;
+    }
+}
@@ -0,0 +1,125 @@
+#ifndef NNGCPP_MESSAGE_POOL_H
+#define NNGCPP_MESSAGE_POOL_H
+
+#include "../core/types.h"
+
+#include "binary_message.h"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace nng {
+
+    struct _MessageSizeClass {
+
+        // Body capacity of every message cached in this class.
+        size_type size;
+
+        // Maximum number of messages cached per thread before we free them instead.
+        size_type high_water;
+
+        _MessageSizeClass(size_type size, size_type high_water);
+    };
+
+    struct _MessagePoolStats {
+
+        // Messages handed out from a free list.
+        uint64_t hits;
+
+        // Messages that required a fresh nng_msg_alloc.
+        uint64_t misses;
+
+        // Messages taken back onto a free list.
+        uint64_t recycled;
+
+        // Messages freed because they were oversized or the class was at its high water.
+        uint64_t released;
+
+        _MessagePoolStats();
+    };
+
+    // Free lists one thread keeps on behalf of one pool.
+    struct _MessagePoolCache;
+
+    /* Keeps per-thread free lists of pre-sized NNG messages, grouped into size classes, and
+    hands them out as binary messages. Messages find their way back to the pool when they are
+    destroyed, or when their NNG message is freed in favor of another, i.e. via retain. Ceded
+    messages belong to NNG at that point and are not recycled.
+
+    Messages return to the free lists of the thread that acquired them, even when another
+    thread destroys them; only that cross-thread return contends with the owning thread. The
+    pool tracks the free lists of every thread that has used it, so that Drain may free them
+    all at once, i.e. ahead of nng_fini, rather than waiting on those threads to exit.
+
+    The pool must be owned by a shared pointer, since every message it hands out keeps the
+    pool alive. */
+    class _MessagePool
+        : public IMessageRecycler
+        , public std::enable_shared_from_this<_MessagePool> {
+    public:
+
+        typedef _MessageSizeClass size_class_type;
+        typedef std::vector<size_class_type> size_class_vector_type;
+        typedef _MessagePoolStats stats_type;
+
+    private:
+
+        const uint64_t _id;
+
+        const size_class_vector_type _classes;
+
+        std::atomic<uint64_t> _hits;
+        std::atomic<uint64_t> _misses;
+        std::atomic<uint64_t> _recycled;
+        std::atomic<uint64_t> _released;
+
+        mutable std::mutex _caches_mutex;
+
+        std::vector<std::shared_ptr<_MessagePoolCache>> _caches;
+
+        friend struct _MessagePoolCache;
+
+        // Returns the calling thread's free lists, registering them with the pool the first time.
+        _MessagePoolCache& get_cache();
+
+        bool recycle(_MessagePoolCache& cache, msg_type* const msgp);
+
+        // Returns the index of the smallest class that fits, or the class count when none does.
+        size_type get_class_index(size_type sz) const;
+
+        msg_type* allocate(size_type sz);
+
+    public:
+
+        static const size_class_vector_type default_size_classes;
+
+        _MessagePool();
+
+        _MessagePool(const size_class_vector_type& classes);
+
+        virtual ~_MessagePool();
+
+        // Returns a message whose body is sz bytes long, drawn from the calling thread's free list when possible.
+        std::unique_ptr<binary_message> Acquire(size_type sz = 0);
+
+        virtual bool TryRecycle(msg_type* const msgp) override;
+
+        // Frees every message cached by the calling thread on behalf of this pool.
+        void Trim();
+
+        // Frees every message cached on behalf of this pool, by every thread.
+        void Drain();
+
+        const size_class_vector_type& GetSizeClasses() const;
+
+        stats_type GetStats() const;
+    };
+
+    typedef _MessageSizeClass message_size_class;
+    typedef _MessagePoolStats message_pool_stats;
+    typedef _MessagePool message_pool;
+}
+
+#endif // NNGCPP_MESSAGE_POOL_H
@@ -0,0 +1,182 @@
+#include "message_queue.h"
+
+#include <algorithm>
+
+namespace nng {
+
+    _MessageQueueBase::slot_type::slot_type() : seq(0), msgp(nullptr) {
+    }
+
+    size_type __round_up_capacity(size_type capacity) {
+        size_type result = 2;
+        while (result < capacity) { result <<= 1; }
+        return result;
+    }
+
+    _MessageQueueBase::_MessageQueueBase(size_type capacity)
+        : _capacity(__round_up_capacity(capacity)), _mask(_capacity - 1), _slots(_capacity)
+        , _head(0), _tail(0), _waiters(0), _closed(false), _mutex(), _cv() {
+
+        for (size_type i = 0; i < _capacity; i++) {
+            _slots[i].seq.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    _MessageQueueBase::~_MessageQueueBase() {
+    }
+
+    msg_type* _MessageQueueBase::try_pop() {
+
+        // Only the consumer moves the head, so there is nobody to race.
+        const auto pos = _head.load(std::memory_order_relaxed);
+        auto& slot = _slots[pos & _mask];
+
+        if (slot.seq.load(std::memory_order_acquire) != pos + 1) { return nullptr; }
+
+        const auto msgp = slot.msgp;
+
+        slot.msgp = nullptr;
+        // Hands the slot back to the producers for the next time around.
+        slot.seq.store(pos + _capacity, std::memory_order_release);
+        _head.store(pos + 1, std::memory_order_relaxed);
+
+        return msgp;
+    }
+
+    void _MessageQueueBase::notify() {
+
+        // Orders the slot we just published against reading the waiter count.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        if (_waiters.load(std::memory_order_relaxed) == 0) { return; }
+
+        // Taking the mutex means the waiter is either yet to test its predicate, or is parked.
+        std::lock_guard<std::mutex> guard(_mutex);
+        _cv.notify_all();
+    }
+
+    void _MessageQueueBase::Clear() {
+        msg_type* msgp;
+        while ((msgp = try_pop()) != nullptr) {
+            ::nng_msg_free(msgp);
+        }
+        notify();
+    }
+
+    void _MessageQueueBase::Close() {
+        _closed = true;
+        {
+            std::lock_guard<std::mutex> guard(_mutex);
+            _cv.notify_all();
+        }
+    }
+
+    bool _MessageQueueBase::IsClosed() const {
+        return _closed;
+    }
+
+    size_type _MessageQueueBase::GetCapacity() const {
+        return _capacity;
+    }
+
+    size_type _MessageQueueBase::GetSize() const {
+        const auto head = _head.load(std::memory_order_acquire);
+        const auto tail = _tail.load(std::memory_order_acquire);
+        // The tail may run ahead of slots still being filled, but never by more than the capacity.
+        return tail > head ? std::min(tail - head, _capacity) : 0;
+    }
+
+    bool _MessageQueueBase::IsEmpty() const {
+        return GetSize() == 0;
+    }
+
+    bool _MessageQueueBase::TryPush(binary_message& m) {
+
+        if (_closed || !m.HasOne()) { return false; }
+
+        if (!try_push(m.get_message())) { return false; }
+
+        // The queue has it now, so the message lets go without freeing it.
+        m.cede_message();
+
+        notify();
+
+        return true;
+    }
+
+    error_code_type _MessageQueueBase::Push(binary_message& m, const duration_type& timeout) {
+
+        const auto msgp = m.get_message();
+
+        if (msgp == nullptr) { return ec_einval; }
+
+        // Predicates run under the mutex, so they must not notify, which takes it as well.
+        const auto ec = wait(timeout, [&]() { return !_closed && try_push(msgp); });
+
+        if (ec == ec_enone) {
+            m.cede_message();
+            notify();
+        }
+
+        return ec;
+    }
+
+    bool _MessageQueueBase::TryPop(binary_message& m) {
+
+        const auto msgp = try_pop();
+
+        if (msgp == nullptr) { return false; }
+
+        m.retain(msgp);
+
+        notify();
+
+        return true;
+    }
+
+    size_type _MessageQueueBase::pop_into(binary_message* const msgs, size_type count) {
+
+        size_type popped = 0;
+        msg_type* msgp;
+
+        while (popped < count && (msgp = try_pop()) != nullptr) {
+            msgs[popped++].retain(msgp);
+        }
+
+        return popped;
+    }
+
+    size_type _MessageQueueBase::TryPop(binary_message* const msgs, size_type count) {
+
+        const auto popped = pop_into(msgs, count);
+
+        // Producers waiting on room only need to hear about it once per batch.
+        if (popped) { notify(); }
+
+        return popped;
+    }
+
+    error_code_type _MessageQueueBase::Pop(binary_message& m, const duration_type& timeout) {
+
+        size_type popped = 0;
+
+        return Pop(&m, 1, popped, timeout);
+    }
+
+    error_code_type _MessageQueueBase::Pop(binary_message* const msgs, size_type count
+        , size_type& popped, const duration_type& timeout) {
+
+        popped = 0;
+
+        if (count == 0) { return ec_enone; }
+
+        auto ec = wait(timeout, [&]() { return (popped = pop_into(msgs, count)) > 0; });
+
+        // Closing still lets the consumer drain what is left.
+        if (ec == ec_eclosed) { ec = (popped = pop_into(msgs, count)) > 0 ? ec_enone : ec; }
+
+        if (popped) { notify(); }
+
+        return ec;
+    }
+}
@@ -0,0 +1,206 @@
+#ifndef NNGCPP_MESSAGE_QUEUE_H
+#define NNGCPP_MESSAGE_QUEUE_H
+
+#include "../core/types.h"
+#include "../core/enums.h"
+
+#include "binary_message.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+namespace nng {
+
+    /* Holds what the queues have in common, i.e. the ring of slots, and the waiting. Waiting
+    is futex style: producers and consumers spin a little, then register as waiters and park on
+    a condition variable. Whoever makes progress only takes the mutex to notify when somebody is
+    registered, so the uncontended path never touches it. */
+    class _MessageQueueBase {
+    public:
+
+        typedef std::chrono::steady_clock clock_type;
+
+    protected:
+
+        struct slot_type {
+
+            // Sequence number, in the manner of Vyukov's bounded queue, which says whose turn it is.
+            std::atomic<size_type> seq;
+
+            msg_type* msgp;
+
+            slot_type();
+        };
+
+        const size_type _capacity;
+
+        const size_type _mask;
+
+        std::vector<slot_type> _slots;
+
+        // Consumer and producer positions, each on its own cache line.
+        alignas(64) std::atomic<size_type> _head;
+
+        alignas(64) std::atomic<size_type> _tail;
+
+        alignas(64) std::atomic<size_type> _waiters;
+
+        std::atomic<bool> _closed;
+
+        std::mutex _mutex;
+
+        std::condition_variable _cv;
+
+        // Rounds the capacity up to a power of two, of at least two.
+        _MessageQueueBase(size_type capacity);
+
+        msg_type* try_pop();
+
+        // Retains up to count messages without notifying anybody.
+        size_type pop_into(binary_message* const msgs, size_type count);
+
+        virtual bool try_push(msg_type* const msgp) = 0;
+
+        void notify();
+
+        /* Negative timeouts wait forever. The predicate is tested with the mutex held, at least
+        some of the time, so it must not notify. */
+        template<class Predicate_>
+        error_code_type wait(const duration_type& timeout, const Predicate_& pred) {
+
+            // Most waits are short lived, and cheaper to spin out than to park.
+            for (auto i = 0; i < 64; i++) {
+                if (pred()) { return ec_enone; }
+                if (_closed) { return ec_eclosed; }
+            }
+
+            const auto deadline = clock_type::now() + timeout;
+
+            ++_waiters;
+
+            std::unique_lock<std::mutex> lock(_mutex);
+
+            auto ec = ec_enone;
+
+            while (!pred()) {
+                if (_closed) {
+                    ec = ec_eclosed;
+                    break;
+                }
+                if (timeout.count() < 0) {
+                    _cv.wait(lock);
+                }
+                else if (_cv.wait_until(lock, deadline) == std::cv_status::timeout && !pred()) {
+                    ec = ec_etimedout;
+                    break;
+                }
+            }
+
+            --_waiters;
+
+            return ec;
+        }
+
+    public:
+
+        virtual ~_MessageQueueBase();
+
+        // Frees the messages still queued, which is why there must no longer be any producers.
+        void Clear();
+
+        /* Wakes every waiter, and refuses any further pushes. Whatever is already queued may
+        still be popped. */
+        void Close();
+
+        bool IsClosed() const;
+
+        size_type GetCapacity() const;
+
+        // Only a snapshot while producers and the consumer are busy.
+        size_type GetSize() const;
+
+        bool IsEmpty() const;
+
+        // Takes ownership of the NNG message on success, otherwise leaves the message alone.
+        bool TryPush(binary_message& m);
+
+        // Waits for room, or until the timeout elapses, or until the queue is closed.
+        error_code_type Push(binary_message& m, const duration_type& timeout = duration_type(-1));
+
+        // Consumer only: hands the next NNG message to m, which frees whatever it had.
+        bool TryPop(binary_message& m);
+
+        // Consumer only: fills up to count messages, and returns how many.
+        size_type TryPop(binary_message* const msgs, size_type count);
+
+        // Consumer only: waits for at least one message.
+        error_code_type Pop(binary_message& m, const duration_type& timeout = duration_type(-1));
+
+        // Consumer only: waits for at least one message, then takes whatever else is ready.
+        error_code_type Pop(binary_message* const msgs, size_type count, size_type& popped
+            , const duration_type& timeout = duration_type(-1));
+    };
+
+    /* Bounded, lock free ring of NNG messages, for handing messages off between threads
+    without copying or wrapping them. Pushing cedes the message, and popping retains it, so
+    binary messages on either side may be reused. There is a single consumer, and either a
+    single producer, or any number of them. */
+    template<bool MultipleProducers_>
+    class _BasicMessageQueue : public _MessageQueueBase {
+    protected:
+
+        virtual bool try_push(msg_type* const msgp) override {
+
+            auto pos = _tail.load(std::memory_order_relaxed);
+
+            slot_type* slotp;
+
+            for (;;) {
+
+                slotp = &_slots[pos & _mask];
+
+                const auto seq = slotp->seq.load(std::memory_order_acquire);
+                const auto diff = static_cast<std::ptrdiff_t>(seq - pos);
+
+                // Still holding a message from the last time around, i.e. full.
+                if (diff < 0) { return false; }
+
+                if (diff > 0) {
+                    // Another producer got here first.
+                    pos = _tail.load(std::memory_order_relaxed);
+                    continue;
+                }
+
+                if (!MultipleProducers_) {
+                    _tail.store(pos + 1, std::memory_order_relaxed);
+                    break;
+                }
+
+                if (_tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) { break; }
+            }
+
+            slotp->msgp = msgp;
+            slotp->seq.store(pos + 1, std::memory_order_release);
+
+            return true;
+        }
+
+    public:
+
+        _BasicMessageQueue(size_type capacity) : _MessageQueueBase(capacity) {
+        }
+
+        virtual ~_BasicMessageQueue() {
+            Clear();
+        }
+    };
+
+    typedef _BasicMessageQueue<false> spsc_message_queue;
+    typedef _BasicMessageQueue<true> mpsc_message_queue;
+}
+
+#endif // NNGCPP_MESSAGE_QUEUE_H
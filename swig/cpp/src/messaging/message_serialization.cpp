@@ -0,0 +1,82 @@
+#include "message_serialization.h"
+#include "../core/exceptions.hpp"
+#include "../core/invocation.hpp"
+
+namespace nng {
+
+    namespace serialization {
+
+        void __throw_underflow() {
+            // The same as NNG trimming more than the body has.
+            THROW_NNG_EXCEPTION_EC(ec_einval);
+        }
+    }
+
+    msg_type* __get_message_or_throw(binary_message& m) {
+        const auto msgp = m.get_message();
+        if (msgp == nullptr) {
+            throw exceptions::invalid_operation("message has been ceded, or was never allocated");
+        }
+        return msgp;
+    }
+
+    _MessageWriter::_MessageWriter(binary_message& m)
+        : _m(m), _pos(::nng_msg_len(__get_message_or_throw(m))), _end(_pos) {
+    }
+
+    _MessageWriter::~_MessageWriter() {
+        // Ceded messages are no longer ours to chop.
+        if (_m.get_message() == nullptr) { return; }
+        try {
+            Finish();
+        }
+        catch (...) {
+            // Nothing may escape a destructor; the body is merely left longer than written.
+        }
+    }
+
+    uint8_t* _MessageWriter::Reserve(size_type sz) {
+
+        const auto msgp = __get_message_or_throw(_m);
+
+        // Realloc grows the body in place when it can, and keeps what is already there regardless.
+        if (_end - _pos < sz) {
+            invocation::with_default_error_handling(&::nng_msg_realloc, msgp, _pos + sz);
+            _end = _pos + sz;
+        }
+
+        return static_cast<uint8_t*>(::nng_msg_body(msgp)) + _pos;
+    }
+
+    void _MessageWriter::Finish() {
+        if (_end == _pos) { return; }
+        invocation::with_default_error_handling(&::nng_msg_chop, __get_message_or_throw(_m), _end - _pos);
+        _end = _pos;
+    }
+
+    size_type _MessageWriter::GetSize() const {
+        return _pos;
+    }
+
+    _MessageReader::_MessageReader(binary_message& m) : _m(m), _pos(0) {
+    }
+
+    _MessageReader::~_MessageReader() {
+    }
+
+    size_type _MessageReader::GetPosition() const {
+        return _pos;
+    }
+
+    size_type _MessageReader::GetRemaining() const {
+        const auto msgp = _m.get_message();
+        const auto sz = msgp ? ::nng_msg_len(msgp) : 0;
+        return sz > _pos ? sz - _pos : 0;
+    }
+
+    void _MessageReader::Consume() {
+        if (_pos == 0) { return; }
+        invocation::with_default_error_handling(&::nng_msg_trim, __get_message_or_throw(_m), _pos);
+        _pos = 0;
+    }
+}
@@ -0,0 +1,340 @@
+#ifndef NNGCPP_MESSAGE_SERIALIZATION_H
+#define NNGCPP_MESSAGE_SERIALIZATION_H
+
+#include "binary_message.h"
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+/* Describes the members of a struct, in order, for serialization, i.e. a struct containing
+NNGCPP_SERIALIZABLE(id, name, values) may then be written to and read from messages. */
+#define NNGCPP_SERIALIZABLE(...) \
+    template<class Visitor_> void nngcpp_visit_fields(Visitor_& nngcpp_visitor_) { nngcpp_visitor_(__VA_ARGS__); } \
+    template<class Visitor_> void nngcpp_visit_fields(Visitor_& nngcpp_visitor_) const { nngcpp_visitor_(__VA_ARGS__); }
+
+namespace nng {
+
+    namespace serialization {
+
+        struct __any_visitor {
+            template<typename... Args_>
+            void operator()(const Args_&...) const {}
+        };
+
+        template<typename... Args_>
+        struct __void_type { typedef void type; };
+
+        template<class T, class = void>
+        struct is_reflected : std::false_type {};
+
+        template<class T>
+        struct is_reflected<T, typename __void_type<decltype(
+            std::declval<const T&>().nngcpp_visit_fields(std::declval<__any_visitor&>()))>::type> : std::true_type {};
+
+        // Raised when a read runs off the end of the body.
+        void __throw_underflow();
+
+        /* Everything on the wire is big endian, i.e. network byte order, whatever the host is.
+        Floating point values travel as the integers sharing their bits. */
+        template<typename T, class = void>
+        struct __wire;
+
+        template<typename T>
+        struct __wire<T, typename std::enable_if<std::is_integral<T>::value && !std::is_same<T, bool>::value>::type> {
+            typedef typename std::make_unsigned<T>::type type;
+        };
+
+        template<>
+        struct __wire<bool> { typedef uint8_t type; };
+
+        template<>
+        struct __wire<float> { typedef uint32_t type; };
+
+        template<>
+        struct __wire<double> { typedef uint64_t type; };
+
+        template<typename T>
+        struct __wire<T, typename std::enable_if<std::is_enum<T>::value>::type>
+            : __wire<typename std::underlying_type<T>::type> {};
+
+        // Serializers say how big a value is, and write or read it at a cursor.
+        template<class T, class = void>
+        struct serializer;
+
+        template<typename T>
+        struct serializer<T, typename std::enable_if<std::is_arithmetic<T>::value || std::is_enum<T>::value>::type> {
+
+            typedef typename __wire<T>::type wire_type;
+
+            static_assert(sizeof(wire_type) == sizeof(T), "value must be the same size as its wire type");
+
+            static size_type size(const T&) { return sizeof(wire_type); }
+
+            static void write(uint8_t*& p, const T& x) {
+                wire_type w;
+                std::memcpy(&w, &x, sizeof(w));
+                for (auto i = sizeof(w); i-- > 0; w = static_cast<wire_type>(w >> 8)) {
+                    p[i] = static_cast<uint8_t>(w & 0xff);
+                }
+                p += sizeof(w);
+            }
+
+            static void read(const uint8_t*& p, const uint8_t* const end, T& x) {
+                if (static_cast<size_type>(end - p) < sizeof(wire_type)) { __throw_underflow(); }
+                wire_type w = 0;
+                for (size_type i = 0; i < sizeof(w); i++) {
+                    w = static_cast<wire_type>((w << 8) | p[i]);
+                }
+                std::memcpy(&x, &w, sizeof(w));
+                p += sizeof(w);
+            }
+        };
+
+        // Fixed arrays carry no length, since both ends know it already.
+        template<typename T, std::size_t N>
+        struct serializer<std::array<T, N>> {
+
+            static size_type size(const std::array<T, N>& x) {
+                size_type sz = 0;
+                for (const auto& y : x) { sz += serializer<T>::size(y); }
+                return sz;
+            }
+
+            static void write(uint8_t*& p, const std::array<T, N>& x) {
+                for (const auto& y : x) { serializer<T>::write(p, y); }
+            }
+
+            static void read(const uint8_t*& p, const uint8_t* const end, std::array<T, N>& x) {
+                for (auto& y : x) { serializer<T>::read(p, end, y); }
+            }
+        };
+
+        template<typename T, std::size_t N>
+        struct serializer<T[N]> {
+
+            static size_type size(const T(&x)[N]) {
+                size_type sz = 0;
+                for (const auto& y : x) { sz += serializer<T>::size(y); }
+                return sz;
+            }
+
+            static void write(uint8_t*& p, const T(&x)[N]) {
+                for (const auto& y : x) { serializer<T>::write(p, y); }
+            }
+
+            static void read(const uint8_t*& p, const uint8_t* const end, T(&x)[N]) {
+                for (auto& y : x) { serializer<T>::read(p, end, y); }
+            }
+        };
+
+        // Strings of bytes, whether text or not, carry a 32-bit length ahead of them.
+        template<class Bytes_>
+        struct __length_prefixed_serializer {
+
+            static size_type size(const Bytes_& x) { return sizeof(uint32_t) + x.size(); }
+
+            static void write(uint8_t*& p, const Bytes_& x) {
+                serializer<uint32_t>::write(p, static_cast<uint32_t>(x.size()));
+                if (x.empty()) { return; }
+                std::memcpy(p, x.data(), x.size());
+                p += x.size();
+            }
+
+            static void read(const uint8_t*& p, const uint8_t* const end, Bytes_& x) {
+                uint32_t sz = 0;
+                serializer<uint32_t>::read(p, end, sz);
+                if (static_cast<size_type>(end - p) < sz) { __throw_underflow(); }
+                x.assign(p, p + sz);
+                p += sz;
+            }
+        };
+
+        template<>
+        struct serializer<std::string> : __length_prefixed_serializer<std::string> {};
+
+        template<>
+        struct serializer<buffer_vector_type> : __length_prefixed_serializer<buffer_vector_type> {};
+
+        struct __size_visitor {
+            size_type sz;
+            void operator()() {}
+            template<typename Arg_, typename... Args_>
+            void operator()(const Arg_& arg, const Args_&... args) {
+                sz += serializer<Arg_>::size(arg);
+                (*this)(args...);
+            }
+        };
+
+        struct __write_visitor {
+            uint8_t*& p;
+            void operator()() {}
+            template<typename Arg_, typename... Args_>
+            void operator()(const Arg_& arg, const Args_&... args) {
+                serializer<Arg_>::write(p, arg);
+                (*this)(args...);
+            }
+        };
+
+        struct __read_visitor {
+            const uint8_t*& p;
+            const uint8_t* const end;
+            void operator()() {}
+            template<typename Arg_, typename... Args_>
+            void operator()(Arg_& arg, Args_&... args) {
+                serializer<Arg_>::read(p, end, arg);
+                (*this)(args...);
+            }
+        };
+
+        // Structs are their members one after the other, with nothing in between.
+        template<class T>
+        struct serializer<T, typename std::enable_if<is_reflected<T>::value>::type> {
+
+            static size_type size(const T& x) {
+                __size_visitor v = { 0 };
+                x.nngcpp_visit_fields(v);
+                return v.sz;
+            }
+
+            static void write(uint8_t*& p, const T& x) {
+                __write_visitor v = { p };
+                x.nngcpp_visit_fields(v);
+            }
+
+            static void read(const uint8_t*& p, const uint8_t* const end, T& x) {
+                __read_visitor v = { p, end };
+                x.nngcpp_visit_fields(v);
+            }
+        };
+
+        // What binary messages themselves accept, leaving strings and buffers to the existing operators.
+        template<class T>
+        struct is_message_serializable : std::integral_constant<bool
+            , std::is_arithmetic<T>::value || std::is_enum<T>::value || is_reflected<T>::value> {};
+
+        template<typename T, std::size_t N>
+        struct is_message_serializable<std::array<T, N>> : std::true_type {};
+    }
+
+    // Throws invalid_operation when the message has been ceded, or was never allocated.
+    msg_type* __get_message_or_throw(binary_message& m);
+
+    /* Writes values onto the end of the message body, straight into the NNG message. Each Write
+    grows the message once for all of its values, and Reserve may be used to grow it once ahead
+    of several writes. Room reserved but not written is given back by Finish, or on destruction. */
+    class _MessageWriter {
+    private:
+
+        binary_message& _m;
+
+        // Body offsets of the next byte to write, and of the end of the reservation.
+        size_type _pos;
+
+        size_type _end;
+
+    public:
+
+        _MessageWriter(binary_message& m);
+
+        _MessageWriter(const _MessageWriter&) = delete;
+
+        _MessageWriter& operator=(const _MessageWriter&) = delete;
+
+        virtual ~_MessageWriter();
+
+        // Makes room for at least sz more bytes, and returns where they go, until the next Reserve.
+        uint8_t* Reserve(size_type sz);
+
+        void Finish();
+
+        // Returns how many bytes have been written.
+        size_type GetSize() const;
+
+        template<typename... Args_>
+        _MessageWriter& Write(const Args_&... args) {
+            serialization::__size_visitor sizer = { 0 };
+            sizer(args...);
+            auto* p = Reserve(sizer.sz);
+            serialization::__write_visitor writer = { p };
+            writer(args...);
+            _pos += sizer.sz;
+            return *this;
+        }
+
+        template<typename T>
+        _MessageWriter& operator<<(const T& x) {
+            return Write(x);
+        }
+    };
+
+    /* Reads values from the message body in place, starting at the front. Nothing is removed
+    from the body until Consume, so a failed read may be retried from the same position. */
+    class _MessageReader {
+    private:
+
+        binary_message& _m;
+
+        size_type _pos;
+
+    public:
+
+        _MessageReader(binary_message& m);
+
+        _MessageReader(const _MessageReader&) = delete;
+
+        _MessageReader& operator=(const _MessageReader&) = delete;
+
+        virtual ~_MessageReader();
+
+        size_type GetPosition() const;
+
+        size_type GetRemaining() const;
+
+        // Trims what has been read from the front of the body.
+        void Consume();
+
+        /* Throws nng_exception with ec_einval when the body runs short, leaving the position where it
+        was, or invalid_operation when there is no message to read. */
+        template<typename... Args_>
+        _MessageReader& Read(Args_&... args) {
+            const auto msgp = __get_message_or_throw(_m);
+            const auto* const begin = static_cast<const uint8_t*>(::nng_msg_body(msgp));
+            const auto* p = begin + _pos;
+            serialization::__read_visitor reader = { p, begin + ::nng_msg_len(msgp) };
+            reader(args...);
+            _pos = static_cast<size_type>(p - begin);
+            return *this;
+        }
+
+        template<typename T>
+        _MessageReader& operator>>(T& x) {
+            return Read(x);
+        }
+    };
+
+    typedef _MessageWriter message_writer;
+    typedef _MessageReader message_reader;
+
+    // Appends the value to the body in network byte order.
+    template<typename T>
+    typename std::enable_if<serialization::is_message_serializable<T>::value, binary_message&>::type
+        operator<<(binary_message& lhs, const T& rhs) {
+        _MessageWriter(lhs).Write(rhs);
+        return lhs;
+    }
+
+    // Takes the value from the front of the body.
+    template<typename T>
+    typename std::enable_if<serialization::is_message_serializable<T>::value, binary_message&>::type
+        operator>>(binary_message& lhs, T& rhs) {
+        _MessageReader reader(lhs);
+        reader.Read(rhs).Consume();
+        return lhs;
+    }
+}
+
+#endif // NNGCPP_MESSAGE_SERIALIZATION_H
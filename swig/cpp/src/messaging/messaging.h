@@ -3,6 +3,11 @@
 
 // TODO: TBD: may not necessarily need/want ALL of these includes
 #include "binary_message.h"
+#include "allocated_buffer.h"
+#include "buffer_segment.h"
+#include "message_pool.h"
+#include "message_queue.h"
+#include "message_serialization.h"
 #include "message_pipe.h"
 #include "messaging_gymnastics.h"
 #include "messaging_utils.h"
@@ -2,6 +2,7 @@
 #define NNGCPP_MESSAGING_API_HPP
 
 #include "message_base.h"
+#include "buffer_view.h"
 
 namespace nng {
 
@@ -25,6 +26,12 @@ namespace nng {
         }
     };
 
+    template<typename View_>
+    struct ICanView {
+        // Returns a non-owning view which is valid until the message is next mutated.
+        virtual View_ GetView() const = 0;
+    };
+
     template<typename Result_, typename Intermediate_>
     struct message_getter_try_get_policy {
 
@@ -19,7 +19,7 @@ namespace nng {
 
     binary_message& operator >> (binary_message& lhs, buffer_vector_type& rhs) {
         auto ops = message_conversion_getter_policy<buffer_vector_type, binary_message>();
-        rhs = ops.Get(lhs);
+        ops.Get(lhs, rhs);
         return lhs;
     }
 
@@ -31,7 +31,7 @@ namespace nng {
 
     binary_message& operator >> (binary_message& lhs, std::string& rhs) {
         auto ops = message_conversion_getter_policy<std::string, binary_message>();
-        rhs = ops.Get(lhs);
+        ops.Get(lhs, rhs);
         return lhs;
     }
 
@@ -17,6 +17,8 @@
 
 #include <string>
 #include <algorithm>
+#include <cstring>
+#include <type_traits>
 
 namespace nng {
 
@@ -61,17 +63,48 @@ namespace nng {
         }
     };
 
+    template<class Src_, class Dest_>
+    struct __is_bulk_convertible : std::integral_constant<bool
+        , sizeof(typename Src_::value_type) == 1 && sizeof(typename Dest_::value_type) == 1
+            && std::is_integral<typename Src_::value_type>::value
+            && std::is_integral<typename Dest_::value_type>::value> {};
+
+    template<class Src_, class Dest_>
+    void __gymnastic_copy(const Src_& src, Dest_& dest, std::true_type) {
+        // Bytes on either side, so one bulk copy does it.
+        std::memcpy(&dest[0], src.data(), src.size());
+    }
+
+    template<class Src_, class Dest_>
+    void __gymnastic_copy(const Src_& src, Dest_& dest, std::false_type) {
+        std::transform(src.cbegin(), src.cend(), dest.begin()
+            , [](const typename Src_::value_type& x) { return static_cast<typename Dest_::value_type>(x); });
+    }
+
+    // Converts into an existing destination, which keeps whatever capacity it already has.
+    template<class Src_, class Dest_, class Value_>
+    void gymanstic_convert(const Src_& src, Dest_& dest) {
+        dest.resize(src.size());
+        if (src.empty()) { return; }
+        __gymnastic_copy(src, dest, __is_bulk_convertible<Src_, Dest_>());
+    }
+
     template<class Src_, class Dest_, class Value_>
     Dest_ gymanstic_convert(const Src_& src) {
         Dest_ dest;
-        for (Src_::const_iterator it = src.cbegin(); it != src.cend(); ++it) {
-            dest.push_back((Src_::value_type)*it);
-        }
-        //const auto push_back = [&](const Value_& x) { dest.push_back(x); };
-        //std::for_each(src.cbegin(), src.cend(), push_back);
+        gymanstic_convert<Src_, Dest_, Value_>(src, dest);
         return dest;
     }
 
+    // Copies the bytes in view, which usually point into an NNG message, in one go.
+    inline void __assign_view(std::string& s, const buffer_view& view) {
+        s.assign(reinterpret_cast<const std::string::value_type*>(view.data()), view.GetSize());
+    }
+
+    inline void __assign_view(buffer_vector_type& buf, const buffer_view& view) {
+        buf.assign(view.begin(), view.end());
+    }
+
     template<>
     struct message_conversion_getter_policy<std::string, ICanGet<buffer_vector_type>> {
 
@@ -93,35 +126,36 @@ namespace nng {
     template<class Body_, class Header_>
     struct message_conversion_getter_policy<std::string, _BasicMessage<Body_, Header_>> {
 
-        virtual std::string Get(binary_message& rhs) {
-            const auto lhs_ = const_cast<binary_message&>(rhs)->GetBody()->Get();
-            return gymanstic_convert<buffer_vector_type, std::string, std::string::value_type>(lhs_);
+        virtual std::string Get(_BasicMessage<Body_, Header_>& rhs) {
+            std::string s;
+            __assign_view(s, rhs.GetBody()->GetView());
+            return s;
         }
     };
 
     template<class Body_, class Header_>
     struct message_conversion_appender_policy<std::string, _BasicMessage<Body_, Header_>> {
 
-        virtual void Append(binary_message& lhs, const std::string& rhs) {
-            const auto buf_ = gymanstic_convert<std::string, buffer_vector_type, buffer_vector_type::value_type>(rhs);
-            lhs->GetBody()->Append(buf_);
+        virtual void Append(_BasicMessage<Body_, Header_>& lhs, const std::string& rhs) {
+            lhs.GetBody()->Append(rhs);
         }
     };
 
     template<class Body_, class Header_>
     struct message_conversion_getter_policy<buffer_vector_type, _BasicMessage<Body_, Header_>> {
 
-        virtual buffer_vector_type Get(binary_message& rhs) {
-            return const_cast<binary_message&>(rhs)->GetBody()->Get();
+        virtual buffer_vector_type Get(_BasicMessage<Body_, Header_>& rhs) {
+            buffer_vector_type buf;
+            __assign_view(buf, rhs.GetBody()->GetView());
+            return buf;
         }
     };
 
     template<class Body_, class Header_>
     struct message_conversion_appender_policy<buffer_vector_type, _BasicMessage<Body_, Header_>> {
 
-        virtual void Append(binary_message& lhs, const buffer_vector_type& rhs) {
-            auto buf_ = gymanstic_convert<buffer_vector_type, buffer_vector_type, buffer_vector_type::value_type>(rhs);
-            lhs->GetBody()->Append(buf_);
+        virtual void Append(_BasicMessage<Body_, Header_>& lhs, const buffer_vector_type& rhs) {
+            lhs.GetBody()->Append(rhs);
         }
     };
 
@@ -129,8 +163,13 @@ namespace nng {
     struct message_conversion_getter_policy<std::string, binary_message> {
 
         virtual std::string Get(binary_message& rhs) {
-            const auto lhs_ = const_cast<binary_message&>(rhs).GetBody()->Get();
-            return gymanstic_convert<buffer_vector_type, std::string, std::string::value_type>(lhs_);
+            std::string s;
+            Get(rhs, s);
+            return s;
+        }
+
+        virtual void Get(binary_message& rhs, std::string& s) {
+            __assign_view(s, rhs.GetBody()->GetView());
         }
     };
 
@@ -138,8 +177,8 @@ namespace nng {
     struct message_conversion_appender_policy<std::string, binary_message> {
 
         virtual void Append(binary_message& lhs, const std::string& rhs) {
-            const auto buf_ = gymanstic_convert<std::string, buffer_vector_type, buffer_vector_type::value_type>(rhs);
-            lhs.GetBody()->Append(buf_);
+            // Appends straight into the NNG message, without an intermediate buffer.
+            lhs.GetBody()->Append(rhs);
         }
     };
 
@@ -147,7 +186,13 @@ namespace nng {
     struct message_conversion_getter_policy<buffer_vector_type, binary_message> {
 
         virtual buffer_vector_type Get(binary_message& rhs) {
-            return const_cast<binary_message&>(rhs).GetBody()->Get();
+            buffer_vector_type buf;
+            Get(rhs, buf);
+            return buf;
+        }
+
+        virtual void Get(binary_message& rhs, buffer_vector_type& buf) {
+            __assign_view(buf, rhs.GetBody()->GetView());
         }
     };
 
@@ -155,8 +200,7 @@ namespace nng {
     struct message_conversion_appender_policy<buffer_vector_type, binary_message> {
 
         virtual void Append(binary_message& lhs, const buffer_vector_type& rhs) {
-            auto buf_ = gymanstic_convert<buffer_vector_type, buffer_vector_type, buffer_vector_type::value_type>(rhs);
-            lhs.GetBody()->Append(buf_);
+            lhs.GetBody()->Append(rhs);
         }
     };
 
@@ -1,5 +1,8 @@
 #include "messaging_utils.h"
 
+#include <algorithm>
+#include <cstring>
+
 namespace nng {
     //namespace messaging {
 
@@ -9,15 +12,24 @@ namespace nng {
         messaging_utils::~messaging_utils() {
         }
 
+        template<class Dest_>
+        void __copy_to_dest(Dest_* const dp, const void* const srcp, size_type sz) {
+            // Both sides are contiguous bytes, so size once and copy in bulk.
+            dp->resize(sz);
+            if (sz) { std::memcpy(&(*dp)[0], srcp, sz); }
+        }
+
+        template<class Src_, class Dest_>
+        void __to_dest(Dest_* const dp, const Src_* const sp, size_type sz) {
+            // TODO: TBD: may need/want to account for unicode wide-characters.
+            const auto n = sp == nullptr ? 0 : std::min(sz, static_cast<size_type>(sp->size()));
+            __copy_to_dest(dp, n ? sp->data() : nullptr, n);
+        }
+
         template<class Src_, class Dest_>
         Dest_ __to_dest(const Src_* const sp, size_type sz) {
             Dest_ d;
-            typedef Dest_::value_type dest_value_type;
-            // TODO: TBD: may need/want to account for unicode wide-characters.
-            for (auto it = sp->cbegin(); ((size_type)(it - sp->cbegin())) < sz
-                && it != sp->cend(); it++) {
-                d.push_back((dest_value_type)*it);
-            }
+            __to_dest(&d, sp, sz);
             return d;
         }
 
@@ -30,13 +42,14 @@ namespace nng {
         }
 
         buffer_vector_type messaging_utils::to_buffer(const std::string::value_type* cp) {
-            const std::string s(cp);
-            return to_buffer(&s, s.length());
+            return cp == nullptr ? buffer_vector_type() : to_buffer(cp, std::strlen(cp));
         }
 
         buffer_vector_type messaging_utils::to_buffer(const std::string::value_type* cp, size_type sz) {
-            const std::string s(cp);
-            return to_buffer(&s, sz);
+            buffer_vector_type buf;
+            // No more than the string itself, without making a copy of it first.
+            if (cp != nullptr) { __copy_to_dest(&buf, cp, std::min(sz, static_cast<size_type>(std::strlen(cp)))); }
+            return buf;
         }
 
         buffer_vector_type messaging_utils::to_buffer(const std::string* const sp) {
@@ -46,5 +59,15 @@ namespace nng {
         buffer_vector_type messaging_utils::to_buffer(const std::string* const sp, size_type sz) {
             return __to_dest<std::string, buffer_vector_type>(sp, sz);
         }
+
+        void messaging_utils::to_string(std::string* const resultp, const buffer_vector_type* const bufp, size_type sz) {
+            if (resultp == nullptr) { return; }
+            __to_dest(resultp, bufp, sz);
+        }
+
+        void messaging_utils::to_buffer(buffer_vector_type* const resultp, const std::string* const sp, size_type sz) {
+            if (resultp == nullptr) { return; }
+            __to_dest(resultp, sp, sz);
+        }
     //}
 }
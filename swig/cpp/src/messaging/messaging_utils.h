@@ -29,6 +29,10 @@ namespace nng {
 
             static buffer_vector_type to_buffer(const std::string* const sp);
             static buffer_vector_type to_buffer(const std::string* const sp, size_type sz);
+
+            // Copy into an existing result, reusing whatever capacity it already has.
+            static void to_string(std::string* const resultp, const buffer_vector_type* const bufp, size_type sz);
+            static void to_buffer(buffer_vector_type* const resultp, const std::string* const sp, size_type sz);
         };
     //}
 }
@@ -0,0 +1,79 @@
+#include "cache.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace nng {
+
+    _OptionCache::_OptionCache() : _mutex(), _entries() {
+    }
+
+    _OptionCache::_OptionCache(const _OptionCache& other) : _mutex(), _entries() {
+        std::lock_guard<std::mutex> guard(other._mutex);
+        _entries = other._entries;
+    }
+
+    _OptionCache& _OptionCache::operator=(const _OptionCache& other) {
+
+        if (this == &other) { return *this; }
+
+        std::vector<entry_type> entries;
+
+        {
+            std::lock_guard<std::mutex> guard(other._mutex);
+            entries = other._entries;
+        }
+
+        std::lock_guard<std::mutex> guard(_mutex);
+        _entries.swap(entries);
+
+        return *this;
+    }
+
+    _OptionCache::~_OptionCache() {
+    }
+
+    std::shared_ptr<const void> _OptionCache::find(const char* const name) const {
+
+        std::lock_guard<std::mutex> guard(_mutex);
+
+        for (const auto& x : _entries) {
+            if (x.name == name) { return x.valp; }
+        }
+
+        return nullptr;
+    }
+
+    void _OptionCache::store(const char* const name, const std::shared_ptr<const void>& valp) {
+
+        std::lock_guard<std::mutex> guard(_mutex);
+
+        for (auto& x : _entries) {
+            if (x.name == name) {
+                x.valp = valp;
+                return;
+            }
+        }
+
+        _entries.push_back({ name, valp });
+    }
+
+    void _OptionCache::Invalidate(const char* const name) {
+
+        std::lock_guard<std::mutex> guard(_mutex);
+
+        _entries.erase(std::remove_if(_entries.begin(), _entries.end(), [name](const entry_type& x) {
+            return x.name == name || std::strcmp(x.name, name) == 0;
+        }), _entries.end());
+    }
+
+    void _OptionCache::Clear() {
+        std::lock_guard<std::mutex> guard(_mutex);
+        _entries.clear();
+    }
+
+    size_type _OptionCache::GetCount() const {
+        std::lock_guard<std::mutex> guard(_mutex);
+        return _entries.size();
+    }
+}
@@ -0,0 +1,66 @@
+#ifndef NNGCPP_OPTIONS_CACHE_H
+#define NNGCPP_OPTIONS_CACHE_H
+
+#include "../core/types.h"
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace nng {
+
+    /* Snapshots of read-mostly option values, keyed by the NNG option name. Lookups compare the
+    name pointers, which is all typed descriptors ever hand us, whereas invalidation compares the
+    names themselves, so that string keyed setters may invalidate as well. There are only ever a
+    handful of entries, so a vector beats any sort of map. */
+    class _OptionCache {
+    private:
+
+        struct entry_type {
+
+            const char* name;
+
+            std::shared_ptr<const void> valp;
+        };
+
+        mutable std::mutex _mutex;
+
+        std::vector<entry_type> _entries;
+
+        // Returns nullptr when there is no snapshot, which is the caller's cue to read NNG.
+        std::shared_ptr<const void> find(const char* const name) const;
+
+        void store(const char* const name, const std::shared_ptr<const void>& valp);
+
+    public:
+
+        _OptionCache();
+
+        // Copies share the snapshots, which are immutable, but not the mutex.
+        _OptionCache(const _OptionCache& other);
+
+        _OptionCache& operator=(const _OptionCache& other);
+
+        virtual ~_OptionCache();
+
+        template<typename T>
+        std::shared_ptr<const T> Find(const char* const name) const {
+            return std::static_pointer_cast<const T>(find(name));
+        }
+
+        template<typename T>
+        void Store(const char* const name, const T& x) {
+            store(name, std::make_shared<const T>(x));
+        }
+
+        void Invalidate(const char* const name);
+
+        void Clear();
+
+        size_type GetCount() const;
+    };
+
+    typedef _OptionCache option_cache;
+}
+
+#endif // NNGCPP_OPTIONS_CACHE_H
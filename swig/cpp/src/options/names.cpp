@@ -32,4 +32,31 @@ namespace nng {
     const string O::sub_subscribe = NNG_OPT_SUB_SUBSCRIBE;
     const string O::sub_unsubscribe = NNG_OPT_SUB_UNSUBSCRIBE;
     const string O::surveyor_survey_duration = NNG_OPT_SURVEYOR_SURVEYTIME;
+
+    using K = _OptionKeys;
+
+    const char* const K::socket_name::value = NNG_OPT_SOCKNAME;
+    const char* const K::compat_domain::value = NNG_OPT_DOMAIN;
+    const char* const K::raw::value = NNG_OPT_RAW;
+    const char* const K::linger_duration::value = NNG_OPT_LINGER;
+    const char* const K::recv_buf::value = NNG_OPT_RECVBUF;
+    const char* const K::send_buf::value = NNG_OPT_SENDBUF;
+    const char* const K::recv_fd::value = NNG_OPT_RECVFD;
+    const char* const K::send_fd::value = NNG_OPT_SENDFD;
+    const char* const K::recv_timeout_duration::value = NNG_OPT_RECVTIMEO;
+    const char* const K::send_timeout_duration::value = NNG_OPT_SENDTIMEO;
+    const char* const K::local_addr::value = NNG_OPT_LOCADDR;
+    const char* const K::remote_addr::value = NNG_OPT_REMADDR;
+    const char* const K::url::value = NNG_OPT_URL;
+    const char* const K::max_ttl::value = NNG_OPT_MAXTTL;
+    const char* const K::protocol::value = NNG_OPT_PROTOCOL;
+    const char* const K::transport::value = NNG_OPT_TRANSPORT;
+    const char* const K::max_recv_sz::value = NNG_OPT_RECVMAXSZ;
+    const char* const K::min_reconnect_duration::value = NNG_OPT_RECONNMINT;
+    const char* const K::max_reconnect_duration::value = NNG_OPT_RECONNMAXT;
+    const char* const K::pair1_polyamorous::value = NNG_OPT_PAIR1_POLY;
+    const char* const K::sub_subscribe::value = NNG_OPT_SUB_SUBSCRIBE;
+    const char* const K::sub_unsubscribe::value = NNG_OPT_SUB_UNSUBSCRIBE;
+    const char* const K::req_resend_duration::value = NNG_OPT_REQ_RESENDTIME;
+    const char* const K::surveyor_survey_duration::value = NNG_OPT_SURVEYOR_SURVEYTIME;
 }
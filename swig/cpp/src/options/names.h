@@ -1,10 +1,16 @@
 #ifndef NNGCPP_OPTIONS_NAMES_H
 #define NNGCPP_OPTIONS_NAMES_H
 
+#include "../core/types.h"
+
 #include <string>
 
 namespace nng {
 
+#ifndef NNGCPP_ADDRESS_H
+    class _SockAddr;
+#endif // NNGCPP_ADDRESS_H
+
     struct _OptionNames {
     private:
 
@@ -40,6 +46,94 @@ namespace nng {
     };
 
     typedef _OptionNames option_names;
+
+    /* Compile time option keys, each carrying the NNG literal itself, so that typed access never
+    goes through a std::string on its way to NNG. */
+    struct _OptionKeys {
+    private:
+
+        _OptionKeys();
+
+    public:
+
+        struct socket_name { static const char* const value; };
+        struct compat_domain { static const char* const value; };
+        struct raw { static const char* const value; };
+        struct linger_duration { static const char* const value; };
+        struct recv_buf { static const char* const value; };
+        struct send_buf { static const char* const value; };
+        struct recv_fd { static const char* const value; };
+        struct send_fd { static const char* const value; };
+        struct recv_timeout_duration { static const char* const value; };
+        struct send_timeout_duration { static const char* const value; };
+        struct local_addr { static const char* const value; };
+        struct remote_addr { static const char* const value; };
+        struct url { static const char* const value; };
+        struct max_ttl { static const char* const value; };
+        struct protocol { static const char* const value; };
+        struct transport { static const char* const value; };
+        struct max_recv_sz { static const char* const value; };
+        struct min_reconnect_duration { static const char* const value; };
+        struct max_reconnect_duration { static const char* const value; };
+        struct pair1_polyamorous { static const char* const value; };
+        struct sub_subscribe { static const char* const value; };
+        struct sub_unsubscribe { static const char* const value; };
+        struct req_resend_duration { static const char* const value; };
+        struct surveyor_survey_duration { static const char* const value; };
+    };
+
+    typedef _OptionKeys option_keys;
+
+    /* Describes an option by its key and value type, i.e. opt<option_keys::recv_timeout_duration,
+    duration_type>. Cached options are the read-mostly ones, which readers snapshot on first read;
+    setting them through the same options invalidates the snapshot. */
+    template<class Key_, typename T, bool Cached_ = false>
+    struct opt {
+
+        typedef Key_ key_type;
+        typedef T value_type;
+
+        static const bool cached = Cached_;
+
+        static const char* name() { return Key_::value; }
+    };
+
+    struct _OptionDescriptors {
+    private:
+
+        typedef _OptionKeys K;
+
+        _OptionDescriptors();
+
+    public:
+
+        typedef opt<K::socket_name, std::string> socket_name;
+        typedef opt<K::compat_domain, int32_t> compat_domain;
+        typedef opt<K::raw, int32_t> raw;
+        typedef opt<K::linger_duration, duration_type> linger_duration;
+        typedef opt<K::recv_buf, int32_t> recv_buf;
+        typedef opt<K::send_buf, int32_t> send_buf;
+        typedef opt<K::recv_fd, int32_t> recv_fd;
+        typedef opt<K::send_fd, int32_t> send_fd;
+        typedef opt<K::recv_timeout_duration, duration_type> recv_timeout_duration;
+        typedef opt<K::send_timeout_duration, duration_type> send_timeout_duration;
+        typedef opt<K::local_addr, _SockAddr, true> local_addr;
+        typedef opt<K::remote_addr, _SockAddr, true> remote_addr;
+        typedef opt<K::url, std::string, true> url;
+        typedef opt<K::max_ttl, int32_t> max_ttl;
+        typedef opt<K::protocol, int32_t, true> protocol;
+        typedef opt<K::transport, int32_t, true> transport;
+        typedef opt<K::max_recv_sz, size_type> max_recv_sz;
+        typedef opt<K::min_reconnect_duration, duration_type> min_reconnect_duration;
+        typedef opt<K::max_reconnect_duration, duration_type> max_reconnect_duration;
+        typedef opt<K::pair1_polyamorous, int32_t> pair1_polyamorous;
+        typedef opt<K::sub_subscribe, std::string> sub_subscribe;
+        typedef opt<K::sub_unsubscribe, std::string> sub_unsubscribe;
+        typedef opt<K::req_resend_duration, duration_type> req_resend_duration;
+        typedef opt<K::surveyor_survey_duration, duration_type> surveyor_survey_duration;
+    };
+
+    typedef _OptionDescriptors option_descriptors;
 }
 
 #endif // NNGCPP_OPTIONS_NAMES_H
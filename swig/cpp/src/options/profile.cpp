@@ -0,0 +1,125 @@
+#include "profile.h"
+#include "../core/exceptions.hpp"
+
+namespace nng {
+
+    namespace {
+
+        // The same bounds NNG itself enforces.
+        const int32_t buf_max = 8192;
+
+        const int32_t ttl_min = 1;
+
+        const int32_t ttl_max = 255;
+
+        // Negative one is infinite; anything below that NNG refuses.
+        bool is_valid_duration(const duration_type& x) {
+            return x.count() >= -1;
+        }
+    }
+
+    _OptionProfile::_OptionProfile()
+        : fields(profile_none)
+        , socket_name()
+        , linger_duration(0)
+        , recv_buf(0)
+        , send_buf(0)
+        , recv_timeout_duration(0)
+        , send_timeout_duration(0)
+        , max_ttl(0)
+        , max_recv_sz(0)
+        , min_reconnect_duration(0)
+        , max_reconnect_duration(0) {
+    }
+
+    bool _OptionProfile::Has(option_profile_field_type field) const {
+        return (fields & field) == field;
+    }
+
+    _OptionProfile& _OptionProfile::SetSocketName(const std::string& value) {
+        socket_name = value;
+        fields |= profile_socket_name;
+        return *this;
+    }
+
+    _OptionProfile& _OptionProfile::SetLingerDuration(const duration_type& value) {
+        linger_duration = value;
+        fields |= profile_linger_duration;
+        return *this;
+    }
+
+    _OptionProfile& _OptionProfile::SetRecvBuf(int32_t value) {
+        recv_buf = value;
+        fields |= profile_recv_buf;
+        return *this;
+    }
+
+    _OptionProfile& _OptionProfile::SetSendBuf(int32_t value) {
+        send_buf = value;
+        fields |= profile_send_buf;
+        return *this;
+    }
+
+    _OptionProfile& _OptionProfile::SetRecvTimeoutDuration(const duration_type& value) {
+        recv_timeout_duration = value;
+        fields |= profile_recv_timeout_duration;
+        return *this;
+    }
+
+    _OptionProfile& _OptionProfile::SetSendTimeoutDuration(const duration_type& value) {
+        send_timeout_duration = value;
+        fields |= profile_send_timeout_duration;
+        return *this;
+    }
+
+    _OptionProfile& _OptionProfile::SetMaxTtl(int32_t value) {
+        max_ttl = value;
+        fields |= profile_max_ttl;
+        return *this;
+    }
+
+    _OptionProfile& _OptionProfile::SetMaxRecvSize(size_type value) {
+        max_recv_sz = value;
+        fields |= profile_max_recv_sz;
+        return *this;
+    }
+
+    _OptionProfile& _OptionProfile::SetMinReconnectDuration(const duration_type& value) {
+        min_reconnect_duration = value;
+        fields |= profile_min_reconnect_duration;
+        return *this;
+    }
+
+    _OptionProfile& _OptionProfile::SetMaxReconnectDuration(const duration_type& value) {
+        max_reconnect_duration = value;
+        fields |= profile_max_reconnect_duration;
+        return *this;
+    }
+
+    void _OptionProfile::Validate(uint32_t applicable) const {
+
+        if (fields & ~applicable) { THROW_NNG_EXCEPTION_EC(ec_enotsup); }
+
+        const auto is_valid_buf = [](int32_t x) { return x >= 0 && x <= buf_max; };
+
+        if ((Has(profile_recv_buf) && !is_valid_buf(recv_buf))
+            || (Has(profile_send_buf) && !is_valid_buf(send_buf))
+            || (Has(profile_max_ttl) && (max_ttl < ttl_min || max_ttl > ttl_max))
+            || (Has(profile_linger_duration) && !is_valid_duration(linger_duration))
+            || (Has(profile_recv_timeout_duration) && !is_valid_duration(recv_timeout_duration))
+            || (Has(profile_send_timeout_duration) && !is_valid_duration(send_timeout_duration))
+            || (Has(profile_min_reconnect_duration) && !is_valid_duration(min_reconnect_duration))
+            || (Has(profile_max_reconnect_duration) && !is_valid_duration(max_reconnect_duration))) {
+
+            THROW_NNG_EXCEPTION_EC(ec_einval);
+        }
+
+        // Zero is no maximum at all, otherwise the range must make sense.
+        if (Has(static_cast<option_profile_field_type>(profile_min_reconnect_duration | profile_max_reconnect_duration))
+            && max_reconnect_duration.count() > 0
+            && min_reconnect_duration > max_reconnect_duration) {
+
+            THROW_NNG_EXCEPTION_EC(ec_einval);
+        }
+    }
+}
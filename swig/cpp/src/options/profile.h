@@ -0,0 +1,91 @@
+#ifndef NNGCPP_OPTIONS_PROFILE_H
+#define NNGCPP_OPTIONS_PROFILE_H
+
+#include "../core/types.h"
+
+#include <string>
+
+namespace nng {
+
+    // Which of the profile's options are present; also which ones apply to which objects.
+    enum option_profile_field_type : uint32_t {
+        profile_none = 0,
+        profile_socket_name = 1 << 0,
+        profile_linger_duration = 1 << 1,
+        profile_recv_buf = 1 << 2,
+        profile_send_buf = 1 << 3,
+        profile_recv_timeout_duration = 1 << 4,
+        profile_send_timeout_duration = 1 << 5,
+        profile_max_ttl = 1 << 6,
+        profile_max_recv_sz = 1 << 7,
+        profile_min_reconnect_duration = 1 << 8,
+        profile_max_reconnect_duration = 1 << 9,
+
+        // Options every socket supports, whatever its protocol.
+        profile_socket_fields = profile_socket_name | profile_linger_duration
+            | profile_recv_buf | profile_send_buf
+            | profile_recv_timeout_duration | profile_send_timeout_duration
+            | profile_max_recv_sz
+            | profile_min_reconnect_duration | profile_max_reconnect_duration,
+
+        // Only pair1 supports a maximum TTL.
+        profile_pair1_socket_fields = profile_socket_fields | profile_max_ttl,
+
+        profile_dialer_fields = profile_max_recv_sz
+            | profile_min_reconnect_duration | profile_max_reconnect_duration,
+
+        profile_listener_fields = profile_max_recv_sz
+    };
+
+    /* A declarative set of writable options, i.e. the tuning shared by thousands of dialers,
+    which may be built once and applied to each of them in one call. Read-only options, such as
+    addresses and descriptors, have no place here. Snapshots come back in the same shape, with
+    only the options applying to the object present. */
+    struct _OptionProfile {
+
+        uint32_t fields;
+
+        std::string socket_name;
+
+        duration_type linger_duration;
+
+        int32_t recv_buf;
+
+        int32_t send_buf;
+
+        duration_type recv_timeout_duration;
+
+        duration_type send_timeout_duration;
+
+        int32_t max_ttl;
+
+        size_type max_recv_sz;
+
+        duration_type min_reconnect_duration;
+
+        duration_type max_reconnect_duration;
+
+        _OptionProfile();
+
+        bool Has(option_profile_field_type field) const;
+
+        _OptionProfile& SetSocketName(const std::string& value);
+        _OptionProfile& SetLingerDuration(const duration_type& value);
+        _OptionProfile& SetRecvBuf(int32_t value);
+        _OptionProfile& SetSendBuf(int32_t value);
+        _OptionProfile& SetRecvTimeoutDuration(const duration_type& value);
+        _OptionProfile& SetSendTimeoutDuration(const duration_type& value);
+        _OptionProfile& SetMaxTtl(int32_t value);
+        _OptionProfile& SetMaxRecvSize(size_type value);
+        _OptionProfile& SetMinReconnectDuration(const duration_type& value);
+        _OptionProfile& SetMaxReconnectDuration(const duration_type& value);
+
+        /* Throws nng_exception with ec_enotsup when an option does not apply, or with ec_einval
+        when a value is out of range, before anything has been set. */
+        void Validate(uint32_t applicable) const;
+    };
+
+    typedef _OptionProfile option_profile;
+}
+
+#endif // NNGCPP_OPTIONS_PROFILE_H
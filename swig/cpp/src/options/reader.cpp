@@ -3,27 +3,82 @@
 #include "../core/invocation.hpp"
 #include "../algorithms/string_algo.hpp"
 
+#include <algorithm>
+#include <cctype>
+
 namespace nng {
 
     _BasicOptionReader::_BasicOptionReader()
-        : _getopt()
-        , _getopt_int()
-        , _getopt_sz()
-        , _getopt_duration() {
+        : _getter_id(0)
+        , _getopt(nullptr)
+        , _getopt_int(nullptr)
+        , _getopt_sz(nullptr)
+        , _getopt_duration(nullptr)
+        , _cache() {
     }
 
     _BasicOptionReader::~_BasicOptionReader() {}
 
-    void _BasicOptionReader::set_getters(const getopt_func& getopt
-        , const getopt_int_func& getopt_int
-        , const getopt_sz_func& getopt_sz
-        , const getopt_duration_func& getopt_duration) {
+    void _BasicOptionReader::set_getters(handle_type id
+        , getopt_func getopt
+        , getopt_int_func getopt_int
+        , getopt_sz_func getopt_sz
+        , getopt_duration_func getopt_duration) {
+
+        _getter_id = id;
+        _getopt = getopt;
+        _getopt_int = getopt_int;
+        _getopt_sz = getopt_sz;
+        _getopt_duration = getopt_duration;
+
+        // Whatever we knew was about some other handle.
+        _cache.Clear();
+    }
+
+    void _BasicOptionReader::get_value(const char* const name, int32_t& x) {
+        int val;
+        invocation::with_default_error_handling(_getopt_int, _getter_id, name, &val);
+        x = val;
+    }
+
+    void _BasicOptionReader::get_value(const char* const name, size_type& x) {
+        invocation::with_default_error_handling(_getopt_sz, _getter_id, name, &x);
+    }
+
+    void _BasicOptionReader::get_value(const char* const name, duration_type& x) {
+        duration_rep_type val;
+        invocation::with_default_error_handling(_getopt_duration, _getter_id, name, &val);
+        x = duration_type(val);
+    }
+
+    void _BasicOptionReader::get_value(const char* const name, std::string& x) {
+
+        // Reading onto the stack leaves the string we hand back as the only allocation.
+        char buf[_MAX_PATH] = {};
+        size_type sz = sizeof(buf);
+
+        invocation::with_default_error_handling(_getopt, _getter_id, name, buf, &sz);
+
+        // Trimmed as trx::trimcp would, only without the copies.
+        const auto keep = [](char ch) { return ch && !std::isspace(ch); };
+        const auto end = buf + std::min(sz, sizeof(buf));
+        const auto first = std::find_if(buf, end, keep);
+        const auto last = std::find_if(std::reverse_iterator<char*>(end), std::reverse_iterator<char*>(first), keep).base();
+
+        x.assign(first, last);
+    }
 
-        // Ditto casting constness away...
-        const_cast<getopt_func&>(_getopt) = getopt;
-        const_cast<getopt_int_func&>(_getopt_int) = getopt_int;
-        const_cast<getopt_sz_func&>(_getopt_sz) = getopt_sz;
-        const_cast<getopt_duration_func&>(_getopt_duration) = getopt_duration;
+    void _BasicOptionReader::get_value(const char* const name, _SockAddr& x) {
+        auto sz = x.GetSize();
+        invocation::with_default_error_handling(_getopt, _getter_id, name, x.get(), &sz);
+    }
+
+    void _BasicOptionReader::InvalidateCache() {
+        _cache.Clear();
+    }
+
+    const _OptionCache* const _BasicOptionReader::GetCache() const {
+        return &_cache;
     }
 
     _OptionReader::_OptionReader()
@@ -34,19 +89,19 @@ namespace nng {
     }
 
     void _OptionReader::get(const std::string& name, void* valp, size_type& sz) {
-        invocation::with_default_error_handling(_getopt, name.c_str(), valp, &sz);
+        invocation::with_default_error_handling(_getopt, _getter_id, name.c_str(), valp, &sz);
     }
 
     std::string _OptionReader::GetText(const std::string& name) {
-        // TODO: TBD: for lack of a better definition for the moment...
-        size_type sz = _MAX_PATH;
-        return GetText(name, sz);
+        std::string s;
+        get_value(name.c_str(), s);
+        return s;
     }
 
     std::string _OptionReader::GetText(const std::string& name, size_type& sz) {
         std::string s;
         s.resize(sz);
-        invocation::with_default_error_handling(_getopt, name.c_str(), &s[0], &sz);
+        invocation::with_default_error_handling(_getopt, _getter_id, name.c_str(), &s[0], &sz);
         /* So we do use the string trimming algorithms after all...
         Which the in-place is sufficient, no need to use the copying version. */
         return trx::trimcp(s);
@@ -54,13 +109,13 @@ namespace nng {
 
     int _OptionReader::GetInt32(const std::string& name) {
         int val;
-        invocation::with_default_error_handling(_getopt_int, name.c_str(), &val);
+        invocation::with_default_error_handling(_getopt_int, _getter_id, name.c_str(), &val);
         return val;
     }
 
     size_type _OptionReader::GetSize(const std::string& name) {
         size_type result;
-        invocation::with_default_error_handling(_getopt_sz, name.c_str(), &result);
+        invocation::with_default_error_handling(_getopt_sz, _getter_id, name.c_str(), &result);
         return result;
     }
 
@@ -71,14 +126,14 @@ namespace nng {
 
     duration_rep_type _OptionReader::GetMilliseconds(const std::string& name) {
         duration_rep_type result;
-        invocation::with_default_error_handling(_getopt_duration, name.c_str(), &result);
+        invocation::with_default_error_handling(_getopt_duration, _getter_id, name.c_str(), &result);
         return result;
     }
 
     _SockAddr _OptionReader::GetSocketAddress(const std::string& name) {
         _SockAddr result;
         auto sz = result.GetSize();
-        invocation::with_default_error_handling(_getopt, name.c_str(), result.get(), &sz);
+        invocation::with_default_error_handling(_getopt, _getter_id, name.c_str(), result.get(), &sz);
         return result;
     }
 }
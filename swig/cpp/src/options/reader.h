@@ -3,8 +3,10 @@
 
 #include "../core/types.h"
 
+#include "names.h"
+#include "cache.h"
+
 #include <string>
-#include <functional>
 
 namespace nng {
 
@@ -37,22 +39,32 @@ namespace nng {
     struct _BasicOptionReader {
     public:
 
-        typedef std::function<int(const char*, void* valp, size_type* szp)> getopt_func;
+        /* Sockets, dialers, listeners and pipes are all 32-bit handles as far as NNG is concerned,
+        so we keep the handle alongside plain function pointers. This compiles down to direct calls
+        into NNG, as contrasted with invoking through a bound std::function on every operation. */
+        typedef uint32_t handle_type;
+
+        typedef int(*getopt_func)(handle_type, const char*, void* valp, size_type* szp);
 
-        typedef std::function<int(const char*, int* valp)> getopt_int_func;
-        typedef std::function<int(const char*, size_type* valp)> getopt_sz_func;
+        typedef int(*getopt_int_func)(handle_type, const char*, int* valp);
+        typedef int(*getopt_sz_func)(handle_type, const char*, size_type* valp);
 
-        typedef std::function<int(const char*, duration_rep_type* valp)> getopt_duration_func;
+        typedef int(*getopt_duration_func)(handle_type, const char*, duration_rep_type* valp);
 
     private:
 
         friend class _OptionReader;
         friend class _OptionReaderWriter;
 
-        const getopt_func _getopt;
-        const getopt_int_func _getopt_int;
-        const getopt_sz_func _getopt_sz;
-        const getopt_duration_func _getopt_duration;
+        handle_type _getter_id;
+
+        getopt_func _getopt;
+        getopt_int_func _getopt_int;
+        getopt_sz_func _getopt_sz;
+        getopt_duration_func _getopt_duration;
+
+        // Snapshots of the cached options, which readers and writers alike may invalidate.
+        _OptionCache _cache;
 
     protected:
 
@@ -62,15 +74,47 @@ namespace nng {
         friend class message_pipe;
 
         // TODO: TBD: making them public against my better judgment; however friendship web is getting kind of sticky IMHO...
-        void set_getters(const getopt_func& getopt
-            , const getopt_int_func& getopt_int
-            , const getopt_sz_func& getopt_sz
-            , const getopt_duration_func& getopt_duration);
+        void set_getters(handle_type id
+            , getopt_func getopt
+            , getopt_int_func getopt_int
+            , getopt_sz_func getopt_sz
+            , getopt_duration_func getopt_duration);
+
+        // Typed reads, straight from NNG, bypassing any snapshot.
+        void get_value(const char* const name, int32_t& x);
+        void get_value(const char* const name, size_type& x);
+        void get_value(const char* const name, duration_type& x);
+        void get_value(const char* const name, std::string& x);
+        void get_value(const char* const name, _SockAddr& x);
 
     public:
 
         virtual ~_BasicOptionReader();
 
+        // Reads the option described by Option_, i.e. option_descriptors::url, by its NNG literal.
+        template<class Option_>
+        typename Option_::value_type Get() {
+
+            typedef typename Option_::value_type value_type;
+
+            if (Option_::cached) {
+                const auto p = _cache.Find<value_type>(Option_::name());
+                if (p) { return *p; }
+            }
+
+            value_type x;
+            get_value(Option_::name(), x);
+
+            if (Option_::cached) { _cache.Store(Option_::name(), x); }
+
+            return x;
+        }
+
+        // Drops every snapshot, for when a cached option may have changed behind our back.
+        void InvalidateCache();
+
+        const _OptionCache* const GetCache() const;
+
         virtual void get(const std::string& name, void* valp, size_type& szp) = 0;
 
         virtual std::string GetText(const std::string& name) = 0;
@@ -14,19 +14,23 @@ namespace nng {
     }
 
     void _OptionReaderWriter::get(const std::string& name, void* valp, size_type& sz) {
-        invocation::with_default_error_handling(_getopt, name.c_str(), valp, &sz);
+        invocation::with_default_error_handling(_getopt, _getter_id, name.c_str(), valp, &sz);
+    }
+
+    void _OptionReaderWriter::on_set(const char* const name) {
+        _cache.Invalidate(name);
     }
 
     std::string _OptionReaderWriter::GetText(const std::string& name) {
-        // TODO: TBD: for lack of a better definition for the moment...
-        size_type sz = _MAX_PATH;
-        return GetText(name, sz);
+        std::string s;
+        get_value(name.c_str(), s);
+        return s;
     }
 
     std::string _OptionReaderWriter::GetText(const std::string& name, size_type& sz) {
         std::string s;
         s.resize(sz);
-        invocation::with_default_error_handling(_getopt, name.c_str(), &s[0], &sz);
+        invocation::with_default_error_handling(_getopt, _getter_id, name.c_str(), &s[0], &sz);
         /* So we do use the string trimming algorithms after all...
         Which the in-place is sufficient, no need to use the copying version. */
         return trx::trimcp(s);
@@ -34,13 +38,13 @@ namespace nng {
 
     int32_t _OptionReaderWriter::GetInt32(const std::string& name) {
         int val;
-        invocation::with_default_error_handling(_getopt_int, name.c_str(), &val);
+        invocation::with_default_error_handling(_getopt_int, _getter_id, name.c_str(), &val);
         return val;
     }
 
     size_type _OptionReaderWriter::GetSize(const std::string& name) {
         size_type result;
-        invocation::with_default_error_handling(_getopt_sz, name.c_str(), &result);
+        invocation::with_default_error_handling(_getopt_sz, _getter_id, name.c_str(), &result);
         return result;
     }
 
@@ -51,31 +55,35 @@ namespace nng {
 
     duration_rep_type _OptionReaderWriter::GetMilliseconds(const std::string& name) {
         duration_rep_type result;
-        invocation::with_default_error_handling(_getopt_duration, name.c_str(), &result);
+        invocation::with_default_error_handling(_getopt_duration, _getter_id, name.c_str(), &result);
         return result;
     }
 
     _SockAddr _OptionReaderWriter::GetSocketAddress(const std::string& name) {
         _SockAddr result;
         auto sz = result.GetSize();
-        invocation::with_default_error_handling(_getopt, name.c_str(), result.get(), &sz);
+        invocation::with_default_error_handling(_getopt, _getter_id, name.c_str(), result.get(), &sz);
         return result;
     }
 
     void _OptionReaderWriter::set(const std::string& name, const void* valp, size_type sz) {
-        invocation::with_default_error_handling(_setopt, name.c_str(), valp, sz);
+        invocation::with_default_error_handling(_setopt, _setter_id, name.c_str(), valp, sz);
+        on_set(name.c_str());
     }
 
     void _OptionReaderWriter::SetString(const std::string& name, const std::string& s) {
-        invocation::with_default_error_handling(_setopt, name.c_str(), s.c_str(), s.length());
+        invocation::with_default_error_handling(_setopt, _setter_id, name.c_str(), s.c_str(), s.length());
+        on_set(name.c_str());
     }
 
     void _OptionReaderWriter::SetInt32(const std::string& name, int32_t val) {
-        invocation::with_default_error_handling(_setopt_int, name.c_str(), val);
+        invocation::with_default_error_handling(_setopt_int, _setter_id, name.c_str(), val);
+        on_set(name.c_str());
     }
 
     void _OptionReaderWriter::SetSize(const std::string& name, size_type val) {
-        invocation::with_default_error_handling(_setopt_sz, name.c_str(), val);
+        invocation::with_default_error_handling(_setopt_sz, _setter_id, name.c_str(), val);
+        on_set(name.c_str());
     }
 
     void _OptionReaderWriter::SetDuration(const std::string& name, const duration_type& val) {
@@ -83,6 +91,52 @@ namespace nng {
     }
 
     void _OptionReaderWriter::SetMilliseconds(const std::string& name, duration_rep_type val) {
-        invocation::with_default_error_handling(_setopt_duration, name.c_str(), val);
+        invocation::with_default_error_handling(_setopt_duration, _setter_id, name.c_str(), val);
+        on_set(name.c_str());
+    }
+
+    _OptionProfile _OptionReaderWriter::Snapshot(uint32_t fields) {
+
+        using K = _OptionKeys;
+
+        _OptionProfile result;
+
+        result.fields = fields;
+
+        const auto has = [&result](option_profile_field_type field) { return result.Has(field); };
+
+        if (has(profile_socket_name)) { get_value(K::socket_name::value, result.socket_name); }
+        if (has(profile_linger_duration)) { get_value(K::linger_duration::value, result.linger_duration); }
+        if (has(profile_recv_buf)) { get_value(K::recv_buf::value, result.recv_buf); }
+        if (has(profile_send_buf)) { get_value(K::send_buf::value, result.send_buf); }
+        if (has(profile_recv_timeout_duration)) { get_value(K::recv_timeout_duration::value, result.recv_timeout_duration); }
+        if (has(profile_send_timeout_duration)) { get_value(K::send_timeout_duration::value, result.send_timeout_duration); }
+        if (has(profile_max_ttl)) { get_value(K::max_ttl::value, result.max_ttl); }
+        if (has(profile_max_recv_sz)) { get_value(K::max_recv_sz::value, result.max_recv_sz); }
+        if (has(profile_min_reconnect_duration)) { get_value(K::min_reconnect_duration::value, result.min_reconnect_duration); }
+        if (has(profile_max_reconnect_duration)) { get_value(K::max_reconnect_duration::value, result.max_reconnect_duration); }
+
+        return result;
+    }
+
+    void _OptionReaderWriter::Apply(const _OptionProfile& profile, uint32_t applicable) {
+
+        using K = _OptionKeys;
+
+        profile.Validate(applicable);
+
+        const auto has = [&profile](option_profile_field_type field) { return profile.Has(field); };
+
+        // None of these are ever cached, so there is nothing to invalidate along the way.
+        if (has(profile_socket_name)) { set_value(K::socket_name::value, profile.socket_name); }
+        if (has(profile_linger_duration)) { set_value(K::linger_duration::value, profile.linger_duration); }
+        if (has(profile_recv_buf)) { set_value(K::recv_buf::value, profile.recv_buf); }
+        if (has(profile_send_buf)) { set_value(K::send_buf::value, profile.send_buf); }
+        if (has(profile_recv_timeout_duration)) { set_value(K::recv_timeout_duration::value, profile.recv_timeout_duration); }
+        if (has(profile_send_timeout_duration)) { set_value(K::send_timeout_duration::value, profile.send_timeout_duration); }
+        if (has(profile_max_ttl)) { set_value(K::max_ttl::value, profile.max_ttl); }
+        if (has(profile_max_recv_sz)) { set_value(K::max_recv_sz::value, profile.max_recv_sz); }
+        if (has(profile_min_reconnect_duration)) { set_value(K::min_reconnect_duration::value, profile.min_reconnect_duration); }
+        if (has(profile_max_reconnect_duration)) { set_value(K::max_reconnect_duration::value, profile.max_reconnect_duration); }
     }
 }
@@ -3,6 +3,7 @@
 
 #include "reader.h"
 #include "writer.h"
+#include "profile.h"
 
 namespace nng {
 
@@ -15,6 +16,8 @@ namespace nng {
         , public _BasicOptionWriter {
     protected:
 
+        virtual void on_set(const char* const name) override;
+
         template<class Options_> friend struct IHaveOptions;
 
         _OptionReaderWriter();
@@ -44,6 +47,13 @@ namespace nng {
 
         virtual void SetDuration(const std::string& name, const duration_type& val) override;
         virtual void SetMilliseconds(const std::string& name, duration_rep_type val) override;
+
+        // Reads the requested options, one getopt apiece, straight from NNG.
+        _OptionProfile Snapshot(uint32_t fields);
+
+        /* Validates the whole profile against the applicable options before setting any of it.
+        NNG may still refuse an option part way through, in which case the ones before it stay set. */
+        void Apply(const _OptionProfile& profile, uint32_t applicable);
     };
 
     typedef _OptionReaderWriter options_reader_writer;
@@ -4,24 +4,45 @@
 namespace nng {
 
     _BasicOptionWriter::_BasicOptionWriter()
-        : _setopt()
-        , _setopt_int()
-        , _setopt_sz()
-        , _setopt_duration() {
+        : _setter_id(0)
+        , _setopt(nullptr)
+        , _setopt_int(nullptr)
+        , _setopt_sz(nullptr)
+        , _setopt_duration(nullptr) {
     }
 
     _BasicOptionWriter::~_BasicOptionWriter() {}
 
-    void _BasicOptionWriter::set_setters(const setopt_func& setopt
-        , const setopt_int_func& setopt_int
-        , const setopt_sz_func& setopt_sz
-        , const setopt_duration_func& setopt_duration) {
+    void _BasicOptionWriter::set_setters(handle_type id
+        , setopt_func setopt
+        , setopt_int_func setopt_int
+        , setopt_sz_func setopt_sz
+        , setopt_duration_func setopt_duration) {
 
-        // Cast the constness away from the setters long enough to install the new ones.
-        const_cast<setopt_func&>(_setopt) = setopt;
-        const_cast<setopt_int_func&>(_setopt_int) = setopt_int;
-        const_cast<setopt_sz_func&>(_setopt_sz) = setopt_sz;
-        const_cast<setopt_duration_func&>(_setopt_duration) = setopt_duration;
+        _setter_id = id;
+        _setopt = setopt;
+        _setopt_int = setopt_int;
+        _setopt_sz = setopt_sz;
+        _setopt_duration = setopt_duration;
+    }
+
+    void _BasicOptionWriter::set_value(const char* const name, int32_t x) {
+        invocation::with_default_error_handling(_setopt_int, _setter_id, name, x);
+    }
+
+    void _BasicOptionWriter::set_value(const char* const name, size_type x) {
+        invocation::with_default_error_handling(_setopt_sz, _setter_id, name, x);
+    }
+
+    void _BasicOptionWriter::set_value(const char* const name, const duration_type& x) {
+        invocation::with_default_error_handling(_setopt_duration, _setter_id, name, x.count());
+    }
+
+    void _BasicOptionWriter::set_value(const char* const name, const std::string& x) {
+        invocation::with_default_error_handling(_setopt, _setter_id, name, x.c_str(), x.length());
+    }
+
+    void _BasicOptionWriter::on_set(const char* const name) {
     }
 
     _OptionWriter::_OptionWriter()
@@ -32,19 +53,19 @@ namespace nng {
     }
 
     void _OptionWriter::set(const std::string& name, const void* valp, size_type sz) {
-        invocation::with_default_error_handling(_setopt, name.c_str(), valp, sz);
+        invocation::with_default_error_handling(_setopt, _setter_id, name.c_str(), valp, sz);
     }
 
     void _OptionWriter::SetString(const std::string& name, const std::string& s) {
-        invocation::with_default_error_handling(_setopt, name.c_str(), s.c_str(), s.length());
+        invocation::with_default_error_handling(_setopt, _setter_id, name.c_str(), s.c_str(), s.length());
     }
 
     void _OptionWriter::SetInt32(const std::string& name, int32_t val) {
-        invocation::with_default_error_handling(_setopt_int, name.c_str(), val);
+        invocation::with_default_error_handling(_setopt_int, _setter_id, name.c_str(), val);
     }
 
     void _OptionWriter::SetSize(const std::string& name, size_type val) {
-        invocation::with_default_error_handling(_setopt_sz, name.c_str(), val);
+        invocation::with_default_error_handling(_setopt_sz, _setter_id, name.c_str(), val);
     }
 
     void _OptionWriter::SetDuration(const std::string& name, const duration_type& val) {
@@ -52,6 +73,6 @@ namespace nng {
     }
 
     void _OptionWriter::SetMilliseconds(const std::string& name, duration_rep_type val) {
-        invocation::with_default_error_handling(_setopt_duration, name.c_str(), val);
+        invocation::with_default_error_handling(_setopt_duration, _setter_id, name.c_str(), val);
     }
 }
@@ -4,7 +4,6 @@
 #include "../core/types.h"
 
 #include <string>
-#include <functional>
 
 namespace nng {
 
@@ -29,22 +28,27 @@ namespace nng {
     struct _BasicOptionWriter {
     public:
 
-        typedef std::function<int(const char*, const void*, size_type)> setopt_func;
+        // Ditto the reader concerning handles and direct calls.
+        typedef uint32_t handle_type;
 
-        typedef std::function<int(const char*, int val)> setopt_int_func;
-        typedef std::function<int(const char*, size_type val)> setopt_sz_func;
+        typedef int(*setopt_func)(handle_type, const char*, const void*, size_type);
 
-        typedef std::function<int(const char*, duration_rep_type)> setopt_duration_func;
+        typedef int(*setopt_int_func)(handle_type, const char*, int val);
+        typedef int(*setopt_sz_func)(handle_type, const char*, size_type val);
+
+        typedef int(*setopt_duration_func)(handle_type, const char*, duration_rep_type);
 
     private:
 
         friend class _OptionWriter;
         friend class _OptionReaderWriter;
 
-        const setopt_func _setopt;
-        const setopt_int_func _setopt_int;
-        const setopt_sz_func _setopt_sz;
-        const setopt_duration_func _setopt_duration;
+        handle_type _setter_id;
+
+        setopt_func _setopt;
+        setopt_int_func _setopt_int;
+        setopt_sz_func _setopt_sz;
+        setopt_duration_func _setopt_duration;
 
     protected:
 
@@ -53,15 +57,32 @@ namespace nng {
         friend class _Dialer;
 
         // TODO: TBD: ditto sticky friendship web...
-        void set_setters(const setopt_func& setopt
-            , const setopt_int_func& setopt_int
-            , const setopt_sz_func& setopt_sz
-            , const setopt_duration_func& setopt_duration);
+        void set_setters(handle_type id
+            , setopt_func setopt
+            , setopt_int_func setopt_int
+            , setopt_sz_func setopt_sz
+            , setopt_duration_func setopt_duration);
+
+        // Typed writes, straight to NNG.
+        void set_value(const char* const name, int32_t x);
+        void set_value(const char* const name, size_type x);
+        void set_value(const char* const name, const duration_type& x);
+        void set_value(const char* const name, const std::string& x);
+
+        // Called after each successful set, so that anything cached about the option may be dropped.
+        virtual void on_set(const char* const name);
 
     public:
 
         virtual ~_BasicOptionWriter();
 
+        // Writes the option described by Option_; read-only options, i.e. addresses, do not compile.
+        template<class Option_>
+        void Set(const typename Option_::value_type& x) {
+            set_value(Option_::name(), x);
+            on_set(Option_::name());
+        }
+
         virtual void set(const std::string& name, const void* valp, size_type sz) = 0;
         virtual void SetString(const std::string& name, const std::string& s) = 0;
 
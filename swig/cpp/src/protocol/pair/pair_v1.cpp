@@ -11,6 +11,10 @@ namespace nng {
 
             pair_socket::~pair_socket() {
             }
+
+            uint32_t pair_socket::get_profile_fields() const {
+                return profile_pair1_socket_fields;
+            }
         }
     }
 }
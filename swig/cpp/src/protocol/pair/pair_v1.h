@@ -15,6 +15,10 @@ namespace nng {
                     pair_socket();
 
                     virtual ~pair_socket();
+
+                protected:
+
+                    virtual uint32_t get_profile_fields() const override;
             };
         }
 
@@ -26,6 +26,26 @@ namespace nng {
                 THROW_SOCKET_INV_OP(Pullers, Send);
             }
 
+            error_code_type pull_socket::TrySend(binary_message& m, flag_type flags) {
+                THROW_SOCKET_INV_OP(Pullers, TrySend);
+            }
+
+            error_code_type pull_socket::TrySend(const buffer_vector_type& buf, flag_type flags) {
+                THROW_SOCKET_INV_OP(Pullers, TrySend);
+            }
+
+            void pull_socket::SendGather(const const_buffer_segment* const segs, size_type count, flag_type flags) {
+                THROW_SOCKET_INV_OP(Pullers, SendGather);
+            }
+
+            error_code_type pull_socket::TrySendGather(const const_buffer_segment* const segs, size_type count, flag_type flags) {
+                THROW_SOCKET_INV_OP(Pullers, TrySendGather);
+            }
+
+            std::vector<error_code_type> pull_socket::SendBatch(binary_message* const msgs, size_type count, flag_type flags) {
+                THROW_SOCKET_INV_OP(Pullers, SendBatch);
+            }
+
             void pull_socket::SendAsync(const basic_async_service* const svcp) {
                 THROW_SOCKET_INV_OP(Pullers, SendAsync);
             }
@@ -23,6 +23,14 @@ namespace nng {
                 virtual void Send(const buffer_vector_type& buf, flag_type flags = flag_none) override;
                 virtual void Send(const buffer_vector_type& buf, size_type sz, flag_type flags = flag_none) override;
 
+                virtual error_code_type TrySend(binary_message& m, flag_type flags = flag_none) override;
+                virtual error_code_type TrySend(const buffer_vector_type& buf, flag_type flags = flag_none) override;
+
+                virtual void SendGather(const const_buffer_segment* const segs, size_type count, flag_type flags = flag_none) override;
+                virtual error_code_type TrySendGather(const const_buffer_segment* const segs, size_type count, flag_type flags = flag_none) override;
+
+                virtual std::vector<error_code_type> SendBatch(binary_message* const msgs, size_type count, flag_type flags = flag_none) override;
+
                 virtual void SendAsync(const basic_async_service* const svcp) override;
             };
         }
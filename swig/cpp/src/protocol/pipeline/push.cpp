@@ -1,4 +1,8 @@
 #include "push.h"
+#include "push_dispatcher.h"
+#include "../../messaging/binary_message.h"
+
+#include <algorithm>
 
 namespace nng {
     namespace protocol {
@@ -8,12 +12,71 @@ namespace nng {
             using std::bind;
 
             // While we could use nng_push_open, I think it is sufficient to just use the versioned symbol.
-            push_socket::push_socket() : _Socket(bind(&(::nng_push0_open), _1)) {
+            push_socket::push_socket() : _Socket(bind(&(::nng_push0_open), _1)), _dispatcherp() {
             }
 
             push_socket::~push_socket() {
             }
 
+            void push_socket::SetDispatcher(const std::shared_ptr<_PushDispatcher>& dispatcherp) {
+                _dispatcherp = dispatcherp;
+            }
+
+            std::shared_ptr<_PushDispatcher> push_socket::GetDispatcher() const {
+                return _dispatcherp;
+            }
+
+            void push_socket::Send(binary_message& m, flag_type flags) {
+                if (!_dispatcherp) {
+                    _Socket::Send(m, flags);
+                    return;
+                }
+                throw_if_failed(_dispatcherp->TrySend(m, flags));
+            }
+
+            void push_socket::Send(const buffer_vector_type& buf, flag_type flags) {
+                Send(buf, buf.size(), flags);
+            }
+
+            void push_socket::Send(const buffer_vector_type& buf, size_type sz, flag_type flags) {
+                if (!_dispatcherp) {
+                    _Socket::Send(buf, sz, flags);
+                    return;
+                }
+                binary_message bm;
+                bm.GetBody()->Append(buffer_vector_type(buf.begin(), buf.begin() + std::min(buf.size(), sz)));
+                Send(bm, flags);
+            }
+
+            error_code_type push_socket::TrySend(binary_message& m, flag_type flags) {
+                return _dispatcherp ? _dispatcherp->TrySend(m, flags) : _Socket::TrySend(m, flags);
+            }
+
+            error_code_type push_socket::TrySend(const buffer_vector_type& buf, flag_type flags) {
+                if (!_dispatcherp) { return _Socket::TrySend(buf, flags); }
+                binary_message bm;
+                bm.GetBody()->Append(buf);
+                return _dispatcherp->TrySend(bm, flags);
+            }
+
+            void push_socket::SendGather(const const_buffer_segment* const segs, size_type count, flag_type flags) {
+                if (!_dispatcherp) {
+                    _Socket::SendGather(segs, count, flags);
+                    return;
+                }
+                binary_message bm;
+                // Counted the same as a failed gather on the direct path.
+                throw_if_failed(gather(bm, segs, count));
+                Send(bm, flags);
+            }
+
+            error_code_type push_socket::TrySendGather(const const_buffer_segment* const segs, size_type count, flag_type flags) {
+                if (!_dispatcherp) { return _Socket::TrySendGather(segs, count, flags); }
+                binary_message bm;
+                const auto ec = gather(bm, segs, count);
+                return ec == ec_enone ? _dispatcherp->TrySend(bm, flags) : ec;
+            }
+
             std::unique_ptr<binary_message> push_socket::Receive(flag_type flags) {
                 THROW_SOCKET_INV_OP(Pushers, Receive);
             }
@@ -30,6 +93,36 @@ namespace nng {
                 THROW_SOCKET_INV_OP(Pushers, TryReceive);
             }
 
+            allocated_buffer push_socket::ReceiveAllocated(flag_type flags) {
+                THROW_SOCKET_INV_OP(Pushers, ReceiveAllocated);
+            }
+
+            bool push_socket::TryReceive(allocated_buffer* const abp, flag_type flags) {
+                THROW_SOCKET_INV_OP(Pushers, TryReceive);
+            }
+
+            error_code_type push_socket::TryReceive(binary_message& m, flag_type flags) {
+                THROW_SOCKET_INV_OP(Pushers, TryReceive);
+            }
+
+            error_code_type push_socket::TryReceive(allocated_buffer& buf, flag_type flags) {
+                THROW_SOCKET_INV_OP(Pushers, TryReceive);
+            }
+
+            size_type push_socket::ReceiveScatter(const mutable_buffer_segment* const segs, size_type count, flag_type flags) {
+                THROW_SOCKET_INV_OP(Pushers, ReceiveScatter);
+            }
+
+            error_code_type push_socket::TryReceiveScatter(const mutable_buffer_segment* const segs, size_type count
+                , size_type& sz, flag_type flags) {
+                THROW_SOCKET_INV_OP(Pushers, TryReceiveScatter);
+            }
+
+            error_code_type push_socket::ReceiveBatch(std::vector<std::unique_ptr<binary_message>>& results
+                , size_type max, const duration_type& timeout) {
+                THROW_SOCKET_INV_OP(Pushers, ReceiveBatch);
+            }
+
             void push_socket::ReceiveAsync(basic_async_service* const svcp) {
                 THROW_SOCKET_INV_OP(Pushers, ReceiveAsync);
             }
@@ -3,19 +3,44 @@
 
 #include "../../core/socket.h"
 
+#include <memory>
+
 namespace nng {
 
     namespace protocol {
 
+        class _PushDispatcher;
+
         namespace v0 {
             
             class push_socket : public _Socket {
+            private:
+
+                std::shared_ptr<_PushDispatcher> _dispatcherp;
+
             public:
 
                 push_socket();
 
                 virtual ~push_socket();
 
+                /* Sends go to the least loaded worker by way of the dispatcher, instead of round
+                robin among this socket's own pipes, until the dispatcher is reset to null. */
+                void SetDispatcher(const std::shared_ptr<_PushDispatcher>& dispatcherp);
+
+                std::shared_ptr<_PushDispatcher> GetDispatcher() const;
+
+                virtual void Send(binary_message& m, flag_type flags = flag_none) override;
+
+                virtual void Send(const buffer_vector_type& buf, flag_type flags = flag_none) override;
+                virtual void Send(const buffer_vector_type& buf, size_type sz, flag_type flags = flag_none) override;
+
+                virtual error_code_type TrySend(binary_message& m, flag_type flags = flag_none) override;
+                virtual error_code_type TrySend(const buffer_vector_type& buf, flag_type flags = flag_none) override;
+
+                virtual void SendGather(const const_buffer_segment* const segs, size_type count, flag_type flags = flag_none) override;
+                virtual error_code_type TrySendGather(const const_buffer_segment* const segs, size_type count, flag_type flags = flag_none) override;
+
             protected:
 
                 virtual std::unique_ptr<binary_message> Receive(flag_type flags = flag_none) override;
@@ -24,6 +49,19 @@ namespace nng {
                 virtual buffer_vector_type Receive(size_type& sz, flag_type flags = flag_none) override;
                 virtual bool TryReceive(buffer_vector_type* const bufp, size_type& sz, flag_type flags = flag_none) override;
 
+                virtual allocated_buffer ReceiveAllocated(flag_type flags = flag_none) override;
+                virtual bool TryReceive(allocated_buffer* const abp, flag_type flags = flag_none) override;
+
+                virtual error_code_type TryReceive(binary_message& m, flag_type flags = flag_none) override;
+                virtual error_code_type TryReceive(allocated_buffer& buf, flag_type flags = flag_none) override;
+
+                virtual size_type ReceiveScatter(const mutable_buffer_segment* const segs, size_type count, flag_type flags = flag_none) override;
+                virtual error_code_type TryReceiveScatter(const mutable_buffer_segment* const segs, size_type count
+                    , size_type& sz, flag_type flags = flag_none) override;
+
+                virtual error_code_type ReceiveBatch(std::vector<std::unique_ptr<binary_message>>& results
+                    , size_type max, const duration_type& timeout) override;
+
                 virtual void ReceiveAsync(basic_async_service* const svcp) override;
             };
         }
@@ -0,0 +1,189 @@
+#include "push_dispatcher.h"
+#include "../../messaging/binary_message.h"
+#include "../../core/exceptions.hpp"
+
+namespace nng {
+    namespace protocol {
+
+        _DispatchLaneStats::_DispatchLaneStats() : outstanding(0), sent(0), acknowledged(0) {
+        }
+
+        struct _DispatchLane {
+
+            v0::push_socket s;
+
+            _DispatchLaneStats stats;
+
+            _DispatchLane() : s(), stats() {
+            }
+        };
+
+        namespace {
+
+            const size_type ticket_size = sizeof(_PushDispatcher::ticket_type);
+        }
+
+        _PushDispatcher::_PushDispatcher(const std::string& ack_addr, size_type credit)
+            : _mutex(), _cv(), _lanes(), _credit(credit), _next(0), _stopping(false), _acks(), _receiverp() {
+
+            _acks.Listen(ack_addr);
+
+            _receiverp = std::make_unique<aio_pool>(1);
+
+            // The pool is brand new, so this is not expected, but there would be no credit without it.
+            if (!start_receive()) { THROW_NNG_EXCEPTION_EC(ec_ebusy); }
+        }
+
+        _PushDispatcher::~_PushDispatcher() {
+
+            {
+                std::lock_guard<std::mutex> guard(_mutex);
+                _stopping = true;
+            }
+
+            // Senders waiting on credit give up.
+            _cv.notify_all();
+
+            // Cancels the receive, and waits for its handler, which does not reissue it.
+            _receiverp.reset();
+        }
+
+        bool _PushDispatcher::start_receive() {
+            // From within the handler, this reissues the AIO being handled.
+            return _receiverp->TryReceive(_acks, [this](error_code_type ec, _Message& m) { on_acknowledged(ec, m); });
+        }
+
+        void _PushDispatcher::on_acknowledged(error_code_type ec, _Message& m) {
+
+            {
+                std::lock_guard<std::mutex> guard(_mutex);
+
+                if (ec == ec_enone && m.GetBody()->GetSize() >= ticket_size) {
+
+                    ticket_type ticket = 0;
+                    m.GetBody()->TrimLeft(&ticket);
+
+                    // Anything else is not one of ours, and there is nothing to credit.
+                    if (ticket < _lanes.size() && _lanes[ticket]->stats.outstanding > 0) {
+                        auto& stats = _lanes[ticket]->stats;
+                        --stats.outstanding;
+                        ++stats.acknowledged;
+                    }
+                }
+
+                if (_stopping) { return; }
+
+                // Without acks there will never be credit again, so senders must not wait for it.
+                if (ec == ec_eclosed || !start_receive()) { _stopping = true; }
+            }
+
+            _cv.notify_all();
+        }
+
+        size_type _PushDispatcher::AddWorker(const std::string& addr) {
+
+            auto lp = std::make_unique<_DispatchLane>();
+
+            // Dial before taking the lock, so that a failure leaves the dispatcher as it was.
+            lp->s.Dial(addr);
+
+            size_type worker;
+
+            {
+                std::lock_guard<std::mutex> guard(_mutex);
+                worker = _lanes.size();
+                _lanes.push_back(std::move(lp));
+            }
+
+            // The new lane has credit to spare.
+            _cv.notify_all();
+
+            return worker;
+        }
+
+        size_type _PushDispatcher::get_least_loaded() {
+
+            const auto count = _lanes.size();
+
+            auto best = count;
+
+            // Starting after the last choice spreads ties around, which is round robin when idle.
+            for (size_type i = 0; i < count; i++) {
+                const auto j = (_next + i) % count;
+                const auto outstanding = _lanes[j]->stats.outstanding;
+                if (_credit && outstanding >= _credit) { continue; }
+                if (best == count || outstanding < _lanes[best]->stats.outstanding) { best = j; }
+            }
+
+            if (best < count) { _next = best + 1; }
+
+            return best;
+        }
+
+        error_code_type _PushDispatcher::TrySend(binary_message& m, flag_type flags) {
+
+            _DispatchLane* lp = nullptr;
+            ticket_type ticket = 0;
+
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+
+                if (_lanes.empty()) { return ec_eagain; }
+
+                size_type worker;
+
+                while ((worker = get_least_loaded()) == _lanes.size()) {
+                    if (_stopping) { return ec_eclosed; }
+                    if (flags & flag_nonblock) { return ec_eagain; }
+                    _cv.wait(lock);
+                }
+
+                lp = _lanes[worker].get();
+                ticket = static_cast<ticket_type>(worker);
+
+                // Taking the credit up front keeps concurrent senders from piling onto the same lane.
+                ++lp->stats.outstanding;
+            }
+
+            m.GetBody()->Prepend(ticket);
+
+            const auto ec = lp->s.TrySend(m, flags);
+
+            std::lock_guard<std::mutex> guard(_mutex);
+
+            if (ec == ec_enone) {
+                ++lp->stats.sent;
+            }
+            else {
+                // Give the credit back, along with the message as it was.
+                --lp->stats.outstanding;
+                m.GetBody()->TrimLeft(ticket_size);
+                _cv.notify_all();
+            }
+
+            return ec;
+        }
+
+        size_type _PushDispatcher::GetWorkerCount() const {
+            std::lock_guard<std::mutex> guard(_mutex);
+            return _lanes.size();
+        }
+
+        _DispatchLaneStats _PushDispatcher::GetStats(size_type worker) const {
+            std::lock_guard<std::mutex> guard(_mutex);
+            return worker < _lanes.size() ? _lanes[worker]->stats : _DispatchLaneStats();
+        }
+
+        _PushDispatcher::ticket_type _PushDispatcher::TakeTicket(binary_message& m) {
+            ticket_type ticket = 0;
+            if (m.GetBody()->GetSize() >= ticket_size) { m.GetBody()->TrimLeft(&ticket); }
+            return ticket;
+        }
+
+        error_code_type _PushDispatcher::Acknowledge(_Socket& acks, ticket_type ticket) {
+            binary_message bm;
+            bm.GetBody()->Append(ticket);
+            return acks.TrySend(bm);
+        }
+    }
+}
@@ -0,0 +1,103 @@
+#ifndef CPPNNG_PROT_PUSH_DISPATCHER_H
+#define CPPNNG_PROT_PUSH_DISPATCHER_H
+
+#include "push.h"
+#include "pull.h"
+#include "../../core/async.h"
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace nng {
+
+    namespace protocol {
+
+        // Defined alongside the dispatcher.
+        struct _DispatchLane;
+
+        struct _DispatchLaneStats {
+
+            // Messages sent to the worker but not yet acknowledged.
+            size_type outstanding;
+
+            uint64_t sent;
+
+            uint64_t acknowledged;
+
+            _DispatchLaneStats();
+        };
+
+        /* Routes each message to whichever worker has the least work outstanding, rather than
+        round robin. NNG push offers no way to pick the pipe, so each worker gets a push lane of
+        its own, dialed to its pull listener. Each message carries a ticket at the front of its
+        body, which the worker takes with TakeTicket, and then hands back to the acknowledgement
+        address with Acknowledge once the work is done. A lane with as many messages outstanding
+        as its credit takes no more until some are acknowledged. */
+        class _PushDispatcher {
+        public:
+
+            typedef uint32_t ticket_type;
+
+        private:
+
+            mutable std::mutex _mutex;
+
+            std::condition_variable _cv;
+
+            std::vector<std::unique_ptr<_DispatchLane>> _lanes;
+
+            const size_type _credit;
+
+            size_type _next;
+
+            bool _stopping;
+
+            v0::pull_socket _acks;
+
+            std::unique_ptr<aio_pool> _receiverp;
+
+            bool start_receive();
+
+            void on_acknowledged(error_code_type ec, _Message& m);
+
+            // Expects the mutex to be held; returns the lane count when every lane is out of credit.
+            size_type get_least_loaded();
+
+        public:
+
+            // Listens for acknowledgements at the address; a credit of zero means no limit.
+            _PushDispatcher(const std::string& ack_addr, size_type credit = 0);
+
+            _PushDispatcher(const _PushDispatcher&) = delete;
+
+            _PushDispatcher& operator=(const _PushDispatcher&) = delete;
+
+            virtual ~_PushDispatcher();
+
+            // Dials the worker's pull listener, and returns the index of its lane.
+            size_type AddWorker(const std::string& addr);
+
+            /* Waits for credit unless flag_nonblock is given, in which case running out of credit
+            is ec_eagain. The message comes back on failure, without its ticket. */
+            error_code_type TrySend(binary_message& m, flag_type flags = flag_none);
+
+            size_type GetWorkerCount() const;
+
+            _DispatchLaneStats GetStats(size_type worker) const;
+
+            // For the worker: removes the ticket from the front of the body.
+            static ticket_type TakeTicket(binary_message& m);
+
+            // For the worker: sends the ticket back over a push socket dialed to the acknowledgement address.
+            static error_code_type Acknowledge(_Socket& acks, ticket_type ticket);
+        };
+
+        typedef _DispatchLaneStats dispatch_lane_stats;
+        typedef _PushDispatcher push_dispatcher;
+    }
+}
+
+#endif // CPPNNG_PROT_PUSH_DISPATCHER_H
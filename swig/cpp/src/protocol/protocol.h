@@ -13,14 +13,18 @@
 
 #include "pipeline/pull.h"
 #include "pipeline/push.h"
+#include "pipeline/push_dispatcher.h"
 
 #include "pubsub/pub.h"
 #include "pubsub/sub.h"
 
 #include "reqrep/req.h"
 #include "reqrep/rep.h"
+#include "reqrep/rep_server.h"
+#include "reqrep/req_client.h"
 
 #include "survey/respond.h"
 #include "survey/survey.h"
+#include "survey/survey_aggregator.h"
 
 #endif // CPPNNG_PROT_H
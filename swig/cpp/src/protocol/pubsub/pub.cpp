@@ -31,6 +31,36 @@ namespace nng {
                 THROW_SOCKET_INV_OP(Publishers, TryReceive);
             }
 
+            allocated_buffer pub_socket::ReceiveAllocated(flag_type flags) {
+                THROW_SOCKET_INV_OP(Publishers, ReceiveAllocated);
+            }
+
+            bool pub_socket::TryReceive(allocated_buffer* const abp, flag_type flags) {
+                THROW_SOCKET_INV_OP(Publishers, TryReceive);
+            }
+
+            error_code_type pub_socket::TryReceive(binary_message& m, flag_type flags) {
+                THROW_SOCKET_INV_OP(Publishers, TryReceive);
+            }
+
+            error_code_type pub_socket::TryReceive(allocated_buffer& buf, flag_type flags) {
+                THROW_SOCKET_INV_OP(Publishers, TryReceive);
+            }
+
+            size_type pub_socket::ReceiveScatter(const mutable_buffer_segment* const segs, size_type count, flag_type flags) {
+                THROW_SOCKET_INV_OP(Publishers, ReceiveScatter);
+            }
+
+            error_code_type pub_socket::TryReceiveScatter(const mutable_buffer_segment* const segs, size_type count
+                , size_type& sz, flag_type flags) {
+                THROW_SOCKET_INV_OP(Publishers, TryReceiveScatter);
+            }
+
+            error_code_type pub_socket::ReceiveBatch(std::vector<std::unique_ptr<binary_message>>& results
+                , size_type max, const duration_type& timeout) {
+                THROW_SOCKET_INV_OP(Publishers, ReceiveBatch);
+            }
+
             void pub_socket::ReceiveAsync(basic_async_service* const svcp) {
                 THROW_SOCKET_INV_OP(Publishers, ReceiveAsync);
             }
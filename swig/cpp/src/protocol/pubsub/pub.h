@@ -24,6 +24,19 @@ namespace nng {
                 virtual buffer_vector_type Receive(size_type& sz, flag_type flags = flag_none) override;
                 virtual bool TryReceive(buffer_vector_type* const bufp, size_type& sz, flag_type flags = flag_none) override;
 
+                virtual allocated_buffer ReceiveAllocated(flag_type flags = flag_none) override;
+                virtual bool TryReceive(allocated_buffer* const abp, flag_type flags = flag_none) override;
+
+                virtual error_code_type TryReceive(binary_message& m, flag_type flags = flag_none) override;
+                virtual error_code_type TryReceive(allocated_buffer& buf, flag_type flags = flag_none) override;
+
+                virtual size_type ReceiveScatter(const mutable_buffer_segment* const segs, size_type count, flag_type flags = flag_none) override;
+                virtual error_code_type TryReceiveScatter(const mutable_buffer_segment* const segs, size_type count
+                    , size_type& sz, flag_type flags = flag_none) override;
+
+                virtual error_code_type ReceiveBatch(std::vector<std::unique_ptr<binary_message>>& results
+                    , size_type max, const duration_type& timeout) override;
+
                 virtual void ReceiveAsync(basic_async_service* const svcp) override;
             };
         }
@@ -1,4 +1,7 @@
 #include "sub.h"
+#include "../../options/options.h"
+
+#include <unordered_set>
 
 namespace nng {
     namespace protocol {
@@ -7,13 +10,154 @@ namespace nng {
             using std::placeholders::_1;
             using std::bind;
 
+            // Bulk operations treat a topic listed more than once as though it were listed once.
+            std::vector<std::string> __distinct(const std::vector<std::string>& topics) {
+                std::unordered_set<std::string> seen;
+                std::vector<std::string> result;
+                result.reserve(topics.size());
+                for (const auto& topic : topics) {
+                    if (seen.insert(topic).second) { result.push_back(topic); }
+                }
+                return result;
+            }
+
             // While we could use nng_sub_open, I think it is sufficient to just use the versioned symbol.
-            sub_socket::sub_socket() : _Socket(bind(&(::nng_sub0_open), _1)) {
+            sub_socket::sub_socket() : _Socket(bind(&(::nng_sub0_open), _1))
+                , _subscriptions_mutex(), _subscriptions(), _local_filtering(false) {
             }
 
             sub_socket::~sub_socket() {
             }
 
+            void sub_socket::subscribe(const std::string& topic) {
+                if (!_subscriptions.Add(topic) || _local_filtering) { return; }
+                try {
+                    GetOptions()->SetString(option_names::sub_subscribe, topic);
+                }
+                catch (...) {
+                    // NNG never saw it, so neither should we.
+                    _subscriptions.Remove(topic);
+                    throw;
+                }
+            }
+
+            void sub_socket::unsubscribe(const std::string& topic) {
+                if (!_subscriptions.Remove(topic) || _local_filtering) { return; }
+                GetOptions()->SetString(option_names::sub_unsubscribe, topic);
+            }
+
+            bool sub_socket::Subscribe(const std::string& topic) {
+                std::lock_guard<std::mutex> guard(_subscriptions_mutex);
+                const auto count = _subscriptions.GetCount();
+                subscribe(topic);
+                return _subscriptions.GetCount() != count;
+            }
+
+            bool sub_socket::Subscribe(const std::string& topic, const handler_type& handler) {
+                std::lock_guard<std::mutex> guard(_subscriptions_mutex);
+                const auto count = _subscriptions.GetCount();
+                subscribe(topic);
+                _subscriptions.SetHandler(topic, handler);
+                return _subscriptions.GetCount() != count;
+            }
+
+            size_type sub_socket::Subscribe(const std::vector<std::string>& topics) {
+                std::lock_guard<std::mutex> guard(_subscriptions_mutex);
+                const auto count = _subscriptions.GetCount();
+                for (const auto& topic : __distinct(topics)) { subscribe(topic); }
+                return _subscriptions.GetCount() - count;
+            }
+
+            bool sub_socket::Unsubscribe(const std::string& topic) {
+                std::lock_guard<std::mutex> guard(_subscriptions_mutex);
+                const auto count = _subscriptions.GetCount();
+                unsubscribe(topic);
+                return _subscriptions.GetCount() != count;
+            }
+
+            size_type sub_socket::Unsubscribe(const std::vector<std::string>& topics) {
+                std::lock_guard<std::mutex> guard(_subscriptions_mutex);
+                const auto count = _subscriptions.GetCount();
+                for (const auto& topic : __distinct(topics)) { unsubscribe(topic); }
+                return count - _subscriptions.GetCount();
+            }
+
+            bool sub_socket::IsSubscribed(const std::string& topic) const {
+                std::lock_guard<std::mutex> guard(_subscriptions_mutex);
+                return _subscriptions.GetRefCount(topic) != 0;
+            }
+
+            size_type sub_socket::GetSubscriptionCount() const {
+                std::lock_guard<std::mutex> guard(_subscriptions_mutex);
+                return _subscriptions.GetCount();
+            }
+
+            std::vector<std::string> sub_socket::GetSubscriptions() const {
+                std::lock_guard<std::mutex> guard(_subscriptions_mutex);
+                return _subscriptions.GetTopics();
+            }
+
+            void sub_socket::EnableLocalFiltering() {
+
+                std::lock_guard<std::mutex> guard(_subscriptions_mutex);
+
+                if (_local_filtering) { return; }
+
+                const auto topics = _subscriptions.GetTopics();
+
+                // Subscribe to everything first so that nothing is missed in the meantime.
+                if (_subscriptions.GetRefCount(std::string()) == 0) {
+                    GetOptions()->SetString(option_names::sub_subscribe, std::string());
+                }
+
+                _local_filtering = true;
+
+                for (const auto& topic : topics) {
+                    if (topic.empty()) { continue; }
+                    GetOptions()->SetString(option_names::sub_unsubscribe, topic);
+                }
+            }
+
+            bool sub_socket::IsLocalFilteringEnabled() const {
+                std::lock_guard<std::mutex> guard(_subscriptions_mutex);
+                return _local_filtering;
+            }
+
+            error_code_type sub_socket::ReceiveMatching(binary_message& m, flag_type flags) {
+
+                while (true) {
+
+                    const auto ec = TryReceive(m, flags);
+
+                    if (ec != ec_enone) { return ec; }
+
+                    std::lock_guard<std::mutex> guard(_subscriptions_mutex);
+
+                    if (!_local_filtering) { return ec; }
+
+                    const auto view = m.GetBody()->GetView();
+
+                    if (_subscriptions.Matches(view.data(), view.GetSize())) { return ec; }
+                }
+            }
+
+            size_type sub_socket::Dispatch(binary_message& m) {
+
+                std::vector<subscription_trie::handler_ptr_type> handlers;
+
+                {
+                    std::lock_guard<std::mutex> guard(_subscriptions_mutex);
+                    const auto view = m.GetBody()->GetView();
+                    _subscriptions.GetHandlers(view.data(), view.GetSize(), handlers);
+                }
+
+                for (const auto& handlerp : handlers) {
+                    (*handlerp)(m);
+                }
+
+                return handlers.size();
+            }
+
             void sub_socket::Send(binary_message& m, flag_type flags) {
                 THROW_SOCKET_INV_OP(Subscribers, Send);
             }
@@ -26,6 +170,26 @@ namespace nng {
                 THROW_SOCKET_INV_OP(Subscribers, Send);
             }
 
+            error_code_type sub_socket::TrySend(binary_message& m, flag_type flags) {
+                THROW_SOCKET_INV_OP(Subscribers, TrySend);
+            }
+
+            error_code_type sub_socket::TrySend(const buffer_vector_type& buf, flag_type flags) {
+                THROW_SOCKET_INV_OP(Subscribers, TrySend);
+            }
+
+            void sub_socket::SendGather(const const_buffer_segment* const segs, size_type count, flag_type flags) {
+                THROW_SOCKET_INV_OP(Subscribers, SendGather);
+            }
+
+            error_code_type sub_socket::TrySendGather(const const_buffer_segment* const segs, size_type count, flag_type flags) {
+                THROW_SOCKET_INV_OP(Subscribers, TrySendGather);
+            }
+
+            std::vector<error_code_type> sub_socket::SendBatch(binary_message* const msgs, size_type count, flag_type flags) {
+                THROW_SOCKET_INV_OP(Subscribers, SendBatch);
+            }
+
             void sub_socket::SendAsync(const basic_async_service* const svcp) {
                 THROW_SOCKET_INV_OP(Subscribers, SendAsync);
             }
@@ -2,6 +2,11 @@
 #define CPPNNG_PROT_SUB_H
 
 #include "../../core/socket.h"
+#include "subscription_trie.h"
+
+#include <mutex>
+#include <string>
+#include <vector>
 
 namespace nng {
 
@@ -10,12 +15,71 @@ namespace nng {
         namespace v0 {
             
             class sub_socket : public _Socket {
+            public:
+
+                typedef subscription_trie::handler_type handler_type;
+
+            private:
+
+                mutable std::mutex _subscriptions_mutex;
+
+                subscription_trie _subscriptions;
+
+                bool _local_filtering;
+
+                // Expects the mutex to be held.
+                void subscribe(const std::string& topic);
+
+                // Expects the mutex to be held.
+                void unsubscribe(const std::string& topic);
+
             public:
 
                 sub_socket();
 
                 virtual ~sub_socket();
 
+                /* The subscription manager keeps its own count of each topic, and only conveys a
+                topic to NNG the first time it is subscribed, and the last time it is unsubscribed.
+                Bulk operations stop at the first failure, leaving prior topics as they are, and
+                count a topic listed more than once in the same call only once. */
+
+                // Returns whether the topic is new.
+                bool Subscribe(const std::string& topic);
+
+                // Subscribes and handles the topic, replacing any prior handler; see Dispatch.
+                bool Subscribe(const std::string& topic, const handler_type& handler);
+
+                // Returns how many of the topics are new, counting duplicates once.
+                size_type Subscribe(const std::vector<std::string>& topics);
+
+                // Returns whether the topic is gone.
+                bool Unsubscribe(const std::string& topic);
+
+                // Returns how many of the topics are gone, counting duplicates once.
+                size_type Unsubscribe(const std::vector<std::string>& topics);
+
+                bool IsSubscribed(const std::string& topic) const;
+
+                size_type GetSubscriptionCount() const;
+
+                std::vector<std::string> GetSubscriptions() const;
+
+                /* NNG checks each message against each subscription in turn, which does not scale
+                to thousands of topics. Instead, this subscribes NNG to everything once, and leaves
+                filtering to the trie, in ReceiveMatching and Dispatch. The plain receive methods
+                return every message after this. There is no going back. */
+                void EnableLocalFiltering();
+
+                bool IsLocalFilteringEnabled() const;
+
+                // Discards messages until one matches a subscription when filtering locally.
+                error_code_type ReceiveMatching(binary_message& m, flag_type flags = flag_none);
+
+                /* Invokes the handlers of every subscribed topic prefixing the message body, shortest
+                topic first, outside of any lock. Returns the number of handlers invoked. */
+                size_type Dispatch(binary_message& m);
+
             protected:
 
                 virtual void Send(binary_message& m, flag_type flags = flag_none) override;
@@ -23,6 +87,14 @@ namespace nng {
                 virtual void Send(const buffer_vector_type& buf, flag_type flags = flag_none) override;
                 virtual void Send(const buffer_vector_type& buf, size_type sz, flag_type flags = flag_none) override;
 
+                virtual error_code_type TrySend(binary_message& m, flag_type flags = flag_none) override;
+                virtual error_code_type TrySend(const buffer_vector_type& buf, flag_type flags = flag_none) override;
+
+                virtual void SendGather(const const_buffer_segment* const segs, size_type count, flag_type flags = flag_none) override;
+                virtual error_code_type TrySendGather(const const_buffer_segment* const segs, size_type count, flag_type flags = flag_none) override;
+
+                virtual std::vector<error_code_type> SendBatch(binary_message* const msgs, size_type count, flag_type flags = flag_none) override;
+
                 virtual void SendAsync(const basic_async_service* const svcp) override;
             };
         }
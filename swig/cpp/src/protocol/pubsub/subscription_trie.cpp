@@ -0,0 +1,222 @@
+#include "subscription_trie.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace nng {
+    namespace protocol {
+
+        struct _TopicNode {
+
+            typedef std::vector<std::unique_ptr<_TopicNode>> children_type;
+
+            // The run of bytes leading here from the parent; empty only for the root.
+            std::string label;
+
+            // Ordered by the first byte of each label, which is unique among siblings.
+            children_type children;
+
+            size_type refs;
+
+            _SubscriptionTrie::handler_ptr_type handlerp;
+
+            _TopicNode(const std::string& label)
+                : label(label), children(), refs(0), handlerp() {
+            }
+
+            static uint8_t first_of(const std::unique_ptr<_TopicNode>& x) {
+                return static_cast<uint8_t>(x->label[0]);
+            }
+
+            children_type::iterator lower_bound(uint8_t ch) {
+                return std::lower_bound(children.begin(), children.end(), ch
+                    , [](const std::unique_ptr<_TopicNode>& x, uint8_t y) { return first_of(x) < y; });
+            }
+
+            _TopicNode* find_child(uint8_t ch) const {
+                const auto it = const_cast<_TopicNode*>(this)->lower_bound(ch);
+                return it == children.end() || first_of(*it) != ch ? nullptr : it->get();
+            }
+        };
+
+        namespace {
+
+            // Follows the topic exactly, optionally recording the path taken, root first.
+            _TopicNode* find_topic(_TopicNode* const rootp, const std::string& topic
+                , std::vector<_TopicNode*>* const pathp = nullptr) {
+
+                auto nodep = rootp;
+                size_type pos = 0;
+
+                if (pathp) { pathp->push_back(nodep); }
+
+                while (pos < topic.size()) {
+                    nodep = nodep->find_child(static_cast<uint8_t>(topic[pos]));
+                    if (!nodep || topic.compare(pos, nodep->label.size(), nodep->label) != 0) { return nullptr; }
+                    pos += nodep->label.size();
+                    if (pathp) { pathp->push_back(nodep); }
+                }
+
+                return nodep;
+            }
+
+            // Visits the topics prefixing the data, shortest first.
+            template<class Visit_>
+            size_type visit_matches(const _TopicNode* const rootp, const void* datap, size_type sz, const Visit_& visit) {
+
+                const auto bytesp = static_cast<const char*>(datap);
+                auto nodep = rootp;
+                size_type pos = 0;
+                size_type matched = 0;
+
+                while (true) {
+                    if (nodep->refs) {
+                        ++matched;
+                        if (!visit(*nodep)) { break; }
+                    }
+                    if (pos == sz) { break; }
+                    nodep = nodep->find_child(static_cast<uint8_t>(bytesp[pos]));
+                    const auto n = nodep ? nodep->label.size() : 0;
+                    if (!nodep || sz - pos < n || std::memcmp(bytesp + pos, nodep->label.data(), n) != 0) { break; }
+                    pos += n;
+                }
+
+                return matched;
+            }
+
+            void collect_topics(const _TopicNode& node, std::string& prefix, std::vector<std::string>& topics) {
+                const auto sz = prefix.size();
+                prefix += node.label;
+                if (node.refs) { topics.push_back(prefix); }
+                for (const auto& childp : node.children) {
+                    collect_topics(*childp, prefix, topics);
+                }
+                prefix.resize(sz);
+            }
+        }
+
+        _SubscriptionTrie::_SubscriptionTrie()
+            : _rootp(std::make_unique<_TopicNode>(std::string())), _count(0) {
+        }
+
+        _SubscriptionTrie::~_SubscriptionTrie() {
+        }
+
+        bool _SubscriptionTrie::Add(const std::string& topic) {
+
+            auto nodep = _rootp.get();
+            size_type pos = 0;
+
+            while (pos < topic.size()) {
+
+                const auto it = nodep->lower_bound(static_cast<uint8_t>(topic[pos]));
+
+                if (it == nodep->children.end() || _TopicNode::first_of(*it) != static_cast<uint8_t>(topic[pos])) {
+                    // Nothing shares this prefix, so the rest of the topic becomes a single edge.
+                    nodep = nodep->children.insert(it, std::make_unique<_TopicNode>(topic.substr(pos)))->get();
+                    break;
+                }
+
+                auto& label = (*it)->label;
+                const auto n = std::min(label.size(), topic.size() - pos);
+                size_type common = 1;
+                while (common < n && label[common] == topic[pos + common]) { ++common; }
+
+                if (common < label.size()) {
+                    // Split the edge where the topic departs from it; the first byte stays the same.
+                    auto midp = std::make_unique<_TopicNode>(label.substr(0, common));
+                    label.erase(0, common);
+                    midp->children.push_back(std::move(*it));
+                    *it = std::move(midp);
+                }
+
+                nodep = it->get();
+                pos += common;
+            }
+
+            if (nodep->refs++ != 0) { return false; }
+
+            ++_count;
+            return true;
+        }
+
+        bool _SubscriptionTrie::Remove(const std::string& topic) {
+
+            std::vector<_TopicNode*> path;
+
+            const auto nodep = find_topic(_rootp.get(), topic, &path);
+
+            if (!nodep || nodep->refs == 0 || --nodep->refs != 0) { return false; }
+
+            nodep->handlerp.reset();
+            --_count;
+
+            // Prune dead leaves, then merge a pass-through node into its only child.
+            for (auto i = path.size() - 1; i > 0; i--) {
+
+                const auto currentp = path[i];
+                const auto parentp = path[i - 1];
+
+                if (currentp->refs) { break; }
+
+                if (currentp->children.empty()) {
+                    parentp->children.erase(parentp->lower_bound(static_cast<uint8_t>(currentp->label[0])));
+                    continue;
+                }
+
+                if (currentp->children.size() == 1) {
+                    auto childp = std::move(currentp->children.front());
+                    currentp->label += childp->label;
+                    currentp->children = std::move(childp->children);
+                    currentp->refs = childp->refs;
+                    currentp->handlerp = std::move(childp->handlerp);
+                }
+
+                break;
+            }
+
+            return true;
+        }
+
+        bool _SubscriptionTrie::SetHandler(const std::string& topic, const handler_type& handler) {
+            const auto nodep = find_topic(_rootp.get(), topic);
+            if (!nodep || nodep->refs == 0) { return false; }
+            nodep->handlerp = handler ? std::make_shared<const handler_type>(handler) : nullptr;
+            return true;
+        }
+
+        size_type _SubscriptionTrie::GetRefCount(const std::string& topic) const {
+            const auto nodep = find_topic(_rootp.get(), topic);
+            return nodep ? nodep->refs : 0;
+        }
+
+        size_type _SubscriptionTrie::GetCount() const {
+            return _count;
+        }
+
+        std::vector<std::string> _SubscriptionTrie::GetTopics() const {
+            std::vector<std::string> topics;
+            std::string prefix;
+            topics.reserve(_count);
+            collect_topics(*_rootp, prefix, topics);
+            return topics;
+        }
+
+        bool _SubscriptionTrie::Matches(const void* datap, size_type sz) const {
+            // The first match is enough.
+            return visit_matches(_rootp.get(), datap, sz, [](const _TopicNode&) { return false; }) != 0;
+        }
+
+        size_type _SubscriptionTrie::GetHandlers(const void* datap, size_type sz, std::vector<handler_ptr_type>& handlers) const {
+            return visit_matches(_rootp.get(), datap, sz, [&](const _TopicNode& node) {
+                if (node.handlerp) { handlers.push_back(node.handlerp); }
+                return true;
+            });
+        }
+
+        void _SubscriptionTrie::Clear() {
+            _rootp = std::make_unique<_TopicNode>(std::string());
+            _count = 0;
+        }
+    }
+}
@@ -0,0 +1,73 @@
+#ifndef CPPNNG_PROT_SUBSCRIPTION_TRIE_H
+#define CPPNNG_PROT_SUBSCRIPTION_TRIE_H
+
+#include "../../core/types.h"
+#include "../../messaging/binary_message.h"
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace nng {
+
+    namespace protocol {
+
+        // Defined alongside the trie.
+        struct _TopicNode;
+
+        /* Holds topics in a compact prefix, or radix, trie, whose edges are labeled with runs of
+        bytes rather than single bytes. Each topic is reference counted, so that subscribing to
+        the same topic twice takes two unsubscribes to undo, and may have a handler. Matching a
+        message visits only the topics along the path spelled by its leading bytes, regardless
+        of how many topics there are. The trie itself is not synchronized. */
+        class _SubscriptionTrie {
+        public:
+
+            typedef std::function<void(binary_message&)> handler_type;
+
+            typedef std::shared_ptr<const handler_type> handler_ptr_type;
+
+        private:
+
+            std::unique_ptr<_TopicNode> _rootp;
+
+            size_type _count;
+
+        public:
+
+            _SubscriptionTrie();
+
+            virtual ~_SubscriptionTrie();
+
+            // Returns whether the topic is new, i.e. its count went from zero to one.
+            bool Add(const std::string& topic);
+
+            // Returns whether the topic is gone, i.e. its count went from one to zero.
+            bool Remove(const std::string& topic);
+
+            // Returns false when the topic is not held, in which case there is nothing to handle.
+            bool SetHandler(const std::string& topic, const handler_type& handler);
+
+            size_type GetRefCount(const std::string& topic) const;
+
+            // Returns the number of distinct topics held.
+            size_type GetCount() const;
+
+            std::vector<std::string> GetTopics() const;
+
+            // Returns whether any of the topics prefixes the data.
+            bool Matches(const void* datap, size_type sz) const;
+
+            /* Appends the handlers of the topics prefixing the data, shortest topic first, and
+            returns the number of topics matched, with or without handlers. */
+            size_type GetHandlers(const void* datap, size_type sz, std::vector<handler_ptr_type>& handlers) const;
+
+            void Clear();
+        };
+
+        typedef _SubscriptionTrie subscription_trie;
+    }
+}
+
+#endif // CPPNNG_PROT_SUBSCRIPTION_TRIE_H
@@ -0,0 +1,162 @@
+#include "rep_server.h"
+#include "../../core/async.h"
+#include "../../options/options.h"
+#include "../../messaging/binary_message.h"
+
+#include <algorithm>
+#include <chrono>
+#include <mutex>
+#include <thread>
+
+namespace nng {
+    namespace protocol {
+
+        namespace {
+
+            // Persistent failures, i.e. ENOMEM, are retried no faster than this allows.
+            const std::chrono::milliseconds min_backoff(1);
+
+            const std::chrono::milliseconds max_backoff(100);
+        }
+
+        struct _ReplyWorker {
+
+            _ReplyServer* const serverp;
+
+            // Receives through an AIO, rather than blocking, so that Stop may cancel it.
+            basic_async_service svc;
+
+            // Guards starting a receive against Stop canceling before there is anything to cancel.
+            std::mutex mutex;
+
+            std::thread thread;
+
+            _ReplyWorker(_ReplyServer* const serverp)
+                : serverp(serverp), svc(), mutex(), thread() {
+            }
+
+            bool try_start_receive() {
+                std::lock_guard<std::mutex> guard(mutex);
+                if (serverp->_stopping) { return false; }
+                serverp->_s.ReceiveAsync(&svc);
+                return true;
+            }
+
+            void cancel() {
+                std::lock_guard<std::mutex> guard(mutex);
+                svc.Cancel();
+            }
+
+            void run() {
+
+                auto& server = *serverp;
+
+                binary_message bm;
+
+                auto backoff = min_backoff;
+
+                while (try_start_receive()) {
+
+                    svc.Wait();
+
+                    const auto ec = svc.GetResult();
+
+                    if (ec == ec_eclosed) { break; }
+
+                    // Canceled, or timed out, is simply another go around.
+                    if (ec == ec_ecanceled || ec == ec_etimedout) { continue; }
+
+                    // Anything else would likely fail again straight away, so back off first.
+                    if (ec != ec_enone) {
+                        std::this_thread::sleep_for(backoff);
+                        backoff = std::min(backoff * 2, max_backoff);
+                        continue;
+                    }
+
+                    backoff = min_backoff;
+
+                    svc >> bm;
+
+                    ++server._busy;
+
+                    bool replying = false;
+
+                    try {
+                        replying = server._handler(bm);
+                    }
+                    catch (...) {
+                        // There is nowhere for the exception to go on this thread.
+                    }
+
+                    if (replying && server._s.TrySend(bm) == ec_enone) {
+                        ++server._replied;
+                    }
+                    else {
+                        ++server._dropped;
+                    }
+
+                    --server._busy;
+                }
+            }
+        };
+
+        _ReplyServer::_ReplyServer(v0::rep_socket& s, size_type workers, const handler_type& handler)
+            : _s(s), _handler(handler), _workers(), _stopping(false), _busy(0), _replied(0), _dropped(0) {
+
+            _s.GetOptions()->SetInt32(option_names::raw, 1);
+
+            if (workers == 0) { workers = 1; }
+
+            // Allocate everything before starting anything, so that a failure leaves nothing running.
+            for (size_type i = 0; i < workers; i++) {
+                _workers.push_back(std::make_unique<_ReplyWorker>(this));
+            }
+
+            try {
+                for (auto& wp : _workers) {
+                    const auto workerp = wp.get();
+                    wp->thread = std::thread([workerp]() { workerp->run(); });
+                }
+            }
+            catch (...) {
+                // Otherwise the workers already running would terminate the program on the way out.
+                Stop();
+                throw;
+            }
+        }
+
+        _ReplyServer::~_ReplyServer() {
+            Stop();
+        }
+
+        void _ReplyServer::Stop() {
+
+            _stopping = true;
+
+            // Idle workers are waiting on a receive, whereas busy ones finish their reply first.
+            for (auto& wp : _workers) {
+                wp->cancel();
+            }
+
+            for (auto& wp : _workers) {
+                if (wp->thread.joinable()) { wp->thread.join(); }
+            }
+        }
+
+        size_type _ReplyServer::GetWorkerCount() const {
+            return _workers.size();
+        }
+
+        size_type _ReplyServer::GetBusyCount() const {
+            return _busy;
+        }
+
+        uint64_t _ReplyServer::GetRepliedCount() const {
+            return _replied;
+        }
+
+        uint64_t _ReplyServer::GetDroppedCount() const {
+            return _dropped;
+        }
+    }
+}
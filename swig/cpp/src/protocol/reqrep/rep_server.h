@@ -0,0 +1,81 @@
+#ifndef CPPNNG_PROT_REP_SERVER_H
+#define CPPNNG_PROT_REP_SERVER_H
+
+#include "rep.h"
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace nng {
+
+    namespace protocol {
+
+        // Defined alongside the server.
+        struct _ReplyWorker;
+
+        /* Serves requests from a raw mode rep socket on a number of worker threads, each of
+        which receives a request, hands it to the handler, and sends back the reply. Raw mode
+        leaves the backtrace in the message header, which is how each reply finds its way back,
+        so replies may be produced concurrently and in any order.
+
+        Once every worker is busy, nothing more is received, so requests queue up in the socket
+        receive buffer and then back up toward their senders, which is the backpressure.
+
+        The server switches the socket to raw mode, and the socket must outlive the server. */
+        class _ReplyServer {
+        public:
+
+            /* The handler turns the request into its reply in place, i.e. it rewrites the body,
+            leaving the header alone. Returning false, or throwing, drops the request, and the
+            requestor eventually resends it. */
+            typedef std::function<bool(binary_message&)> handler_type;
+
+        private:
+
+            friend struct _ReplyWorker;
+
+            v0::rep_socket& _s;
+
+            handler_type _handler;
+
+            std::vector<std::unique_ptr<_ReplyWorker>> _workers;
+
+            std::atomic<bool> _stopping;
+
+            std::atomic<size_type> _busy;
+
+            std::atomic<uint64_t> _replied;
+
+            std::atomic<uint64_t> _dropped;
+
+        public:
+
+            _ReplyServer(v0::rep_socket& s, size_type workers, const handler_type& handler);
+
+            _ReplyServer(const _ReplyServer&) = delete;
+
+            _ReplyServer& operator=(const _ReplyServer&) = delete;
+
+            virtual ~_ReplyServer();
+
+            // Stops receiving and waits for the requests in hand to be replied to.
+            void Stop();
+
+            size_type GetWorkerCount() const;
+
+            // Returns how many workers are handling requests at the moment.
+            size_type GetBusyCount() const;
+
+            uint64_t GetRepliedCount() const;
+
+            // Counts requests the handler declined or threw on, as well as replies that failed to send.
+            uint64_t GetDroppedCount() const;
+        };
+
+        typedef _ReplyServer reply_server;
+    }
+}
+
+#endif // CPPNNG_PROT_REP_SERVER_H
@@ -0,0 +1,258 @@
+#include "req_client.h"
+#include "../../options/options.h"
+#include "../../messaging/binary_message.h"
+#include "../../core/exceptions.hpp"
+
+#include <vector>
+
+namespace nng {
+    namespace protocol {
+
+        struct _OutstandingRequest {
+
+            async_promise promise;
+
+            // Pending requests without a timeout have no deadline, i.e. the end of the map.
+            std::multimap<_RequestClient::clock_type::time_point, uint32_t>::iterator deadline;
+
+            _OutstandingRequest(const async_promise& promise)
+                : promise(promise), deadline() {
+            }
+        };
+
+        namespace {
+
+            // Request IDs always have the high bit set, the same as the cooked protocol.
+            const uint32_t request_id_bit = 0x80000000;
+
+            const size_type request_id_size = sizeof(uint32_t);
+        }
+
+        _RequestClient::_RequestClient(v0::req_socket& s)
+            : _s(s), _default_timeout(), _mutex(), _cv(), _requests(), _deadlines()
+            , _next_id(static_cast<request_id_type>(clock_type::now().time_since_epoch().count()))
+            , _stopping(false), _receive_ec(ec_enone), _timer(), _receiverp() {
+
+            using O = option_names;
+
+            _default_timeout = _s.GetOptions()->GetDuration(O::req_resend_duration);
+            _s.GetOptions()->SetInt32(O::raw, 1);
+
+            _receiverp = std::make_unique<aio_pool>(1);
+
+            // Prior to starting the timer, which would otherwise need joining on the way out.
+            if (!start_receive()) { THROW_NNG_EXCEPTION_EC(ec_ebusy); }
+
+            _timer = std::thread(&_RequestClient::run_timer, this);
+        }
+
+        _RequestClient::~_RequestClient() {
+
+            {
+                std::lock_guard<std::mutex> guard(_mutex);
+                _stopping = true;
+            }
+
+            _cv.notify_all();
+            _timer.join();
+
+            // Cancels the receive, and waits for its handler, which does not reissue it.
+            _receiverp.reset();
+
+            request_map_type requests;
+
+            {
+                std::lock_guard<std::mutex> guard(_mutex);
+                requests.swap(_requests);
+                _deadlines.clear();
+            }
+
+            for (auto& x : requests) {
+                x.second->promise.SetResult(ec_ecanceled);
+            }
+        }
+
+        _RequestClient::request_id_type _RequestClient::get_next_id() {
+            request_id_type id;
+            // Wrapping around onto a request still outstanding is unlikely, but not impossible.
+            do { id = _next_id++ | request_id_bit; } while (_requests.find(id) != _requests.end());
+            return id;
+        }
+
+        std::unique_ptr<_OutstandingRequest> _RequestClient::take(request_id_type id) {
+
+            const auto it = _requests.find(id);
+
+            if (it == _requests.end()) { return nullptr; }
+
+            auto rp = std::move(it->second);
+            _requests.erase(it);
+
+            if (rp->deadline != _deadlines.end()) { _deadlines.erase(rp->deadline); }
+
+            return rp;
+        }
+
+        bool _RequestClient::start_receive() {
+            // From within the handler, this reissues the AIO being handled.
+            return _receiverp->TryReceive(_s, [this](error_code_type ec, _Message& m) { on_received(ec, m); });
+        }
+
+        void _RequestClient::on_received(error_code_type ec, _Message& m) {
+
+            if (ec == ec_enone) {
+
+                std::unique_ptr<_OutstandingRequest> rp;
+
+                // Raw mode leaves the request ID at the front of the header.
+                if (m.GetHeader()->GetSize() >= request_id_size) {
+                    request_id_type id = 0;
+                    m.GetHeader()->TrimLeft(&id);
+                    std::lock_guard<std::mutex> guard(_mutex);
+                    rp = take(id);
+                }
+
+                // Otherwise the reply is late, or a duplicate, and the pool frees it.
+                if (rp) {
+                    rp->promise.SetResult(ec_enone, std::make_unique<binary_message>(m.cede_message()));
+                }
+            }
+
+            request_map_type failed;
+            error_code_type failure;
+
+            {
+                std::lock_guard<std::mutex> guard(_mutex);
+
+                if (_stopping) { return; }
+
+                if (ec != ec_eclosed && start_receive()) { return; }
+
+                // Nothing more will arrive, so neither outstanding nor later requests can complete.
+                failure = _receive_ec = ec == ec_eclosed ? ec_eclosed : ec_ebusy;
+                failed.swap(_requests);
+                _deadlines.clear();
+            }
+
+            for (auto& x : failed) {
+                x.second->promise.SetResult(failure);
+            }
+        }
+
+        void _RequestClient::run_timer() {
+
+            std::unique_lock<std::mutex> lock(_mutex);
+
+            while (!_stopping) {
+
+                if (_deadlines.empty()) {
+                    _cv.wait(lock);
+                    continue;
+                }
+
+                const auto now = clock_type::now();
+
+                if (now < _deadlines.begin()->first) {
+                    _cv.wait_until(lock, _deadlines.begin()->first);
+                    continue;
+                }
+
+                std::vector<std::unique_ptr<_OutstandingRequest>> expired;
+
+                while (!_deadlines.empty() && _deadlines.begin()->first <= now) {
+                    expired.push_back(take(_deadlines.begin()->second));
+                }
+
+                // Continuations may well issue more requests.
+                lock.unlock();
+
+                for (auto& rp : expired) {
+                    rp->promise.SetResult(ec_etimedout);
+                }
+
+                lock.lock();
+            }
+        }
+
+        async_future _RequestClient::Request(binary_message&& m) {
+            return Request(std::move(m), _default_timeout);
+        }
+
+        async_future _RequestClient::Request(binary_message&& m, const duration_type& timeout) {
+
+            const async_promise promise;
+            const auto future = promise.GetFuture();
+
+            request_id_type id;
+            bool earliest = false;
+            error_code_type failure;
+
+            {
+                std::lock_guard<std::mutex> guard(_mutex);
+
+                failure = _receive_ec;
+
+                if (failure == ec_enone) {
+                    id = get_next_id();
+
+                    auto rp = std::make_unique<_OutstandingRequest>(promise);
+
+                    // Negative durations, i.e. infinite, never expire.
+                    if (timeout.count() < 0) {
+                        rp->deadline = _deadlines.end();
+                    }
+                    else {
+                        rp->deadline = _deadlines.emplace(clock_type::now() + timeout, id);
+                        earliest = rp->deadline == _deadlines.begin();
+                    }
+
+                    _requests.emplace(id, std::move(rp));
+                }
+            }
+
+            // Replies can no longer arrive, so the request goes straight back.
+            if (failure != ec_enone) {
+                promise.SetResult(failure, std::make_unique<binary_message>(m.cede_message()));
+                return future;
+            }
+
+            // The timer only needs to hear about a deadline sooner than the one it is waiting on.
+            if (earliest) { _cv.notify_all(); }
+
+            m.GetHeader()->Append(id);
+
+            const auto ec = _s.TrySend(m);
+
+            if (ec != ec_enone) {
+                std::unique_ptr<_OutstandingRequest> rp;
+                {
+                    std::lock_guard<std::mutex> guard(_mutex);
+                    rp = take(id);
+                }
+                // The request may have timed out in the meantime, in which case there is nothing to do.
+                if (rp) {
+                    rp->promise.SetResult(ec, std::make_unique<binary_message>(m.cede_message()));
+                }
+            }
+
+            return future;
+        }
+
+        void _RequestClient::Request(binary_message&& m, const reply_handler_type& on_reply) {
+            Request(std::move(m)).OnReady(on_reply);
+        }
+
+        void _RequestClient::Request(binary_message&& m, const duration_type& timeout, const reply_handler_type& on_reply) {
+            Request(std::move(m), timeout).OnReady(on_reply);
+        }
+
+        size_type _RequestClient::GetOutstandingCount() {
+            std::lock_guard<std::mutex> guard(_mutex);
+            return _requests.size();
+        }
+
+        duration_type _RequestClient::GetDefaultTimeout() const {
+            return _default_timeout;
+        }
+    }
+}
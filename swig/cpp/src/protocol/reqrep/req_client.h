@@ -0,0 +1,115 @@
+#ifndef CPPNNG_PROT_REQ_CLIENT_H
+#define CPPNNG_PROT_REQ_CLIENT_H
+
+#include "req.h"
+#include "../../core/async.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+namespace nng {
+
+    namespace protocol {
+
+        // Defined alongside the client.
+        struct _OutstandingRequest;
+
+        /* Pipelines requests over a raw mode req socket, rather than waiting for each reply in
+        turn. Each request is stamped with its own request ID in the message header, the same as
+        the cooked protocol would, and the reply carrying that ID completes the request, in
+        whatever order replies arrive. Raw mode does not resend, so requests are failed with
+        ec_etimedout instead, by default after the socket resend duration.
+
+        The client switches the socket to raw mode, and the socket must outlive the client. */
+        class _RequestClient {
+        public:
+
+            typedef std::chrono::steady_clock clock_type;
+
+            typedef std::function<void(async_future&)> reply_handler_type;
+
+        private:
+
+            typedef uint32_t request_id_type;
+
+            typedef std::multimap<clock_type::time_point, request_id_type> deadline_map_type;
+
+            typedef std::unordered_map<request_id_type, std::unique_ptr<_OutstandingRequest>> request_map_type;
+
+            v0::req_socket& _s;
+
+            duration_type _default_timeout;
+
+            std::mutex _mutex;
+
+            std::condition_variable _cv;
+
+            request_map_type _requests;
+
+            deadline_map_type _deadlines;
+
+            request_id_type _next_id;
+
+            bool _stopping;
+
+            // Why replies stopped arriving, i.e. the socket closed; ec_enone while they still can.
+            error_code_type _receive_ec;
+
+            std::thread _timer;
+
+            // Keeps one receive outstanding, which the receive handler reissues.
+            std::unique_ptr<aio_pool> _receiverp;
+
+            // Expects the mutex to be held.
+            request_id_type get_next_id();
+
+            // Expects the mutex to be held; returns the outstanding request, if any.
+            std::unique_ptr<_OutstandingRequest> take(request_id_type id);
+
+            // Returns whether the receive was issued.
+            bool start_receive();
+
+            void on_received(error_code_type ec, _Message& m);
+
+            void run_timer();
+
+        public:
+
+            _RequestClient(v0::req_socket& s);
+
+            _RequestClient(const _RequestClient&) = delete;
+
+            _RequestClient& operator=(const _RequestClient&) = delete;
+
+            // Fails whatever is still outstanding with ec_ecanceled.
+            virtual ~_RequestClient();
+
+            /* The future completes with the reply, or fails. When the send itself fails, the
+            future returns the request, which then still carries the request ID in its header.
+            Once replies can no longer arrive, i.e. the socket closed, requests fail straight away
+            and the future returns them untouched. */
+            async_future Request(binary_message&& m);
+
+            async_future Request(binary_message&& m, const duration_type& timeout);
+
+            // The handler runs on whichever thread completes the request; see async_future.
+            void Request(binary_message&& m, const reply_handler_type& on_reply);
+
+            void Request(binary_message&& m, const duration_type& timeout, const reply_handler_type& on_reply);
+
+            size_type GetOutstandingCount();
+
+            duration_type GetDefaultTimeout() const;
+        };
+
+        typedef _RequestClient request_client;
+    }
+}
+
+#endif // CPPNNG_PROT_REQ_CLIENT_H
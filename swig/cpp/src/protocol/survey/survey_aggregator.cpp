@@ -0,0 +1,124 @@
+#include "survey_aggregator.h"
+#include "../../messaging/binary_message.h"
+
+namespace nng {
+    namespace protocol {
+
+        _SurveyResult::_SurveyResult() : ec(ec_enone), responses(0) {
+        }
+
+        struct _SurveyOperation {
+
+            _SurveyAggregator* const aggp;
+
+            const _SurveyAggregator::response_handler_type on_response;
+
+            const size_type quorum;
+
+            size_type responses;
+
+            const async_promise promise;
+
+            _SurveyOperation(_SurveyAggregator* const aggp
+                , const _SurveyAggregator::response_handler_type& on_response, size_type quorum)
+                : aggp(aggp), on_response(on_response), quorum(quorum), responses(0), promise() {
+            }
+
+            void finish(error_code_type ec) {
+                // Clear the way first, so that continuations may start the next survey.
+                aggp->_surveying = false;
+                promise.SetResult(ec);
+            }
+
+            // Returns whether to keep going.
+            bool on_received(binary_message& m) {
+                ++responses;
+                try {
+                    if (!on_response(m)) { return false; }
+                }
+                catch (...) {
+                    return false;
+                }
+                return quorum == 0 || responses < quorum;
+            }
+        };
+
+        _SurveyAggregator::_SurveyAggregator(v0::survey_socket& s)
+            : _s(s), _surveying(false), _receiverp(std::make_unique<aio_pool>(2)) {
+        }
+
+        _SurveyAggregator::~_SurveyAggregator() {
+            // Waits for the receive under way, if any, to complete as canceled.
+            _receiverp.reset();
+        }
+
+        bool _SurveyAggregator::IsSurveying() const {
+            return _surveying;
+        }
+
+        _SurveyResult _SurveyAggregator::Survey(binary_message& m, const response_handler_type& on_response, size_type quorum) {
+
+            _SurveyResult result;
+
+            if (_surveying.exchange(true)) {
+                result.ec = ec_ebusy;
+                return result;
+            }
+
+            // The handler may throw, which is allowed on the caller's own thread.
+            struct __surveying_guard {
+                std::atomic<bool>& surveying;
+                ~__surveying_guard() { surveying = false; }
+            } guard = { _surveying };
+
+            if ((result.ec = _s.TrySend(m)) != ec_enone) { return result; }
+
+            binary_message bm;
+
+            while ((result.ec = _s.TryReceive(bm)) == ec_enone) {
+                ++result.responses;
+                if (!on_response(bm) || (quorum && result.responses >= quorum)) { break; }
+            }
+
+            return result;
+        }
+
+        bool _SurveyAggregator::receive_next(const std::shared_ptr<_SurveyOperation>& opp) {
+            // From within the handler, this reissues the AIO being handled.
+            return _receiverp->TryReceive(_s, [opp](error_code_type ec, _Message& m) {
+                if (ec != ec_enone) {
+                    opp->finish(ec);
+                }
+                else if (!opp->on_received(m)) {
+                    opp->finish(ec_enone);
+                }
+                else if (!opp->aggp->receive_next(opp)) {
+                    opp->finish(ec_ebusy);
+                }
+            });
+        }
+
+        async_future _SurveyAggregator::SurveyAsync(binary_message&& m, const response_handler_type& on_response, size_type quorum) {
+
+            const auto opp = std::make_shared<_SurveyOperation>(this, on_response, quorum);
+            const auto future = opp->promise.GetFuture();
+
+            if (_surveying.exchange(true)) {
+                opp->promise.SetResult(ec_ebusy);
+                return future;
+            }
+
+            // The surveyor refuses to receive until the survey is out, so that goes first.
+            const auto ec = _s.TrySend(m);
+
+            if (ec != ec_enone) {
+                opp->finish(ec);
+                return future;
+            }
+
+            if (!receive_next(opp)) { opp->finish(ec_ebusy); }
+
+            return future;
+        }
+    }
+}
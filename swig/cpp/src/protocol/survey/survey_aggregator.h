@@ -0,0 +1,101 @@
+#ifndef CPPNNG_PROT_SURVEY_AGGREGATOR_H
+#define CPPNNG_PROT_SURVEY_AGGREGATOR_H
+
+#include "survey.h"
+#include "../../core/async.h"
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <utility>
+
+namespace nng {
+
+    namespace protocol {
+
+        // Defined alongside the aggregator.
+        struct _SurveyOperation;
+
+        struct _SurveyResult {
+
+            /* Why the survey ended: ec_enone when the quorum was reached or the handler said so,
+            ec_etimedout when the survey duration expired, which is the usual way for a survey
+            without a quorum to end, or else whatever failed, i.e. ec_ebusy when another survey
+            is already under way. */
+            error_code_type ec;
+
+            size_type responses;
+
+            _SurveyResult();
+        };
+
+        /* Sends a survey, then hands each response to a handler as it arrives, rather than
+        collecting them, until the survey duration expires, the quorum is reached, or the handler
+        returns false. Stopping early does not wait for stragglers; the surveyor discards their
+        responses once the next survey goes out. One survey at a time, the same as the socket.
+
+        The socket must outlive the aggregator. */
+        class _SurveyAggregator {
+        public:
+
+            // Returns whether to keep going.
+            typedef std::function<bool(binary_message&)> response_handler_type;
+
+        private:
+
+            friend struct _SurveyOperation;
+
+            v0::survey_socket& _s;
+
+            std::atomic<bool> _surveying;
+
+            /* Two, since a survey finishes from within its own receive handler, which may still be
+            returning its AIO when the next survey starts on another thread. */
+            std::unique_ptr<aio_pool> _receiverp;
+
+            // Returns whether the receive was issued.
+            bool receive_next(const std::shared_ptr<_SurveyOperation>& opp);
+
+        public:
+
+            _SurveyAggregator(v0::survey_socket& s);
+
+            _SurveyAggregator(const _SurveyAggregator&) = delete;
+
+            _SurveyAggregator& operator=(const _SurveyAggregator&) = delete;
+
+            // Cancels an asynchronous survey under way.
+            virtual ~_SurveyAggregator();
+
+            // A quorum of zero means every response until the survey duration expires.
+            _SurveyResult Survey(binary_message& m, const response_handler_type& on_response, size_type quorum = 0);
+
+            /* Runs the survey on NNG threads, where the handler is invoked, and must not throw.
+            The future completes with the same error code that Survey would have returned. */
+            async_future SurveyAsync(binary_message&& m, const response_handler_type& on_response, size_type quorum = 0);
+
+            /* Folds each response into the accumulator, i.e. acc = reduce(std::move(acc), response),
+            without keeping the responses themselves. */
+            template<typename Acc_, class Reducer_>
+            Acc_ Fold(binary_message& m, Acc_ acc, const Reducer_& reduce, size_type quorum = 0
+                , _SurveyResult* const resultp = nullptr) {
+
+                const auto result = Survey(m, [&](binary_message& response) {
+                    acc = reduce(std::move(acc), response);
+                    return true;
+                }, quorum);
+
+                if (resultp) { *resultp = result; }
+
+                return acc;
+            }
+
+            bool IsSurveying() const;
+        };
+
+        typedef _SurveyResult survey_result;
+        typedef _SurveyAggregator survey_aggregator;
+    }
+}
+
+#endif // CPPNNG_PROT_SURVEY_AGGREGATOR_H
@@ -0,0 +1,180 @@
+//
+// Copyright (c) 2017 Michael W Powell <mwpowellhtx@gmail.com>
+//
+// This software is supplied under the terms of the MIT License, a
+// copy of which should be located in the distribution where this
+// file was obtained (LICENSE.txt).  A copy of the license may also be
+// found online at https://opensource.org/licenses/MIT.
+//
+
+#include <nngcpp.h>
+
+#include "../../catch/catch_exception_translations.hpp"
+#include "../../catch/catch_nng_exception_matcher.hpp"
+#include "../../catch/catch_tags.h"
+#include "../../catch/catch_macros.hpp"
+
+#include "../../helpers/basic_fixture.h"
+#include "../../helpers/constants.h"
+
+#include <atomic>
+#include <thread>
+
+namespace constants {
+
+    const std::string pool_addr = "inproc://pool";
+
+    const std::string hello = "hello";
+    const auto hello_buf = to_buffer(hello);
+
+    const int pool_size = 4;
+    const int message_count = 1000;
+}
+
+namespace nng {
+
+    // Catch v1 is not thread safe, so handlers only count things for the test thread to verify.
+    bool wait_until(const std::function<bool()>& done, const std::chrono::milliseconds& timeout) {
+        const auto deadline = std::chrono::steady_clock::now() + timeout;
+        while (!done() && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return done();
+    }
+}
+
+TEST_CASE("AIO pool leases and returns AIOs using C++ wrapper", Catch::Tags(
+    "async", "pool", "sockets", "cxx").c_str()) {
+
+    using namespace std;
+    using namespace nng;
+    using namespace nng::protocol;
+    using namespace constants;
+
+    basic_fixture fixture;
+
+    unique_ptr<aio_pool> poolp;
+
+    REQUIRE_NOTHROW(poolp = make_unique<aio_pool>(pool_size, 1000ms));
+    REQUIRE(poolp->GetCapacity() == pool_size);
+    REQUIRE(poolp->GetLeased() == 0);
+
+    SECTION("Given a connected pair of sockets") {
+
+        unique_ptr<latest_pair_socket> sp1, sp2;
+
+        REQUIRE_NOTHROW(sp1 = make_unique<latest_pair_socket>());
+        REQUIRE_NOTHROW(sp2 = make_unique<latest_pair_socket>());
+
+        REQUIRE_NOTHROW(sp1->Listen(pool_addr));
+        REQUIRE_NOTHROW(sp2->Dial(pool_addr));
+
+        SECTION("Leases are exhausted and returned") {
+
+            atomic<int> received(0);
+
+            for (int i = 0; i < pool_size; i++) {
+                REQUIRE(poolp->TryReceive(*sp2, [&](error_code_type ec, binary_message& m) {
+                    if (ec == ec_enone && m.HasOne()) { ++received; }
+                }) == true);
+            }
+
+            REQUIRE(poolp->GetLeased() == pool_size);
+            REQUIRE(poolp->TryReceive(*sp2, nullptr) == false);
+
+            binary_message bm;
+            REQUIRE_NOTHROW(bm << hello);
+            // Leaves the message alone when there is nothing to lease.
+            REQUIRE(poolp->TrySend(*sp1, bm, nullptr) == false);
+            REQUIRE(bm.HasOne() == true);
+
+            for (int i = 0; i < pool_size; i++) {
+                REQUIRE_NOTHROW(sp1->Send(hello_buf));
+            }
+
+            REQUIRE(wait_until([&]() { return received == pool_size && poolp->GetLeased() == 0; }, 1000ms));
+        }
+
+        SECTION("Handlers may issue the next operation on the same pool") {
+
+            atomic<int> sent(0), received(0), failed(0);
+
+            aio_pool::handler_type on_received;
+
+            on_received = [&](error_code_type ec, binary_message& m) {
+                if (ec != ec_enone) { ++failed; return; }
+                if (m.GetBody()->Get() == hello_buf) { ++received; }
+                // Reissues the AIO being handled, so there is always one for it.
+                if (received + failed < message_count && !poolp->TryReceive(*sp2, on_received)) { ++failed; }
+            };
+
+            REQUIRE(poolp->TryReceive(*sp2, on_received) == true);
+
+            for (int i = 0; i < message_count; i++) {
+                binary_message bm;
+                REQUIRE_NOTHROW(bm << hello);
+                // The pool may momentarily be fully leased.
+                while (!poolp->TrySend(*sp1, bm, [&](error_code_type ec, binary_message&) {
+                    if (ec == ec_enone) { ++sent; } else { ++failed; }
+                })) {
+                    this_thread::yield();
+                }
+            }
+
+            REQUIRE(wait_until([&]() { return received + failed == message_count && poolp->GetLeased() == 0; }, 5000ms));
+            REQUIRE(failed == 0);
+            REQUIRE(sent == message_count);
+            REQUIRE(received == message_count);
+        }
+
+        SECTION("A pool of one chains from its own handler") {
+
+            aio_pool single(1, 1000ms);
+
+            atomic<int> received(0), failed(0);
+
+            aio_pool::handler_type on_received;
+
+            on_received = [&](error_code_type ec, binary_message&) {
+                if (ec != ec_enone) { ++failed; return; }
+                if (++received < 3 && !single.TryReceive(*sp2, on_received)) { ++failed; }
+            };
+
+            REQUIRE(single.TryReceive(*sp2, on_received) == true);
+
+            for (int i = 0; i < 3; i++) {
+                REQUIRE_NOTHROW(sp1->Send(hello_buf));
+            }
+
+            REQUIRE(wait_until([&]() { return received == 3 && single.GetLeased() == 0; }, 2000ms));
+            REQUIRE(failed == 0);
+        }
+
+        SECTION("Failed sends hand the message back") {
+
+            atomic<bool> done(false), returned(false);
+
+            REQUIRE_NOTHROW(sp2.reset());
+
+            binary_message bm;
+            REQUIRE_NOTHROW(bm << hello);
+
+            // Nobody is listening, so the send times out and the handler receives the message back.
+            REQUIRE(poolp->TrySend(*sp1, bm, [&](error_code_type ec, binary_message& m) {
+                returned = ec == ec_etimedout && m.HasOne() && m.GetBody()->Get() == hello_buf;
+                done = true;
+            }) == true);
+
+            REQUIRE(wait_until([&]() { return done.load(); }, 2000ms));
+            REQUIRE(returned == true);
+        }
+    }
+
+    // Any operations still in flight are canceled here.
+    REQUIRE_NOTHROW(poolp.reset());
+
+    SECTION("Pools larger than the slot index allows are rejected") {
+        REQUIRE_THROWS_AS_MATCHING(make_unique<aio_pool>(static_cast<size_type>(UINT32_MAX))
+            , nng_exception, THROWS_NNG_EXCEPTION(ec_einval));
+    }
+}
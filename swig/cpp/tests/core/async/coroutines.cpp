@@ -0,0 +1,183 @@
+//
+// Copyright (c) 2017 Michael W Powell <mwpowellhtx@gmail.com>
+//
+// This software is supplied under the terms of the MIT License, a
+// copy of which should be located in the distribution where this
+// file was obtained (LICENSE.txt).  A copy of the license may also be
+// found online at https://opensource.org/licenses/MIT.
+//
+
+#include <nngcpp.h>
+
+#include "../../catch/catch_exception_translations.hpp"
+#include "../../catch/catch_nng_exception_matcher.hpp"
+#include "../../catch/catch_tags.h"
+#include "../../catch/catch_macros.hpp"
+
+#include "../../helpers/basic_fixture.h"
+#include "../../helpers/constants.h"
+
+#include <atomic>
+#include <coroutine>
+#include <exception>
+#include <thread>
+
+namespace constants {
+
+    const std::string coro_addr = "inproc://coro";
+
+    const std::string hello = "hello";
+    const auto hello_buf = to_buffer(hello);
+
+    const int round_trips = 1000;
+}
+
+namespace nng {
+
+    // Just enough of a task to drive the awaitables: it starts eagerly and is destroyed by its owner.
+    struct test_task {
+
+        struct promise_type {
+
+            test_task get_return_object() {
+                return test_task(std::coroutine_handle<promise_type>::from_promise(*this));
+            }
+
+            std::suspend_never initial_suspend() noexcept { return {}; }
+
+            std::suspend_always final_suspend() noexcept { return {}; }
+
+            void return_void() {}
+
+            void unhandled_exception() { std::terminate(); }
+        };
+
+        std::coroutine_handle<promise_type> h;
+
+        explicit test_task(std::coroutine_handle<promise_type> h) : h(h) {}
+
+        test_task(test_task&& other) : h(other.h) { other.h = nullptr; }
+
+        ~test_task() { if (h) { h.destroy(); } }
+    };
+
+    /* Catch v1 is not thread safe, and the coroutines resume on NNG threads, so we only count
+    things there and verify them back on the test thread. */
+    bool wait_for(const std::atomic<bool>& done, const std::chrono::milliseconds& timeout) {
+        const auto deadline = std::chrono::steady_clock::now() + timeout;
+        while (!done && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return done;
+    }
+}
+
+TEST_CASE("Coroutine awaitables using C++ wrapper", Catch::Tags(
+    "async", "coroutines", "sockets", "cxx").c_str()) {
+
+    using namespace std;
+    using namespace nng;
+    using namespace nng::protocol;
+    using namespace nng::exceptions;
+    using namespace constants;
+    using O = option_names;
+
+    basic_fixture fixture;
+
+    SECTION("Given a connected pair of sockets") {
+
+        unique_ptr<latest_pair_socket> sp1, sp2;
+
+        REQUIRE_NOTHROW(sp1 = make_unique<latest_pair_socket>());
+        REQUIRE_NOTHROW(sp2 = make_unique<latest_pair_socket>());
+
+        REQUIRE_NOTHROW(sp1->Listen(coro_addr));
+        REQUIRE_NOTHROW(sp2->Dial(coro_addr));
+
+        SECTION("Round trips may be awaited without blocking a thread apiece") {
+
+            atomic<int> echoed(0), matched(0), failed(0);
+            atomic<bool> done(false);
+
+            const auto echo = [&]() -> test_task {
+                try {
+                    for (int i = 0; i < round_trips; i++) {
+                        auto bmp = co_await sp2->AsyncReceive();
+                        co_await sp2->AsyncSend(*bmp);
+                        ++echoed;
+                    }
+                }
+                catch (...) {
+                    ++failed;
+                }
+            };
+
+            const auto client = [&]() -> test_task {
+                try {
+                    for (int i = 0; i < round_trips; i++) {
+                        binary_message bm;
+                        bm << hello;
+                        co_await sp1->AsyncSend(bm);
+                        auto bmp = co_await sp1->AsyncReceive();
+                        if (bmp->GetBody()->Get() == hello_buf) { ++matched; }
+                    }
+                }
+                catch (...) {
+                    ++failed;
+                }
+                done = true;
+            };
+
+            auto server_task = echo();
+            auto client_task = client();
+
+            REQUIRE(wait_for(done, 5000ms));
+            REQUIRE(failed == 0);
+            REQUIRE(matched == round_trips);
+            REQUIRE(echoed == round_trips);
+        }
+
+        SECTION("Failures are thrown when the coroutine resumes") {
+
+            atomic<bool> done(false), timed_out(false);
+
+            REQUIRE_NOTHROW(sp1->GetOptions()->SetDuration(O::recv_timeout_duration, 50ms));
+
+            const auto receive = [&]() -> test_task {
+                try {
+                    auto bmp = co_await sp1->AsyncReceive();
+                }
+                catch (const nng_exception& ex) {
+                    timed_out = ex.error_code == ec_etimedout;
+                }
+                done = true;
+            };
+
+            auto task = receive();
+
+            REQUIRE(wait_for(done, 1000ms));
+            REQUIRE(timed_out == true);
+        }
+
+        SECTION("Destroying a suspended coroutine cancels its operation") {
+
+            atomic<bool> resumed(false);
+
+            {
+                const auto receive = [&]() -> test_task {
+                    auto bmp = co_await sp1->AsyncReceive();
+                    resumed = true;
+                };
+
+                auto task = receive();
+            }
+
+            REQUIRE_NOTHROW(aio_reaper::Drain());
+            REQUIRE(resumed == false);
+
+            // The socket remains perfectly usable afterwards.
+            REQUIRE_NOTHROW(sp2->Send(hello_buf));
+            REQUIRE_NOTHROW(sp1->Receive());
+        }
+    }
+}
@@ -0,0 +1,192 @@
+//
+// Copyright (c) 2017 Michael W Powell <mwpowellhtx@gmail.com>
+//
+// This software is supplied under the terms of the MIT License, a
+// copy of which should be located in the distribution where this
+// file was obtained (LICENSE.txt).  A copy of the license may also be
+// found online at https://opensource.org/licenses/MIT.
+//
+
+#include <nngcpp.h>
+
+#include "../../catch/catch_exception_translations.hpp"
+#include "../../catch/catch_nng_exception_matcher.hpp"
+#include "../../catch/catch_tags.h"
+#include "../../catch/catch_macros.hpp"
+
+#include "../../helpers/basic_fixture.h"
+#include "../../helpers/constants.h"
+
+#include <atomic>
+
+namespace constants {
+
+    const std::string future_addr = "inproc://future";
+
+    const std::string hello = "hello";
+    const auto hello_buf = to_buffer(hello);
+
+    const int message_count = 100;
+}
+
+TEST_CASE("Future based asynchronous operations using C++ wrapper", Catch::Tags(
+    "async", "futures", "sockets", "cxx").c_str()) {
+
+    using namespace std;
+    using namespace nng;
+    using namespace nng::protocol;
+    using namespace nng::exceptions;
+    using namespace constants;
+    using namespace Catch::Matchers;
+
+    basic_fixture fixture;
+
+    SECTION("Promises complete their futures once") {
+
+        async_promise promise;
+        auto future = promise.GetFuture();
+        atomic<int> ready(0);
+
+        REQUIRE(future.IsReady() == false);
+        REQUIRE_NOTHROW(future.OnReady([&](async_future&) { ++ready; }));
+
+        REQUIRE(promise.SetResult(ec_etimedout) == true);
+        REQUIRE(promise.SetResult(ec_enone) == false);
+
+        REQUIRE(future.IsReady() == true);
+        REQUIRE(ready == 1);
+        REQUIRE(future.GetResult() == ec_etimedout);
+        REQUIRE_THROWS_AS_MATCHING(future.Get(), nng_exception, THROWS_NNG_EXCEPTION(ec_etimedout));
+
+        // Already ready, so this one runs immediately.
+        REQUIRE_NOTHROW(future.OnReady([&](async_future&) { ++ready; }));
+        REQUIRE(ready == 2);
+    }
+
+    SECTION("Given a connected pair of sockets") {
+
+        unique_ptr<latest_pair_socket> sp1, sp2;
+
+        REQUIRE_NOTHROW(sp1 = make_unique<latest_pair_socket>());
+        REQUIRE_NOTHROW(sp2 = make_unique<latest_pair_socket>());
+
+        REQUIRE_NOTHROW(sp1->Listen(future_addr));
+        REQUIRE_NOTHROW(sp2->Dial(future_addr));
+
+        SECTION("Send and receive futures complete") {
+
+            auto rx = sp2->ReceiveFuture(1000ms);
+
+            binary_message bm;
+            REQUIRE_NOTHROW(bm << hello);
+            auto tx = sp1->SendFuture(std::move(bm), 1000ms);
+
+            REQUIRE(tx.WaitFor(1000ms) == true);
+            REQUIRE(tx.GetResult() == ec_enone);
+
+            unique_ptr<binary_message> bmp;
+            REQUIRE_NOTHROW(bmp = rx.Get());
+            REQUIRE(bmp.get() != nullptr);
+            REQUIRE_THAT(bmp->GetBody()->Get(), Equals(hello_buf));
+        }
+
+        SECTION("Receive futures report timeouts") {
+
+            auto rx = sp2->ReceiveFuture(50ms);
+
+            REQUIRE(rx.GetResult() == ec_etimedout);
+            REQUIRE(rx.Cede().get() == nullptr);
+        }
+
+        SECTION("Continuations chain operations") {
+
+            // Echo whatever arrives back to the sender.
+            auto echoed = sp2->ReceiveFuture(1000ms).Then([&](async_future& f) {
+                return sp2->SendFuture(std::move(*f.Get()), 1000ms);
+            });
+
+            binary_message bm;
+            REQUIRE_NOTHROW(bm << hello);
+
+            auto reply = sp1->SendFuture(std::move(bm), 1000ms).Then([&](async_future& f) {
+                f.Get();
+                return sp1->ReceiveFuture(1000ms);
+            });
+
+            REQUIRE(echoed.GetResult() == ec_enone);
+
+            unique_ptr<binary_message> bmp;
+            REQUIRE_NOTHROW(bmp = reply.Get());
+            REQUIRE(bmp.get() != nullptr);
+            REQUIRE_THAT(bmp->GetBody()->Get(), Equals(hello_buf));
+        }
+
+        SECTION("Failures propagate through continuations") {
+
+            atomic<bool> continued(false);
+
+            auto chained = sp2->ReceiveFuture(50ms).Then([&](async_future& f) {
+                continued = true;
+                // Throws, which fails the chained future with the same error.
+                f.Get();
+                return f;
+            });
+
+            REQUIRE(chained.GetResult() == ec_etimedout);
+            REQUIRE(continued == true);
+        }
+
+        SECTION("Many futures may be pending at once") {
+
+            vector<async_future> receives, sends;
+
+            for (int i = 0; i < message_count; i++) {
+                receives.push_back(sp2->ReceiveFuture(1000ms));
+            }
+
+            for (int i = 0; i < message_count; i++) {
+                binary_message bm;
+                REQUIRE_NOTHROW(bm << hello);
+                sends.push_back(sp1->SendFuture(std::move(bm), 1000ms));
+            }
+
+            auto all_sent = when_all(sends);
+            auto all_received = when_all(receives);
+
+            REQUIRE(all_sent.WaitFor(2000ms) == true);
+            REQUIRE(all_received.WaitFor(2000ms) == true);
+            REQUIRE(all_sent.GetResult() == ec_enone);
+            REQUIRE(all_received.GetResult() == ec_enone);
+
+            for (auto& f : receives) {
+                REQUIRE_THAT(f.Get()->GetBody()->Get(), Equals(hello_buf));
+            }
+        }
+
+        SECTION("When any completes with the first") {
+
+            vector<async_future> futures;
+
+            // The first one times out well before the other.
+            futures.push_back(sp2->ReceiveFuture(50ms));
+            futures.push_back(sp1->ReceiveFuture(1000ms));
+
+            auto first = when_any(futures);
+
+            REQUIRE(first.GetResult() == ec_etimedout);
+            REQUIRE(first.GetIndex() == 0);
+
+            REQUIRE(futures[1].GetResult() == ec_etimedout);
+        }
+    }
+
+    SECTION("When all over nothing completes immediately") {
+
+        vector<async_future> futures;
+
+        auto all = when_all(futures);
+
+        REQUIRE(all.IsReady() == true);
+        REQUIRE(all.GetResult() == ec_enone);
+    }
+}
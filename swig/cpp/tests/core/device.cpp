@@ -12,6 +12,7 @@
 #include <nngcpp.h>
 
 #include "../catch/catch_exception_translations.hpp"
+#include "../catch/catch_nng_exception_matcher.hpp"
 #include "../catch/catch_macros.hpp"
 
 #include "../helpers/constants.h"
@@ -46,6 +47,14 @@ public:
         REQUIRE(devp != nullptr);
     }
 
+    void install(latest_pair_socket* const sp1, latest_pair_socket* const sp2, bool shouldCloseSockets, nng::size_type workers) {
+        REQUIRE(devp == nullptr);
+        REQUIRE(sp1 != nullptr);
+        REQUIRE(sp2 != nullptr);
+        devp = std::make_unique<device>(sp1, sp2, shouldCloseSockets, workers);
+        REQUIRE(devp != nullptr);
+    }
+
     bool is_installed() const {
         return devp != nullptr;
     }
@@ -136,3 +145,114 @@ TEST_CASE("Test that device functions properly", "[device]") {
 		}
 	}
 }
+
+TEST_CASE("Test that forwarding device functions properly", "[device][forwarder]") {
+
+    using namespace std;
+    using namespace std::chrono;
+    using namespace nng;
+    using namespace nng::protocol;
+    using namespace nng::exceptions;
+    using namespace constants;
+    using namespace Catch;
+    using namespace Catch::Matchers;
+    using O = option_names;
+
+    device_fixture fixture;
+
+    SECTION("nng::protocol::v1::pair_socket based forwarding device functions properly") {
+
+        latest_pair_socket p1, p2;
+
+        REQUIRE_NOTHROW(p1.GetOptions()->SetInt32(O::raw, 1));
+        REQUIRE_NOTHROW(p2.GetOptions()->SetInt32(O::raw, 1));
+
+        REQUIRE_NOTHROW(fixture.install(&p1, &p2, true, 2));
+        REQUIRE(fixture.is_installed() == true);
+
+        REQUIRE_NOTHROW(p1.Listen(dev1_addr));
+        REQUIRE_NOTHROW(p2.Listen(dev2_addr));
+
+        latest_pair_socket e1, e2;
+
+        REQUIRE_NOTHROW(e1.Dial(dev1_addr));
+        REQUIRE_NOTHROW(e2.Dial(dev2_addr));
+
+        const auto timeout = 1000ms;
+
+        REQUIRE_NOTHROW(e1.GetOptions()->SetDuration(O::recv_timeout_duration, timeout));
+        REQUIRE_NOTHROW(e2.GetOptions()->SetDuration(O::recv_timeout_duration, timeout));
+
+        SLEEP_FOR(100ms);
+
+        auto devp = fixture.get_device();
+
+        SECTION("Device forwards in both directions and counts what it forwards") {
+
+            _Message bm;
+
+            REQUIRE_NOTHROW(bm << alpha);
+            REQUIRE_NOTHROW(e1.Send(bm));
+            REQUIRE_NOTHROW(e2.TryReceive(&bm));
+            REQUIRE_THAT(bm.GetBody()->Get(), Equals(alpha_buf));
+
+            REQUIRE_NOTHROW(bm.Clear());
+            REQUIRE_NOTHROW(bm << omega);
+            REQUIRE_NOTHROW(e2.Send(bm));
+            REQUIRE_NOTHROW(e1.TryReceive(&bm));
+            REQUIRE_THAT(bm.GetBody()->Get(), Equals(omega_buf));
+
+            // Counters move when the send completes, which may be after the peer has the message.
+            const auto deadline = steady_clock::now() + timeout;
+            auto stats = devp->GetStats();
+
+            while ((stats.forward.messages < 1 || stats.backward.messages < 1) && steady_clock::now() < deadline) {
+                SLEEP_FOR(1ms);
+                stats = devp->GetStats();
+            }
+
+            REQUIRE(stats.forward.messages == 1);
+            REQUIRE(stats.forward.bytes >= alpha_buf.size());
+            REQUIRE(stats.forward.drops == 0);
+            REQUIRE(stats.backward.messages == 1);
+            REQUIRE(stats.backward.bytes >= omega_buf.size());
+            REQUIRE(stats.backward.drops == 0);
+        }
+
+        SECTION("Device stops gracefully") {
+
+            REQUIRE(devp->Stop(timeout) == true);
+            // Stopping again is harmless.
+            REQUIRE(devp->Stop(timeout) == true);
+
+            _Message bm;
+
+            // Nothing is forwarded any longer.
+            REQUIRE_NOTHROW(bm << alpha);
+            REQUIRE_NOTHROW(e1.Send(bm));
+            REQUIRE_THROWS_AS_MATCHING(e2.TryReceive(&bm), nng_exception, THROWS_NNG_EXCEPTION(ec_etimedout));
+            REQUIRE(devp->GetStats().forward.messages == 0);
+        }
+    }
+}
+
+TEST_CASE("Test that forwarding device requires raw sockets", "[device][forwarder]") {
+
+    using namespace std;
+    using namespace nng;
+    using namespace nng::protocol;
+    using namespace nng::exceptions;
+    using namespace Catch;
+    using O = option_names;
+
+    latest_pair_socket p1, p2;
+
+    SECTION("Cooked sockets are refused") {
+        REQUIRE_THROWS_AS_MATCHING(device_forwarder(p1, p2, 1), nng_exception, THROWS_NNG_EXCEPTION(ec_einval));
+    }
+
+    SECTION("Both sockets must be raw") {
+        REQUIRE_NOTHROW(p1.GetOptions()->SetInt32(O::raw, 1));
+        REQUIRE_THROWS_AS_MATCHING(device_forwarder(p1, p2, 1), nng_exception, THROWS_NNG_EXCEPTION(ec_einval));
+    }
+}
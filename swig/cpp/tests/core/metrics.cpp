@@ -0,0 +1,217 @@
+//
+// Copyright (c) 2017 Michael W Powell <mwpowellhtx@gmail.com>
+//
+// This software is supplied under the terms of the MIT License, a
+// copy of which should be located in the distribution where this
+// file was obtained (LICENSE.txt).  A copy of the license may also be
+// found online at https://opensource.org/licenses/MIT.
+//
+
+#include <nngcpp.h>
+
+#include "../catch/catch_exception_translations.hpp"
+#include "../catch/catch_nng_exception_matcher.hpp"
+#include "../catch/catch_tags.h"
+#include "../catch/catch_macros.hpp"
+
+#include "../helpers/basic_fixture.h"
+#include "../helpers/constants.h"
+
+#include <thread>
+
+namespace constants {
+
+    const std::string metrics_addr = "inproc://metrics";
+
+    const std::string hello = "hello";
+    const auto hello_buf = to_buffer(hello);
+
+    const int message_count = 10;
+}
+
+TEST_CASE("Latency histograms bucket values as expected", Catch::Tags(
+    "metrics", "histogram", "cxx").c_str()) {
+
+    using namespace nng;
+
+    SECTION("Small values are exact") {
+        for (uint64_t ns = 0; ns < 8; ns++) {
+            REQUIRE(histogram_snapshot::GetBucketUpperBound(metrics::get_bucket_index(ns)) == ns);
+        }
+    }
+
+    SECTION("Every value is bounded by its bucket") {
+        for (uint64_t ns = 1; ns < (uint64_t(1) << 40); ns = ns * 3 + 1) {
+            const auto i = metrics::get_bucket_index(ns);
+            REQUIRE(i < histogram_snapshot::GetBucketCount());
+            REQUIRE(histogram_snapshot::GetBucketUpperBound(i) >= ns);
+            // Within one eighth of the value, give or take the sub-bucket rounding.
+            REQUIRE(histogram_snapshot::GetBucketUpperBound(i) - ns <= ns / 8 + 1);
+        }
+    }
+
+    SECTION("Percentiles follow the recorded values") {
+
+        metrics m;
+
+        for (uint64_t ns = 1; ns <= 1000; ns++) {
+            m.Record(metric_send_latency, ns * 1000);
+        }
+
+        const auto snapshot = m.GetSnapshot();
+        const auto& h = snapshot.GetHistogram(metric_send_latency);
+
+        REQUIRE(h.count == 1000);
+        REQUIRE(h.max_ns == 1000000);
+        REQUIRE(h.GetMean() == Approx(500500.0));
+        REQUIRE(h.GetPercentile(0.5) >= 500000);
+        REQUIRE(h.GetPercentile(0.5) <= 500000 + 500000 / 8);
+        REQUIRE(h.GetPercentile(1.0) == 1000000);
+
+        REQUIRE(snapshot.GetHistogram(metric_receive_latency).count == 0);
+
+        m.Reset();
+
+        REQUIRE(m.GetSnapshot().GetHistogram(metric_send_latency).count == 0);
+    }
+
+    SECTION("Counts from many threads are aggregated") {
+
+        metrics m;
+
+        std::vector<std::thread> threads;
+
+        for (int i = 0; i < 16; i++) {
+            threads.emplace_back([&m]() {
+                for (int j = 0; j < 1000; j++) { m.Count(metric_messages_sent); }
+            });
+        }
+
+        for (auto& t : threads) { t.join(); }
+
+        REQUIRE(m.GetSnapshot().GetCounter(metric_messages_sent) == 16000);
+    }
+}
+
+TEST_CASE("Socket metrics are recorded when enabled", Catch::Tags(
+    "metrics", "sockets", "cxx").c_str()) {
+
+    using namespace std;
+    using namespace nng;
+    using namespace nng::protocol;
+    using namespace nng::exceptions;
+    using namespace constants;
+    using namespace Catch::Matchers;
+    using O = option_names;
+
+    basic_fixture fixture;
+
+    unique_ptr<latest_pair_socket> sp1, sp2;
+
+    REQUIRE_NOTHROW(sp1 = make_unique<latest_pair_socket>());
+    REQUIRE_NOTHROW(sp2 = make_unique<latest_pair_socket>());
+
+    SECTION("Metrics are off by default") {
+
+        REQUIRE(sp1->HasMetrics() == false);
+        REQUIRE(sp1->GetMetrics().GetCounter(metric_messages_sent) == 0);
+
+        shared_ptr<metrics> mp;
+        REQUIRE_NOTHROW(mp = sp1->EnableMetrics());
+        REQUIRE(mp.get() != nullptr);
+        REQUIRE(sp1->HasMetrics() == true);
+
+        // Enabling again hands back the same metrics.
+        REQUIRE(sp1->EnableMetrics() == mp);
+    }
+
+    SECTION("Given connected sockets with metrics") {
+
+        REQUIRE_NOTHROW(sp1->EnableMetrics());
+        REQUIRE_NOTHROW(sp2->EnableMetrics());
+
+        REQUIRE_NOTHROW(sp1->Listen(metrics_addr));
+        REQUIRE_NOTHROW(sp2->Dial(metrics_addr));
+
+        SECTION("Messages and bytes are counted") {
+
+            for (int i = 0; i < message_count; i++) {
+                REQUIRE(sp1->TrySend(hello_buf) == ec_enone);
+                allocated_buffer buf;
+                REQUIRE(sp2->TryReceive(buf) == ec_enone);
+            }
+
+            const auto sent = sp1->GetMetrics();
+            const auto received = sp2->GetMetrics();
+
+            REQUIRE(sent.GetCounter(metric_messages_sent) == message_count);
+            REQUIRE(sent.GetCounter(metric_bytes_sent) == message_count * hello_buf.size());
+            REQUIRE(sent.GetHistogram(metric_send_latency).count == message_count);
+            REQUIRE(sent.GetCounter(metric_messages_received) == 0);
+
+            REQUIRE(received.GetCounter(metric_messages_received) == message_count);
+            REQUIRE(received.GetCounter(metric_bytes_received) == message_count * hello_buf.size());
+            REQUIRE(received.GetHistogram(metric_receive_latency).count == message_count);
+        }
+
+        SECTION("Expected conditions are counted") {
+
+            allocated_buffer buf;
+            REQUIRE(sp2->TryReceive(buf, flag_nonblock) == ec_eagain);
+
+            REQUIRE_NOTHROW(sp2->GetOptions()->SetDuration(O::recv_timeout_duration, 10ms));
+            REQUIRE(sp2->TryReceive(buf) == ec_etimedout);
+
+            REQUIRE_THROWS_AS_MATCHING(sp2->ReceiveAllocated(), nng_exception, THROWS_NNG_EXCEPTION(ec_etimedout));
+
+            const auto snapshot = sp2->GetMetrics();
+
+            REQUIRE(snapshot.GetCounter(metric_eagain) == 1);
+            REQUIRE(snapshot.GetCounter(metric_timeouts) == 2);
+            REQUIRE(snapshot.GetCounter(metric_exceptions) == 1);
+            REQUIRE(snapshot.GetCounter(metric_messages_received) == 0);
+        }
+
+        SECTION("Asynchronous completions are counted") {
+
+            basic_async_service svc;
+
+            binary_message bm;
+            REQUIRE_NOTHROW(bm << hello);
+
+            REQUIRE_NOTHROW(svc << bm);
+            REQUIRE_NOTHROW(sp1->SendAsync(&svc));
+            REQUIRE_NOTHROW(svc.Wait());
+            REQUIRE(svc.GetResult() == ec_enone);
+
+            REQUIRE_NOTHROW(sp2->ReceiveAsync(&svc));
+            REQUIRE_NOTHROW(svc.Wait());
+            REQUIRE(svc.GetResult() == ec_enone);
+            REQUIRE_NOTHROW(svc >> bm);
+
+            const auto sent = sp1->GetMetrics();
+            const auto received = sp2->GetMetrics();
+
+            REQUIRE(sent.GetCounter(metric_aio_completions) == 1);
+            REQUIRE(sent.GetCounter(metric_messages_sent) == 1);
+            REQUIRE(sent.GetHistogram(metric_aio_latency).count == 1);
+
+            REQUIRE(received.GetCounter(metric_aio_completions) == 1);
+            REQUIRE(received.GetCounter(metric_messages_received) == 1);
+            REQUIRE(received.GetCounter(metric_bytes_received) == hello_buf.size());
+        }
+    }
+
+    SECTION("Listener failures are counted against the socket") {
+
+        REQUIRE_NOTHROW(sp1->EnableMetrics());
+        REQUIRE_NOTHROW(sp2->EnableMetrics());
+
+        REQUIRE_NOTHROW(sp1->Listen(metrics_addr));
+
+        listener l;
+        REQUIRE_THROWS_AS_MATCHING(sp2->Listen(metrics_addr, &l), nng_exception, THROWS_NNG_EXCEPTION(ec_eaddrinuse));
+
+        REQUIRE(sp2->GetMetrics().GetCounter(metric_exceptions) == 1);
+    }
+}
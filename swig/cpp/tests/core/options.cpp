@@ -0,0 +1,274 @@
+//
+// Copyright (c) 2017 Michael W Powell <mwpowellhtx@gmail.com>
+//
+// This software is supplied under the terms of the MIT License, a
+// copy of which should be located in the distribution where this
+// file was obtained (LICENSE.txt).  A copy of the license may also be
+// found online at https://opensource.org/licenses/MIT.
+//
+
+#include <nngcpp.h>
+
+#include "../catch/catch_exception_translations.hpp"
+#include "../catch/catch_nng_exception_matcher.hpp"
+#include "../catch/catch_tags.h"
+#include "../catch/catch_macros.hpp"
+
+#include "../helpers/constants.h"
+
+namespace constants {
+
+    const std::string options_addr = "inproc://options";
+}
+
+TEST_CASE("Typed option descriptors read and write through NNG literals", Catch::Tags(
+    "options", "descriptors", "cache", "pair", "sockets", "nng", "cxx").c_str()) {
+
+    using namespace std;
+    using namespace nng;
+    using namespace nng::protocol;
+    using namespace nng::exceptions;
+    using namespace constants;
+    using namespace Catch::Matchers;
+    using O = option_names;
+    using D = option_descriptors;
+
+    latest_pair_socket s;
+
+    auto* const op = s.GetOptions();
+
+    SECTION("Uncached options always go to NNG") {
+
+        const duration_type timeout = 123ms;
+
+        REQUIRE_NOTHROW(op->Set<D::recv_timeout_duration>(timeout));
+        REQUIRE(op->Get<D::recv_timeout_duration>() == timeout);
+        REQUIRE(op->GetDuration(O::recv_timeout_duration) == timeout);
+
+        // Set behind the typed descriptor's back, which is fine since there is nothing cached.
+        REQUIRE_NOTHROW(op->SetDuration(O::recv_timeout_duration, 456ms));
+        REQUIRE(op->Get<D::recv_timeout_duration>() == 456ms);
+
+        REQUIRE_NOTHROW(op->Set<D::recv_buf>(4));
+        REQUIRE(op->Get<D::recv_buf>() == 4);
+
+        REQUIRE(op->GetCache()->GetCount() == 0);
+    }
+
+    SECTION("Cached options are read once") {
+
+        int32_t protocol = 0;
+
+        REQUIRE_NOTHROW(protocol = op->Get<D::protocol>());
+        REQUIRE(protocol == op->GetInt32(O::protocol));
+        REQUIRE(op->GetCache()->GetCount() == 1);
+
+        REQUIRE(op->Get<D::protocol>() == protocol);
+        REQUIRE(op->GetCache()->GetCount() == 1);
+
+        SECTION("Until invalidated") {
+            REQUIRE_NOTHROW(op->InvalidateCache());
+            REQUIRE(op->GetCache()->GetCount() == 0);
+            REQUIRE(op->Get<D::protocol>() == protocol);
+        }
+
+        SECTION("Setting options drops their snapshot") {
+            // Read-only as far as NNG is concerned, which leaves the snapshot alone.
+            REQUIRE_THROWS_AS_MATCHING(op->Set<D::protocol>(protocol), nng_exception, THROWS_NNG_EXCEPTION(ec_ereadonly));
+            REQUIRE(op->GetCache()->GetCount() == 1);
+            // Whereas string keyed setters invalidate by name, not only typed ones.
+            REQUIRE_NOTHROW(op->SetInt32(O::raw, 1));
+            REQUIRE(op->GetCache()->GetCount() == 1);
+        }
+    }
+
+    SECTION("Endpoint urls are snapshot as text") {
+
+        unique_ptr<listener> lp;
+
+        REQUIRE_NOTHROW(lp = make_unique<listener>(s, options_addr));
+
+        string url;
+
+        REQUIRE_NOTHROW(url = lp->GetOptions()->Get<D::url>());
+        REQUIRE_THAT(url, Equals(options_addr));
+        REQUIRE_THAT(lp->GetOptions()->GetText(O::url), Equals(options_addr));
+
+        REQUIRE(lp->GetOptions()->GetCache()->GetCount() == 1);
+        REQUIRE_THAT(lp->GetOptions()->Get<D::url>(), Equals(options_addr));
+    }
+
+    SECTION("Starting an endpoint drops its snapshots") {
+
+        const string any_port_addr = "tcp://127.0.0.1:0";
+
+        unique_ptr<listener> lp;
+
+        REQUIRE_NOTHROW(lp = make_unique<listener>(s, any_port_addr));
+        REQUIRE_THAT(lp->GetOptions()->Get<D::url>(), Equals(any_port_addr));
+        REQUIRE(lp->GetOptions()->GetCache()->GetCount() == 1);
+
+        REQUIRE_NOTHROW(lp->Start());
+        REQUIRE(lp->GetOptions()->GetCache()->GetCount() == 0);
+
+        // Read afresh, so the snapshot agrees with NNG as it is now, bound port and all.
+        string url;
+
+        REQUIRE_NOTHROW(url = lp->GetOptions()->Get<D::url>());
+        REQUIRE_THAT(url, Equals(lp->GetOptions()->GetText(O::url)));
+    }
+}
+
+TEST_CASE("Option cache snapshots are keyed by name", Catch::Tags(
+    "options", "cache", "internal", "cxx").c_str()) {
+
+    using namespace std;
+    using namespace nng;
+
+    option_cache cache;
+
+    const char* const name = option_keys::url::value;
+
+    REQUIRE(cache.Find<string>(name) == nullptr);
+
+    REQUIRE_NOTHROW(cache.Store<string>(name, "inproc://cached"));
+    REQUIRE(cache.GetCount() == 1);
+    REQUIRE(cache.Find<string>(name) != nullptr);
+    REQUIRE(*cache.Find<string>(name) == "inproc://cached");
+
+    SECTION("Copies share the snapshots") {
+        const option_cache other = cache;
+        REQUIRE(other.GetCount() == 1);
+        REQUIRE(other.Find<string>(name) == cache.Find<string>(name));
+    }
+
+    SECTION("Invalidation compares the names themselves") {
+        const string copy = name;
+        REQUIRE_NOTHROW(cache.Invalidate(copy.c_str()));
+        REQUIRE(cache.GetCount() == 0);
+    }
+}
+
+TEST_CASE("Option profiles snapshot and apply in one call", Catch::Tags(
+    "options", "profile", "snapshot", "apply", "pair", "sockets", "dialers", "listeners", "nng", "cxx").c_str()) {
+
+    using namespace std;
+    using namespace nng;
+    using namespace nng::protocol;
+    using namespace nng::exceptions;
+    using namespace constants;
+    using O = option_names;
+
+    latest_pair_socket s;
+
+    option_profile profile;
+
+    profile.SetRecvTimeoutDuration(250ms)
+        .SetSendTimeoutDuration(500ms)
+        .SetRecvBuf(16)
+        .SetMaxRecvSize(4096)
+        .SetMinReconnectDuration(10ms)
+        .SetMaxReconnectDuration(1000ms);
+
+    SECTION("Sockets apply the whole profile") {
+
+        REQUIRE_NOTHROW(s.Apply(profile));
+
+        REQUIRE(s.GetOptions()->GetDuration(O::recv_timeout_duration) == 250ms);
+        REQUIRE(s.GetOptions()->GetDuration(O::send_timeout_duration) == 500ms);
+        REQUIRE(s.GetOptions()->GetInt32(O::recv_buf) == 16);
+        REQUIRE(s.GetOptions()->GetSize(O::max_recv_sz) == 4096);
+
+        option_profile snapshot;
+
+        REQUIRE_NOTHROW(snapshot = s.Snapshot());
+        REQUIRE(snapshot.fields == profile_pair1_socket_fields);
+        REQUIRE(snapshot.recv_timeout_duration == 250ms);
+        REQUIRE(snapshot.send_timeout_duration == 500ms);
+        REQUIRE(snapshot.recv_buf == 16);
+        REQUIRE(snapshot.max_recv_sz == 4096);
+        REQUIRE(snapshot.min_reconnect_duration == 10ms);
+        REQUIRE(snapshot.max_reconnect_duration == 1000ms);
+
+        SECTION("Snapshots may be applied elsewhere") {
+            latest_pair_socket other;
+            REQUIRE_NOTHROW(other.Apply(snapshot));
+            REQUIRE(other.GetOptions()->GetDuration(O::recv_timeout_duration) == 250ms);
+        }
+    }
+
+    SECTION("Sockets other than pair1 leave out the maximum TTL") {
+
+        latest_req_socket req;
+
+        option_profile snapshot;
+
+        REQUIRE_NOTHROW(req.Apply(profile));
+        REQUIRE_NOTHROW(snapshot = req.Snapshot());
+        REQUIRE(snapshot.fields == profile_socket_fields);
+        REQUIRE(snapshot.Has(profile_max_ttl) == false);
+        REQUIRE(snapshot.recv_timeout_duration == 250ms);
+
+        // Refused during validation, so nothing else in the profile is set either.
+        option_profile ttl;
+
+        ttl.SetSendTimeoutDuration(750ms).SetMaxTtl(8);
+
+        REQUIRE_THROWS_AS_MATCHING(req.Apply(ttl), nng_exception, THROWS_NNG_EXCEPTION(ec_enotsup));
+        REQUIRE(req.GetOptions()->GetDuration(O::send_timeout_duration) == 500ms);
+
+        REQUIRE_NOTHROW(s.Apply(ttl));
+        REQUIRE(s.Snapshot().max_ttl == 8);
+    }
+
+    SECTION("Dialers refuse socket only options before setting anything") {
+
+        unique_ptr<dialer> dp;
+
+        REQUIRE_NOTHROW(dp = make_unique<dialer>(s, options_addr));
+
+        const auto before = dp->GetOptions()->GetSize(O::max_recv_sz);
+
+        REQUIRE_THROWS_AS_MATCHING(dp->Apply(profile), nng_exception, THROWS_NNG_EXCEPTION(ec_enotsup));
+        REQUIRE(dp->GetOptions()->GetSize(O::max_recv_sz) == before);
+
+        option_profile tuning;
+
+        tuning.SetMaxRecvSize(2048)
+            .SetMinReconnectDuration(20ms)
+            .SetMaxReconnectDuration(2000ms);
+
+        REQUIRE_NOTHROW(dp->Apply(tuning));
+        REQUIRE(dp->Snapshot().fields == profile_dialer_fields);
+        REQUIRE(dp->Snapshot().max_recv_sz == 2048);
+        REQUIRE(dp->Snapshot().min_reconnect_duration == 20ms);
+    }
+
+    SECTION("Listeners only carry the receive size") {
+
+        unique_ptr<listener> lp;
+
+        REQUIRE_NOTHROW(lp = make_unique<listener>(s, options_addr));
+        REQUIRE_NOTHROW(lp->Apply(option_profile().SetMaxRecvSize(1024)));
+        REQUIRE(lp->Snapshot().fields == profile_listener_fields);
+        REQUIRE(lp->Snapshot().max_recv_sz == 1024);
+    }
+
+    SECTION("Invalid values are refused before anything is set") {
+
+        // Otherwise valid, except for the last of them.
+        profile.SetMaxTtl(0);
+
+        REQUIRE_THROWS_AS_MATCHING(s.Apply(profile), nng_exception, THROWS_NNG_EXCEPTION(ec_einval));
+        REQUIRE(s.GetOptions()->GetDuration(O::recv_timeout_duration) != 250ms);
+
+        REQUIRE_THROWS_AS_MATCHING(option_profile().SetRecvBuf(-1).Validate(profile_socket_fields)
+            , nng_exception, THROWS_NNG_EXCEPTION(ec_einval));
+
+        REQUIRE_THROWS_AS_MATCHING(option_profile().SetMinReconnectDuration(100ms).SetMaxReconnectDuration(10ms).Validate(profile_socket_fields)
+            , nng_exception, THROWS_NNG_EXCEPTION(ec_einval));
+
+        // No maximum at all is fine.
+        REQUIRE_NOTHROW(option_profile().SetMinReconnectDuration(100ms).SetMaxReconnectDuration(0ms).Validate(profile_socket_fields));
+    }
+}
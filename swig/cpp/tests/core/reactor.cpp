@@ -0,0 +1,149 @@
+//
+// Copyright (c) 2017 Michael W Powell <mwpowellhtx@gmail.com>
+//
+// This software is supplied under the terms of the MIT License, a
+// copy of which should be located in the distribution where this
+// file was obtained (LICENSE.txt).  A copy of the license may also be
+// found online at https://opensource.org/licenses/MIT.
+//
+
+#include <nngcpp.h>
+
+#include "../catch/catch_exception_translations.hpp"
+#include "../catch/catch_nng_exception_matcher.hpp"
+#include "../catch/catch_tags.h"
+#include "../catch/catch_macros.hpp"
+
+#include "../helpers/constants.h"
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace constants {
+
+    const std::string reactor_addr = "inproc://reactor";
+
+    const std::string hello = "hello";
+    const auto hello_buf = to_buffer(hello);
+}
+
+#ifdef __linux__
+
+TEST_CASE("Reactor dispatches readiness for many sockets on one thread", Catch::Tags(
+    "reactor", "epoll", "pollfd", "pair", "sockets", "nng", "cxx").c_str()) {
+
+    using namespace std;
+    using namespace nng;
+    using namespace nng::protocol;
+    using namespace nng::exceptions;
+    using namespace constants;
+    using namespace Catch::Matchers;
+
+    const size_type pair_count = 8;
+
+    vector<unique_ptr<latest_pair_socket>> servers, clients;
+
+    for (size_type i = 0; i < pair_count; i++) {
+        const auto addr = reactor_addr + to_string(i);
+        servers.push_back(make_unique<latest_pair_socket>());
+        clients.push_back(make_unique<latest_pair_socket>());
+        REQUIRE_NOTHROW(servers.back()->Listen(addr));
+        REQUIRE_NOTHROW(clients.back()->Dial(addr));
+    }
+
+    SLEEP_FOR(20ms);
+
+    reactor r;
+
+    vector<size_type> received(pair_count, 0);
+    bool bodies_match = true;
+
+    for (size_type i = 0; i < pair_count; i++) {
+        REQUIRE_NOTHROW(r.AddReceiver(*servers[i], [&, i](binary_message& bm) {
+            ++received[i];
+            bodies_match = bodies_match && bm.GetBody()->Get() == hello_buf;
+        }));
+    }
+
+    REQUIRE(r.GetCount() == pair_count);
+    REQUIRE(r.Contains(*servers[0]));
+    REQUIRE_FALSE(r.Contains(*clients[0]));
+
+    SECTION("Nothing is ready until something is sent") {
+        REQUIRE(r.RunOnce(10ms) == 0);
+    }
+
+    SECTION("Each readable socket is drained in one dispatch") {
+
+        // Several messages on every other socket, but only one edge per socket.
+        for (size_type i = 0; i < pair_count; i += 2) {
+            for (auto j = 0; j < 3; j++) {
+                binary_message bm;
+                REQUIRE_NOTHROW(bm << hello);
+                REQUIRE_NOTHROW(clients[i]->Send(bm));
+            }
+        }
+
+        SLEEP_FOR(20ms);
+
+        size_type dispatched = 0;
+        for (auto k = 0; k < 10 && dispatched < pair_count / 2; k++) {
+            dispatched += r.RunOnce(50ms);
+        }
+
+        REQUIRE(dispatched == pair_count / 2);
+        REQUIRE(bodies_match);
+
+        for (size_type i = 0; i < pair_count; i++) {
+            REQUIRE(received[i] == (i % 2 ? 0 : 3));
+        }
+
+        SECTION("And fires again on the next message") {
+            binary_message bm;
+            REQUIRE_NOTHROW(bm << hello);
+            REQUIRE_NOTHROW(clients[0]->Send(bm));
+            REQUIRE(r.RunOnce(1000ms) == 1);
+            REQUIRE(received[0] == 4);
+        }
+    }
+
+    SECTION("Removed sockets are no longer dispatched") {
+
+        REQUIRE(r.Remove(*servers[0]));
+        REQUIRE_FALSE(r.Remove(*servers[0]));
+        REQUIRE(r.GetCount() == pair_count - 1);
+
+        binary_message bm;
+        REQUIRE_NOTHROW(bm << hello);
+        REQUIRE_NOTHROW(clients[0]->Send(bm));
+
+        REQUIRE(r.RunOnce(20ms) == 0);
+        REQUIRE(received[0] == 0);
+    }
+
+    SECTION("Sockets cannot be added twice") {
+        REQUIRE_THROWS_AS_MATCHING(r.AddReceiver(*servers[0], [](binary_message&) {})
+            , nng_exception, THROWS_NNG_EXCEPTION(ec_ebusy));
+    }
+
+    SECTION("Run returns once stopped from another thread") {
+
+        thread runner([&r]() { r.Run(); });
+
+        binary_message bm;
+        REQUIRE_NOTHROW(bm << hello);
+        REQUIRE_NOTHROW(clients[1]->Send(bm));
+
+        for (auto k = 0; k < 100 && received[1] == 0; k++) {
+            SLEEP_FOR(5ms);
+        }
+
+        r.Stop();
+        runner.join();
+
+        REQUIRE(received[1] == 1);
+    }
+}
+
+#endif // __linux__
@@ -0,0 +1,161 @@
+//
+// Copyright (c) 2017 Michael W Powell <mwpowellhtx@gmail.com>
+//
+// This software is supplied under the terms of the MIT License, a
+// copy of which should be located in the distribution where this
+// file was obtained (LICENSE.txt).  A copy of the license may also be
+// found online at https://opensource.org/licenses/MIT.
+//
+
+#include <nngcpp.h>
+
+#include "../catch/catch_exception_translations.hpp"
+#include "../catch/catch_nng_exception_matcher.hpp"
+#include "../catch/catch_tags.h"
+#include "../catch/catch_macros.hpp"
+
+#include <memory>
+#include <vector>
+
+TEST_CASE("Slot maps hand out generational handles", Catch::Tags(
+    "slot", "map", "handle", "registry", "internal", "cxx").c_str()) {
+
+    using namespace std;
+    using namespace nng;
+
+    _SlotMap<int> map;
+
+    auto a = make_shared<int>(1);
+    auto b = make_shared<int>(2);
+
+    slot_handle_type ha = 0, hb = 0;
+
+    REQUIRE((ha = map.Insert(a)) != 0);
+    REQUIRE((hb = map.Insert(b)) != 0);
+    REQUIRE(ha != hb);
+
+    REQUIRE(map.GetCount() == 2);
+    REQUIRE(map.Get(ha) == a);
+    REQUIRE(map.Get(hb) == b);
+    REQUIRE(map.Find(a.get()) == ha);
+
+    REQUIRE(map.Insert(nullptr) == 0);
+    REQUIRE(map.Get(0) == nullptr);
+    REQUIRE(map.Find(nullptr) == 0);
+
+    SECTION("Removed handles go stale, even once their slot is reused") {
+
+        REQUIRE(map.Remove(ha));
+        REQUIRE_FALSE(map.Remove(ha));
+        REQUIRE_FALSE(map.Contains(ha));
+        REQUIRE(map.Get(ha) == nullptr);
+        REQUIRE(map.Find(a.get()) == 0);
+        REQUIRE(a.use_count() == 1);
+
+        auto c = make_shared<int>(3);
+        slot_handle_type hc = 0;
+
+        REQUIRE((hc = map.Insert(c)) != 0);
+        // Same slot, newer generation.
+        REQUIRE(static_cast<uint32_t>(hc) == static_cast<uint32_t>(ha));
+        REQUIRE(hc != ha);
+        REQUIRE(map.Get(ha) == nullptr);
+        REQUIRE(map.Get(hc) == c);
+    }
+
+    SECTION("Inserting the same object twice yields the same handle") {
+
+        REQUIRE(map.Insert(a) == ha);
+        REQUIRE(map.GetCount() == 2);
+
+        REQUIRE(map.Remove(a.get()));
+        REQUIRE(map.Get(ha) == nullptr);
+        REQUIRE(map.Find(a.get()) == 0);
+        REQUIRE(map.GetCount() == 1);
+        REQUIRE(a.use_count() == 1);
+    }
+
+    SECTION("Removing by address works the same") {
+        REQUIRE(map.Remove(b.get()));
+        REQUIRE_FALSE(map.Remove(b.get()));
+        REQUIRE(map.Get(hb) == nullptr);
+        REQUIRE(map.GetCount() == 1);
+    }
+
+    SECTION("Churn does not grow the map") {
+
+        for (auto i = 0; i < 1000; i++) {
+            auto x = make_shared<int>(i);
+            const auto h = map.Insert(x);
+            REQUIRE(map.Get(h) == x);
+            REQUIRE(map.Remove(x.get()));
+        }
+
+        REQUIRE(map.GetCount() == 2);
+    }
+
+    SECTION("Clearing releases everything and stales every handle") {
+
+        map.Clear();
+
+        REQUIRE(map.IsEmpty());
+        REQUIRE(map.Get(ha) == nullptr);
+        REQUIRE(map.Get(hb) == nullptr);
+        REQUIRE(a.use_count() == 1);
+        REQUIRE(b.use_count() == 1);
+
+        REQUIRE(map.Insert(a) != ha);
+    }
+}
+
+TEST_CASE("Session removals actually release what the session created", Catch::Tags(
+    "session", "slot", "map", "registry", "message", "pair", "sockets", "cxx").c_str()) {
+
+    using namespace std;
+    using namespace nng;
+    using namespace nng::protocol;
+
+    session _session_;
+
+    SECTION("Messages") {
+
+        vector<slot_handle_type> handles;
+
+        for (auto i = 0; i < 100; i++) {
+            const auto mp = _session_.create_message();
+            handles.push_back(_session_.get_message_handle(mp.get()));
+            REQUIRE(handles.back() != 0);
+            REQUIRE(_session_.get_message(handles.back()) == mp);
+        }
+
+        REQUIRE(_session_.get_message_count() == 100);
+
+        for (auto i = 0; i < 50; i++) {
+            REQUIRE_NOTHROW(_session_.remove_message(handles[i]));
+        }
+
+        REQUIRE(_session_.get_message_count() == 50);
+        REQUIRE(_session_.get_message(handles[0]) == nullptr);
+
+        for (auto i = 50; i < 100; i++) {
+            const auto mp = _session_.get_message(handles[i]);
+            REQUIRE(mp != nullptr);
+            REQUIRE_NOTHROW(_session_.remove_message(mp.get()));
+        }
+
+        REQUIRE(_session_.get_message_count() == 0);
+    }
+
+    SECTION("Sockets") {
+
+        weak_ptr<latest_pair_socket> wp;
+
+        {
+            const auto sp = _session_.create_pair_socket();
+            wp = sp;
+            REQUIRE_NOTHROW(_session_.remove_pair_socket(sp.get()));
+        }
+
+        REQUIRE(wp.expired());
+    }
+}
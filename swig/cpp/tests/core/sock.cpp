@@ -209,6 +209,42 @@ TEST_CASE("Socket Operations", "[socket][operations][ngg][cxx]") {
             REQUIRE_THAT(buf, Equals(empty_buf));
         }
 
+        SECTION("Receive without throwing reports " STRINGIFY(ec_eagain) " and " STRINGIFY(ec_etimedout)) {
+
+            binary_message bm((::nng_msg*)nullptr);
+            allocated_buffer buf;
+
+            REQUIRE(s1->TryReceive(bm, flag_nonblock) == ec_eagain);
+            REQUIRE(bm.HasOne() == false);
+            REQUIRE(s1->TryReceive(buf, flag_nonblock) == ec_eagain);
+            REQUIRE(buf.HasOne() == false);
+
+            const auto timeout = 100ms;
+
+            RUN_TIMED_SECTION_MILLISECONDS(timeout, [&]() {
+                REQUIRE_NOTHROW(s1->GetOptions()->SetDuration(O::recv_timeout_duration, timeout));
+                REQUIRE(s1->TryReceive(bm) == ec_etimedout);
+                REQUIRE(bm.HasOne() == false);
+            });
+        }
+
+        SECTION("Send without throwing reports " STRINGIFY(ec_etimedout) " and retains the message") {
+
+            const auto timeout = 100ms;
+
+            binary_message bm;
+            REQUIRE_NOTHROW(bm.GetBody()->Append(data_buf));
+
+            RUN_TIMED_SECTION_MILLISECONDS(timeout, [&]() {
+                REQUIRE_NOTHROW(s1->GetOptions()->SetDuration(O::send_timeout_duration, timeout));
+                REQUIRE(s1->TrySend(bm) == ec_etimedout);
+            });
+
+            REQUIRE(bm.HasOne());
+            REQUIRE_THAT(bm.GetBody()->Get(), Equals(data_buf));
+            REQUIRE(s1->TrySend(data_buf, flag_nonblock) == ec_eagain);
+        }
+
         SECTION("Send with no Pipes times out correctly") {
 
             // TODO: TBD: this one is failing: seems to be returning sooner than expected.
@@ -308,11 +344,36 @@ TEST_CASE("Socket Operations", "[socket][operations][ngg][cxx]") {
                     i.e. was being called with flags = flag_alloc. In this case, we fully expect the client
                     to do the allocation and handling of its own buffers. */
 
-                    sz = 4;
-                    buffer_vector_type buf;
-                    REQUIRE_NOTHROW(s2->TryReceive(&buf, sz));
-                    REQUIRE(buf.size() == sz);
-                    REQUIRE_THAT(buf, Equals(data_buf));
+                    SECTION("Into a caller sized buffer") {
+
+                        sz = 4;
+                        buffer_vector_type buf;
+                        REQUIRE_NOTHROW(s2->TryReceive(&buf, sz));
+                        REQUIRE(buf.size() == sz);
+                        REQUIRE_THAT(buf, Equals(data_buf));
+                    }
+
+                    SECTION("Without throwing") {
+
+                        binary_message bm((::nng_msg*)nullptr);
+                        REQUIRE(s2->TryReceive(bm) == ec_enone);
+                        REQUIRE(bm.HasOne());
+                        REQUIRE_THAT(bm.GetBody()->Get(), Equals(data_buf));
+                    }
+
+                    SECTION("Into an NNG allocated buffer") {
+
+                        allocated_buffer buf;
+                        REQUIRE_NOTHROW(s2->TryReceive(&buf));
+                        REQUIRE(buf.HasOne());
+                        REQUIRE(buf.GetSize() == data_buf.size());
+                        REQUIRE(buffer_vector_type(buf.begin(), buf.end()) == data_buf);
+
+                        // Ownership moves along with the handle.
+                        auto moved = std::move(buf);
+                        REQUIRE(buf.HasOne() == false);
+                        REQUIRE(moved.GetSize() == data_buf.size());
+                    }
 
                     REQUIRE_NOTHROW(_session_.remove_pair_socket(s2.get()));
                 }
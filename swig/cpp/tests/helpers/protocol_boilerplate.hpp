@@ -62,6 +62,26 @@ namespace nng {
                 Socket_::Send(buf, sz, flags);
             }
 
+            virtual error_code_type TrySend(binary_message& m, flag_type flags = flag_none) override {
+                return Socket_::TrySend(m, flags);
+            }
+
+            virtual error_code_type TrySend(const buffer_vector_type& buf, flag_type flags = flag_none) override {
+                return Socket_::TrySend(buf, flags);
+            }
+
+            virtual void SendGather(const const_buffer_segment* const segs, size_type count, flag_type flags = flag_none) override {
+                Socket_::SendGather(segs, count, flags);
+            }
+
+            virtual error_code_type TrySendGather(const const_buffer_segment* const segs, size_type count, flag_type flags = flag_none) override {
+                return Socket_::TrySendGather(segs, count, flags);
+            }
+
+            virtual std::vector<error_code_type> SendBatch(binary_message* const msgs, size_type count, flag_type flags = flag_none) override {
+                return Socket_::SendBatch(msgs, count, flags);
+            }
+
             virtual void SendAsync(const basic_async_service* const svcp) override {
                 Socket_::SendAsync(svcp);
             }
@@ -86,6 +106,36 @@ namespace nng {
                 return Socket_::TryReceive(bufp, sz, flags);
             }
 
+            virtual allocated_buffer ReceiveAllocated(flag_type flags = flag_none) override {
+                return Socket_::ReceiveAllocated(flags);
+            }
+
+            virtual bool TryReceive(allocated_buffer* const abp, flag_type flags = flag_none) override {
+                return Socket_::TryReceive(abp, flags);
+            }
+
+            virtual error_code_type TryReceive(binary_message& m, flag_type flags = flag_none) override {
+                return Socket_::TryReceive(m, flags);
+            }
+
+            virtual error_code_type TryReceive(allocated_buffer& buf, flag_type flags = flag_none) override {
+                return Socket_::TryReceive(buf, flags);
+            }
+
+            virtual size_type ReceiveScatter(const mutable_buffer_segment* const segs, size_type count, flag_type flags = flag_none) override {
+                return Socket_::ReceiveScatter(segs, count, flags);
+            }
+
+            virtual error_code_type TryReceiveScatter(const mutable_buffer_segment* const segs, size_type count
+                , size_type& sz, flag_type flags = flag_none) override {
+                return Socket_::TryReceiveScatter(segs, count, sz, flags);
+            }
+
+            virtual error_code_type ReceiveBatch(std::vector<std::unique_ptr<binary_message>>& results
+                , size_type max, const duration_type& timeout) override {
+                return Socket_::ReceiveBatch(results, max, timeout);
+            }
+
             virtual void ReceiveAsync(basic_async_service* const svcp) {
                 Socket_::ReceiveAsync(svcp);
             }
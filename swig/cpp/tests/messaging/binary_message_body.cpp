@@ -130,6 +130,20 @@ TEST_CASE("Message part operates correctly", Catch::Tags("body"
                     REQUIRE_THAT(partp->Get(), Equals(this_is_a_test_buf));
                 }
 
+                SECTION("View is correct without copying") {
+
+                    buffer_view view;
+                    REQUIRE_NOTHROW(view = partp->GetView());
+                    REQUIRE(view.GetSize() == this_is_a_test.length());
+                    REQUIRE(view.data() == static_cast<const uint8_t*>(::nng_msg_body(bmp->get_message())));
+                    REQUIRE(std::equal(view.begin(), view.end(), this_is_a_test_buf.cbegin()));
+
+                    SECTION("View is obtained again after mutation") {
+                        REQUIRE_NOTHROW(partp->TrimRight(_a_test.length()));
+                        REQUIRE_THAT(partp->GetView().ToBuffer(), Equals(this_is_buf));
+                    }
+                }
+
                 SECTION("Right Trim is correct") {
 
                     REQUIRE_NOTHROW(partp->TrimRight(_a_test.length()));
@@ -148,6 +148,15 @@ TEST_CASE("Message part operates correctly", Catch::Tags("header"
                 REQUIRE_NOTHROW(partp->Append(value));
                 REQUIRE_THAT(partp->Get(), Equals(appended_data));
 
+                SECTION("View is correct without copying") {
+
+                    buffer_view view;
+                    REQUIRE_NOTHROW(view = partp->GetView());
+                    REQUIRE(view.GetSize() == partp->GetSize());
+                    REQUIRE(view.data() == static_cast<const uint8_t*>(::nng_msg_header(bmp->get_message())));
+                    REQUIRE_THAT(view.ToBuffer(), Equals(appended_data));
+                }
+
                 uint32_t trimmed = 0;
                 CHECK(!trimmed);
 
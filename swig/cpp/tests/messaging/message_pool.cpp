@@ -0,0 +1,156 @@
+//
+// Copyright (c) 2017 Michel W Powell <mwpowellhtx@gmail.com>
+//
+// This software is supplied under the terms of the MIT License, a
+// copy of which should be located in the distribution where this
+// file was obtained (LICENSE.txt).  A copy of the license may also be
+// found online at https://opensource.org/licenses/MIT.
+//
+
+#include <nngcpp.h>
+
+#include "../catch/catch_exception_translations.hpp"
+#include "../catch/catch_tags.h"
+#include "../helpers/constants.h"
+
+#include "../src/messaging/message_pool.h"
+
+#include <thread>
+
+namespace constants {
+
+    const std::string this_is_a_test = "this is a test";
+    const auto this_is_a_test_buf = to_buffer(this_is_a_test);
+}
+
+TEST_CASE("Message pool recycles messages", Catch::Tags("message"
+    , "pool", "recycle", "messaging", "nng", "cxx").c_str()) {
+
+    using namespace std;
+    using namespace nng;
+    using namespace constants;
+    using namespace Catch::Matchers;
+
+    shared_ptr<message_pool> poolp;
+    unique_ptr<binary_message> bmp;
+
+    const message_pool::size_class_vector_type classes = {
+        message_size_class(64, 2)
+        , message_size_class(256, 2)
+    };
+
+    REQUIRE_NOTHROW(poolp = make_shared<message_pool>(classes));
+
+    SECTION("First message is a miss") {
+
+        REQUIRE_NOTHROW(bmp = poolp->Acquire(16));
+        REQUIRE(bmp->HasOne());
+        REQUIRE(bmp->GetBody()->GetSize() == 16);
+        REQUIRE(poolp->GetStats().misses == 1);
+        REQUIRE(poolp->GetStats().hits == 0);
+
+        SECTION("Destroying the message recycles it") {
+
+            const auto* const msgp = bmp->get_message();
+
+            REQUIRE_NOTHROW(bmp.reset());
+            REQUIRE(poolp->GetStats().recycled == 1);
+
+            SECTION("And the next acquisition is a hit with a clean message") {
+
+                REQUIRE_NOTHROW(bmp = poolp->Acquire());
+                REQUIRE(bmp->get_message() == msgp);
+                REQUIRE(bmp->GetBody()->GetSize() == 0);
+                REQUIRE(bmp->GetHeader()->GetSize() == 0);
+                REQUIRE(poolp->GetStats().hits == 1);
+
+                REQUIRE_NOTHROW(bmp->GetBody()->Append(this_is_a_test));
+                REQUIRE_THAT(bmp->GetBody()->Get(), Equals(this_is_a_test_buf));
+            }
+
+            SECTION("Other threads do not share this free list") {
+
+                message_pool_stats stats;
+
+                thread t([&]() {
+                    auto other = poolp->Acquire();
+                    stats = poolp->GetStats();
+                });
+
+                t.join();
+
+                REQUIRE(stats.hits == 0);
+                REQUIRE(stats.misses == 2);
+            }
+
+            SECTION("Draining frees every cached message") {
+
+                REQUIRE_NOTHROW(poolp->Drain());
+                REQUIRE_NOTHROW(bmp = poolp->Acquire());
+                REQUIRE(poolp->GetStats().hits == 0);
+                REQUIRE(poolp->GetStats().misses == 2);
+            }
+        }
+
+        SECTION("Messages destroyed on another thread return to the acquiring thread") {
+
+            const auto* const msgp = bmp->get_message();
+
+            thread t([&]() { bmp.reset(); });
+
+            t.join();
+
+            REQUIRE(poolp->GetStats().recycled == 1);
+
+            REQUIRE_NOTHROW(bmp = poolp->Acquire());
+            REQUIRE(bmp->get_message() == msgp);
+            REQUIRE(poolp->GetStats().hits == 1);
+        }
+
+        SECTION("Retaining another message recycles the previous one") {
+
+            msg_type* msgp = nullptr;
+            REQUIRE(::nng_msg_alloc(&msgp, 0) == 0);
+            REQUIRE_NOTHROW(bmp->retain(msgp));
+            REQUIRE(poolp->GetStats().recycled == 1);
+        }
+
+        SECTION("Ceded messages are not recycled") {
+
+            msg_type* msgp = nullptr;
+            REQUIRE_NOTHROW(msgp = bmp->cede_message());
+            REQUIRE_NOTHROW(bmp.reset());
+            REQUIRE(poolp->GetStats().recycled == 0);
+            ::nng_msg_free(msgp);
+        }
+    }
+
+    SECTION("Oversized messages are released") {
+
+        REQUIRE_NOTHROW(bmp = poolp->Acquire(1024));
+        REQUIRE(bmp->GetBody()->GetSize() == 1024);
+        REQUIRE_NOTHROW(bmp.reset());
+        REQUIRE(poolp->GetStats().recycled == 0);
+        REQUIRE(poolp->GetStats().released == 1);
+    }
+
+    SECTION("High water caps the free list") {
+
+        vector<unique_ptr<binary_message>> messages;
+
+        for (auto i = 0; i < 3; i++) {
+            REQUIRE_NOTHROW(messages.push_back(poolp->Acquire(32)));
+        }
+
+        REQUIRE_NOTHROW(messages.clear());
+        REQUIRE(poolp->GetStats().recycled == 2);
+        REQUIRE(poolp->GetStats().released == 1);
+    }
+
+    SECTION("Pool outlives its messages") {
+
+        REQUIRE_NOTHROW(bmp = poolp->Acquire());
+        REQUIRE_NOTHROW(poolp.reset());
+        REQUIRE_NOTHROW(bmp.reset());
+    }
+}
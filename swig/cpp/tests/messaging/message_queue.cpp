@@ -0,0 +1,198 @@
+//
+// Copyright (c) 2017 Michel W Powell <mwpowellhtx@gmail.com>
+//
+// This software is supplied under the terms of the MIT License, a
+// copy of which should be located in the distribution where this
+// file was obtained (LICENSE.txt).  A copy of the license may also be
+// found online at https://opensource.org/licenses/MIT.
+//
+
+#include <nngcpp.h>
+
+#include "../catch/catch_exception_translations.hpp"
+#include "../catch/catch_tags.h"
+#include "../helpers/constants.h"
+
+#include "../src/messaging/message_queue.h"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+namespace constants {
+
+    const std::string this_is_a_test = "this is a test";
+    const auto this_is_a_test_buf = to_buffer(this_is_a_test);
+}
+
+TEST_CASE("Single producer message queue hands off messages", Catch::Tags("message"
+    , "queue", "spsc", "messaging", "nng", "cxx").c_str()) {
+
+    using namespace std;
+    using namespace std::chrono;
+    using namespace nng;
+    using namespace constants;
+    using namespace Catch::Matchers;
+
+    spsc_message_queue q(3);
+
+    // Rounded up to a power of two.
+    REQUIRE(q.GetCapacity() == 4);
+    REQUIRE(q.IsEmpty());
+
+    binary_message bm;
+
+    SECTION("Pushing cedes the message, and popping retains it") {
+
+        REQUIRE_NOTHROW(bm.GetBody()->Append(this_is_a_test));
+
+        const auto* const msgp = bm.get_message();
+
+        REQUIRE(q.TryPush(bm));
+        REQUIRE_FALSE(bm.HasOne());
+        REQUIRE(q.GetSize() == 1);
+
+        binary_message received;
+
+        REQUIRE(q.TryPop(received));
+        REQUIRE(received.get_message() == msgp);
+        REQUIRE_THAT(received.GetBody()->Get(), Equals(this_is_a_test_buf));
+        REQUIRE(q.IsEmpty());
+
+        REQUIRE_FALSE(q.TryPop(received));
+    }
+
+    SECTION("Full queues refuse, and leave the message alone") {
+
+        for (size_type i = 0; i < q.GetCapacity(); i++) {
+            binary_message x;
+            REQUIRE(q.TryPush(x));
+        }
+
+        REQUIRE_FALSE(q.TryPush(bm));
+        REQUIRE(bm.HasOne());
+        REQUIRE(q.Push(bm, 10ms) == ec_etimedout);
+        REQUIRE(bm.HasOne());
+
+        SECTION("Batch pops take what is there") {
+
+            vector<binary_message> batch(10);
+
+            REQUIRE(q.TryPop(batch.data(), batch.size()) == 4);
+            REQUIRE(q.IsEmpty());
+        }
+
+        SECTION("Messages still queued are freed with the queue") {
+            REQUIRE_NOTHROW(q.Clear());
+            REQUIRE(q.IsEmpty());
+        }
+    }
+
+    SECTION("Popping an empty queue times out") {
+        REQUIRE(q.Pop(bm, 10ms) == ec_etimedout);
+    }
+
+    SECTION("Closing wakes the consumer, but lets it drain first") {
+
+        REQUIRE(q.TryPush(bm));
+
+        error_code_type ec = ec_enone;
+
+        thread consumer([&]() {
+            binary_message x;
+            while ((ec = q.Pop(x)) == ec_enone) {}
+        });
+
+        this_thread::sleep_for(20ms);
+
+        REQUIRE_NOTHROW(q.Close());
+
+        consumer.join();
+
+        REQUIRE(ec == ec_eclosed);
+        REQUIRE(q.IsEmpty());
+
+        binary_message x;
+        REQUIRE_FALSE(q.TryPush(x));
+    }
+
+    SECTION("Messages arrive in order across threads") {
+
+        const uint32_t count = 10000;
+
+        thread producer([&]() {
+            for (uint32_t i = 0; i < count; i++) {
+                binary_message x;
+                x.GetBody()->Append(i);
+                q.Push(x);
+            }
+        });
+
+        uint32_t expected = 0;
+        bool ordered = true;
+
+        vector<binary_message> batch(3);
+        size_type popped = 0;
+
+        while (expected < count && q.Pop(batch.data(), batch.size(), popped, 1000ms) == ec_enone) {
+            for (size_type i = 0; i < popped; i++) {
+                uint32_t value = 0;
+                batch[i].GetBody()->TrimLeft(&value);
+                ordered = ordered && value == expected++;
+            }
+        }
+
+        producer.join();
+
+        REQUIRE(expected == count);
+        REQUIRE(ordered);
+    }
+}
+
+TEST_CASE("Multiple producer message queue hands off messages", Catch::Tags("message"
+    , "queue", "mpsc", "messaging", "nng", "cxx").c_str()) {
+
+    using namespace std;
+    using namespace std::chrono;
+    using namespace nng;
+
+    const size_type producers = 4;
+    const uint32_t per_producer = 5000;
+
+    mpsc_message_queue q(64);
+
+    vector<thread> threads;
+
+    for (size_type p = 0; p < producers; p++) {
+        threads.emplace_back([&q, p, per_producer]() {
+            for (uint32_t i = 0; i < per_producer; i++) {
+                binary_message x;
+                x.GetBody()->Append(static_cast<uint32_t>(p));
+                x.GetBody()->Append(i);
+                q.Push(x);
+            }
+        });
+    }
+
+    // Each producer's messages stay in order, although they are interleaved with the others.
+    vector<uint32_t> next(producers, 0);
+    bool ordered = true;
+    uint32_t received = 0;
+
+    binary_message bm;
+
+    while (received < producers * per_producer && q.Pop(bm, 1000ms) == ec_enone) {
+        uint32_t p = 0, i = 0;
+        bm.GetBody()->TrimLeft(&p);
+        bm.GetBody()->TrimLeft(&i);
+        ordered = ordered && p < producers && next[p]++ == i;
+        ++received;
+    }
+
+    for (auto& t : threads) { t.join(); }
+
+    REQUIRE(received == producers * per_producer);
+    REQUIRE(ordered);
+    REQUIRE(q.IsEmpty());
+}
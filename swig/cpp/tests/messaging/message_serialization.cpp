@@ -0,0 +1,202 @@
+//
+// Copyright (c) 2017 Michel W Powell <mwpowellhtx@gmail.com>
+//
+// This software is supplied under the terms of the MIT License, a
+// copy of which should be located in the distribution where this
+// file was obtained (LICENSE.txt).  A copy of the license may also be
+// found online at https://opensource.org/licenses/MIT.
+//
+
+#include <nngcpp.h>
+
+#include "../catch/catch_exception_translations.hpp"
+#include "../catch/catch_nng_exception_matcher.hpp"
+#include "../catch/catch_macros.hpp"
+#include "../catch/catch_tags.h"
+#include "../helpers/constants.h"
+
+#include "../src/messaging/message_serialization.h"
+
+#include <array>
+#include <string>
+
+namespace constants {
+
+    const std::string hello = "hello";
+    const auto hello_buf = to_buffer(hello);
+}
+
+namespace {
+
+    enum class shape_kind : int16_t {
+        circle = -1,
+        square = 4
+    };
+
+    struct point {
+        int32_t x;
+        int32_t y;
+        NNGCPP_SERIALIZABLE(x, y)
+    };
+
+    struct shape {
+        shape_kind kind;
+        std::string name;
+        std::array<point, 2> bounds;
+        double scale;
+        NNGCPP_SERIALIZABLE(kind, name, bounds, scale)
+    };
+}
+
+TEST_CASE("Values are written in network byte order", Catch::Tags("serialization"
+    , "write", "message", "messaging", "nng", "cxx").c_str()) {
+
+    using namespace std;
+    using namespace nng;
+    using namespace Catch::Matchers;
+
+    binary_message bm;
+
+    SECTION("Integers are big endian") {
+
+        REQUIRE_NOTHROW(bm << static_cast<uint16_t>(0x0102) << static_cast<int32_t>(-2));
+        REQUIRE_THAT(bm.GetBody()->Get(), Equals(buffer_vector_type{ 0x01, 0x02, 0xff, 0xff, 0xff, 0xfe }));
+
+        uint16_t a = 0;
+        int32_t b = 0;
+
+        REQUIRE_NOTHROW(bm >> a >> b);
+        REQUIRE(a == 0x0102);
+        REQUIRE(b == -2);
+        REQUIRE(bm.GetBody()->GetSize() == 0);
+    }
+
+    SECTION("Floating point values travel as their bits") {
+
+        REQUIRE_NOTHROW(bm << 1.0f << -0.5);
+        REQUIRE(bm.GetBody()->GetSize() == sizeof(float) + sizeof(double));
+        REQUIRE_THAT(bm.GetBody()->Get(), Equals(buffer_vector_type{ 0x3f, 0x80, 0x00, 0x00
+            , 0xbf, 0xe0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 }));
+
+        float f = 0;
+        double d = 0;
+
+        REQUIRE_NOTHROW(bm >> f >> d);
+        REQUIRE(f == 1.0f);
+        REQUIRE(d == -0.5);
+    }
+
+    SECTION("Strings are still appended as they are") {
+        REQUIRE_NOTHROW(bm << constants::hello);
+        REQUIRE_THAT(bm.GetBody()->Get(), Equals(constants::hello_buf));
+    }
+}
+
+TEST_CASE("Writers and readers work in place", Catch::Tags("serialization"
+    , "writer", "reader", "message", "messaging", "nng", "cxx").c_str()) {
+
+    using namespace std;
+    using namespace nng;
+    using namespace nng::exceptions;
+    using namespace Catch::Matchers;
+
+    binary_message bm;
+
+    const shape expected = { shape_kind::circle, constants::hello, { { { 1, -2 }, { 3, 4 } } }, 2.5 };
+
+    SECTION("Reflected structs round trip") {
+
+        {
+            message_writer w(bm);
+            REQUIRE_NOTHROW(w.Write(static_cast<uint8_t>(7), expected));
+            // One, plus the kind, the length prefixed name, four coordinates, and the scale.
+            REQUIRE(w.GetSize() == 1 + 2 + 4 + 5 + 16 + 8);
+        }
+
+        REQUIRE(bm.GetBody()->GetSize() == 36);
+
+        message_reader r(bm);
+
+        uint8_t tag = 0;
+        shape actual;
+
+        REQUIRE_NOTHROW(r >> tag >> actual);
+        REQUIRE(tag == 7);
+        REQUIRE(actual.kind == expected.kind);
+        REQUIRE_THAT(actual.name, Equals(expected.name));
+        REQUIRE(actual.bounds[0].y == -2);
+        REQUIRE(actual.bounds[1].x == 3);
+        REQUIRE(actual.scale == expected.scale);
+        REQUIRE(r.GetRemaining() == 0);
+
+        SECTION("Reading does not remove anything until consumed") {
+            REQUIRE(bm.GetBody()->GetSize() == 36);
+            REQUIRE_NOTHROW(r.Consume());
+            REQUIRE(bm.GetBody()->GetSize() == 0);
+        }
+    }
+
+    SECTION("Unwritten reservations are given back") {
+
+        {
+            message_writer w(bm);
+            REQUIRE_NOTHROW(w.Reserve(64));
+            REQUIRE_NOTHROW(w << static_cast<uint32_t>(1) << static_cast<uint32_t>(2));
+        }
+
+        REQUIRE(bm.GetBody()->GetSize() == 8);
+    }
+
+    SECTION("Writing appends to what is already there") {
+
+        REQUIRE_NOTHROW(bm.GetBody()->Append(constants::hello_buf));
+
+        {
+            message_writer w(bm);
+            REQUIRE_NOTHROW(w << constants::hello);
+        }
+
+        message_reader r(bm);
+        uint8_t raw[5];
+        string s;
+
+        // Fixed arrays carry no length prefix.
+        REQUIRE_NOTHROW(r >> raw >> s);
+        REQUIRE_THAT(buffer_vector_type(raw, raw + 5), Equals(constants::hello_buf));
+        REQUIRE_THAT(s, Equals(constants::hello));
+    }
+
+    SECTION("Reading past the end throws, and leaves the position alone") {
+
+        REQUIRE_NOTHROW(bm << static_cast<uint16_t>(1));
+
+        message_reader r(bm);
+        uint32_t x = 0;
+
+        REQUIRE_THROWS_AS_MATCHING(r >> x, nng_exception, THROWS_NNG_EXCEPTION(ec_einval));
+        REQUIRE(r.GetPosition() == 0);
+        REQUIRE(r.GetRemaining() == 2);
+    }
+
+    SECTION("Ceded messages cannot be written") {
+
+        auto* msgp = bm.cede_message();
+
+        REQUIRE_THROWS_AS(message_writer(bm), invalid_operation);
+
+        ::nng_msg_free(msgp);
+    }
+
+    SECTION("Ceded messages cannot be read") {
+
+        auto* msgp = bm.cede_message();
+
+        message_reader r(bm);
+        uint16_t x = 0;
+
+        REQUIRE_THROWS_AS(r >> x, invalid_operation);
+        REQUIRE(r.GetPosition() == 0);
+
+        ::nng_msg_free(msgp);
+    }
+}
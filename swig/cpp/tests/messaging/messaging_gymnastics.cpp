@@ -102,6 +102,45 @@ TEST_CASE("Can write (append) to and read (get) from binary message using string
     }
 }
 
+TEST_CASE("Conversions may reuse an existing destination"
+    , Catch::Tags("convert", "string", "vector", "read", "binary", "message"
+        , "messaging", "gymnastics", "cxx").c_str()) {
+
+    using namespace std;
+    using namespace nng;
+    using namespace Catch::Matchers;
+    using namespace constants;
+
+    SECTION("Gymnastic conversion overwrites what was there") {
+
+        string converted_ = "something much longer than hello";
+        REQUIRE_NOTHROW(gymanstic_convert<buffer_vector_type, string, string::value_type>(hello_buf, converted_));
+        REQUIRE_THAT(converted_, Equals(hello));
+    }
+
+    SECTION("Utilities copy into the result, limited by size") {
+
+        buffer_vector_type buf_ = { 1, 2, 3, 4, 5, 6, 7, 8 };
+        REQUIRE_NOTHROW(messaging_utils::to_buffer(&buf_, &hello, 4));
+        REQUIRE_THAT(buf_, Equals(buffer_vector_type(hello_buf.begin(), hello_buf.begin() + 4)));
+
+        string s_;
+        REQUIRE_NOTHROW(messaging_utils::to_string(&s_, &hello_buf, 100));
+        REQUIRE_THAT(s_, Equals(hello));
+    }
+
+    SECTION("Reading from a message replaces the previous contents") {
+
+        NNGCPP_TESTS_INITIALIZE_BINARY_MESSAGE(bm);
+
+        string read_ = "previous contents";
+        REQUIRE_NOTHROW(bm << hello);
+        REQUIRE_NOTHROW(bm >> read_);
+        REQUIRE_THAT(read_, Equals(hello));
+        REQUIRE_THAT(static_cast<string>(bm), Equals(hello));
+    }
+}
+
 // I dislike declarations via MACRO, but in this case I will make an exception.
 #define NNGCPP_TESTS_EXPOSE_BINARY_MESSAGE_BODY(bm, bmb) \
     auto* bmb = bm.GetBody(); \
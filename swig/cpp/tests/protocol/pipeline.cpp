@@ -25,6 +25,7 @@ DEFINE_SOCKET_FIXTURE_WITH_RECV_EXPOSURE(v0, push_socket_fixture, push_socket)
 DEFINE_SOCKET_FIXTURE_WITH_SEND_EXPOSURE(v0, pull_socket_fixture, pull_socket)
 
 #include <string>
+#include <algorithm>
 
 namespace constants {
 
@@ -118,6 +119,7 @@ TEST_CASE("Rule out the possibility of invalid operations", Catch::Tags("pipelin
     size_type sz = 0;
     binary_message m;
     buffer_vector_type buf;
+    std::vector<std::unique_ptr<binary_message>> results;
 
     SECTION("Push sockets cannot receive messages") {
 
@@ -128,6 +130,10 @@ TEST_CASE("Rule out the possibility of invalid operations", Catch::Tags("pipelin
         REQUIRE_THROWS_AS(push.TryReceive(&m), invalid_operation);
         REQUIRE_THROWS_AS(push.Receive(sz), invalid_operation);
         REQUIRE_THROWS_AS(push.TryReceive(&buf, sz), invalid_operation);
+        REQUIRE_THROWS_AS(push.ReceiveAllocated(), invalid_operation);
+        REQUIRE_THROWS_AS(push.ReceiveBatch(results, 1, duration_type(0)), invalid_operation);
+        REQUIRE_THROWS_AS(push.ReceiveScatter(nullptr, 0), invalid_operation);
+        REQUIRE_THROWS_AS(push.TryReceiveScatter(nullptr, 0, sz), invalid_operation);
     }
 
     SECTION("Pull sockets cannot send messages") {
@@ -137,6 +143,9 @@ TEST_CASE("Rule out the possibility of invalid operations", Catch::Tags("pipelin
         REQUIRE_THROWS_AS(pull.Send(buf), invalid_operation);
         REQUIRE_THROWS_AS(pull.Send(m), invalid_operation);
         REQUIRE_THROWS_AS(pull.Send(buf, sz), invalid_operation);
+        REQUIRE_THROWS_AS(pull.SendBatch(&m, 1), invalid_operation);
+        REQUIRE_THROWS_AS(pull.SendGather(nullptr, 0), invalid_operation);
+        REQUIRE_THROWS_AS(pull.TrySendGather(nullptr, 0), invalid_operation);
     }
 }
 
@@ -219,6 +228,88 @@ TEST_CASE("We can create a linked push/pull pair", Catch::Tags("linked"
         REQUIRE_THAT(bm.GetBody()->Get(), Equals(hello_buf));
     }
 
+    SECTION("Push can gather segments, and pull can scatter them") {
+
+        const uint32_t header = 0x01020304;
+
+        const const_buffer_segment out[] = {
+            { &header, sizeof(header) }, { abc_buf }, { nullptr, 0 }, { def_buf }
+        };
+
+        REQUIRE_NOTHROW(pushsp->SendGather(out, 4));
+
+        uint32_t header_in = 0;
+        buffer_vector_type abc_in(abc_buf.size()), def_in(def_buf.size());
+
+        const mutable_buffer_segment in[] = {
+            { &header_in, sizeof(header_in) }, { abc_in }, { def_in }
+        };
+
+        size_type sz = 0;
+
+        REQUIRE_NOTHROW(sz = pullsp->ReceiveScatter(in, 3));
+        REQUIRE(sz == sizeof(header) + abc_buf.size() + def_buf.size());
+        REQUIRE(header_in == header);
+        REQUIRE_THAT(abc_in, Equals(abc_buf));
+        REQUIRE_THAT(def_in, Equals(def_buf));
+
+        SECTION("Bodies longer than the segments are reported") {
+
+            REQUIRE(pushsp->TrySendGather(out, 4) == ec_enone);
+
+            header_in = 0;
+
+            REQUIRE(pullsp->TryReceiveScatter(in, 1, sz) == ec_emsgsize);
+            REQUIRE(sz == sizeof(header) + abc_buf.size() + def_buf.size());
+            REQUIRE(header_in == header);
+        }
+    }
+
+    SECTION("Push can send a batch, and pull can receive a batch") {
+
+        const auto timeout = 100ms;
+
+        vector<_Message> batch(3);
+        vector<error_code_type> statuses;
+        vector<unique_ptr<_Message>> results;
+
+        REQUIRE_NOTHROW(batch[0] << hello);
+        REQUIRE_NOTHROW(batch[1] << abc);
+        REQUIRE_NOTHROW(batch[2] << def);
+
+        REQUIRE_NOTHROW(statuses = pushsp->SendBatch(batch.data(), batch.size()));
+        REQUIRE(statuses.size() == batch.size());
+        REQUIRE(all_of(statuses.begin(), statuses.end(), [](error_code_type ec) { return ec == ec_enone; }));
+
+        // Give the pipe a moment to deliver everything so that the drain sees it all.
+        this_thread::sleep_for(20ms);
+
+        SECTION("Receive batch is limited by max") {
+            REQUIRE(pullsp->ReceiveBatch(results, 2, timeout) == ec_enone);
+            REQUIRE(results.size() == 2);
+            REQUIRE_THAT(results[0]->GetBody()->Get(), Equals(hello_buf));
+            REQUIRE_THAT(results[1]->GetBody()->Get(), Equals(abc_buf));
+
+            SECTION("Max counts only the messages received by the call") {
+                REQUIRE(pullsp->ReceiveBatch(results, 1, timeout) == ec_enone);
+                REQUIRE(results.size() == 3);
+                REQUIRE_THAT(results[2]->GetBody()->Get(), Equals(def_buf));
+            }
+        }
+
+        SECTION("Receive batch drains what is available") {
+            REQUIRE(pullsp->ReceiveBatch(results, 10, timeout) == ec_enone);
+            REQUIRE(results.size() == 3);
+            REQUIRE_THAT(results[2]->GetBody()->Get(), Equals(def_buf));
+
+            SECTION("Empty receive batch times out without throwing") {
+                results.clear();
+                REQUIRE(pullsp->ReceiveBatch(results, 10, timeout) == ec_etimedout);
+                REQUIRE(results.empty());
+            }
+        }
+    }
+
     SECTION("Can close sockets") {
 
         REQUIRE_NOTHROW(pushsp.reset());
@@ -316,3 +407,154 @@ TEST_CASE("Load balancing works", Catch::Tags("load", "balancing", "pipeline"
         REQUIRE_NOTHROW(pullsp3.reset());
     }
 }
+
+TEST_CASE("Load aware dispatch routes work to the least loaded worker", Catch::Tags("load", "dispatch"
+    , "push", "pull", "v0", "protocol", "sockets", "pattern", "nng", "cxx").c_str()) {
+
+    using namespace std;
+    using namespace nng;
+    using namespace nng::protocol;
+    using namespace nng::exceptions;
+    using namespace constants;
+    using namespace Catch::Matchers;
+
+    const string ack_addr = test_addr + "_acks";
+    const string worker1_addr = test_addr + "_worker1";
+    const string worker2_addr = test_addr + "_worker2";
+
+    latest_pull_socket worker1, worker2;
+    latest_push_socket acks;
+
+    REQUIRE_NOTHROW(worker1.Listen(worker1_addr));
+    REQUIRE_NOTHROW(worker2.Listen(worker2_addr));
+
+    unique_ptr<push_dispatcher> dp;
+
+    // One message at a time per worker, so that running out of credit is easy to arrange.
+    REQUIRE_NOTHROW(dp = make_unique<push_dispatcher>(ack_addr, 1));
+    REQUIRE_NOTHROW(acks.Dial(ack_addr));
+
+    REQUIRE(dp->AddWorker(worker1_addr) == 0);
+    REQUIRE(dp->AddWorker(worker2_addr) == 1);
+    REQUIRE(dp->GetWorkerCount() == 2);
+
+    this_thread::sleep_for(20ms);
+
+    const auto wait_for_outstanding = [&](size_type worker, size_type expected) {
+        for (auto i = 0; i < 100 && dp->GetStats(worker).outstanding != expected; i++) {
+            this_thread::sleep_for(5ms);
+        }
+        return dp->GetStats(worker).outstanding;
+    };
+
+    _Message bm;
+
+    SECTION("Work is spread across idle workers, and withheld once credit runs out") {
+
+        REQUIRE_NOTHROW(bm << abc);
+        REQUIRE(dp->TrySend(bm) == ec_enone);
+        REQUIRE_NOTHROW(bm << def);
+        REQUIRE(dp->TrySend(bm) == ec_enone);
+
+        REQUIRE(dp->GetStats(0).outstanding == 1);
+        REQUIRE(dp->GetStats(1).outstanding == 1);
+
+        REQUIRE_NOTHROW(bm << hello);
+        REQUIRE(dp->TrySend(bm, flag_nonblock) == ec_eagain);
+        // The message comes back as it was.
+        REQUIRE_THAT(bm.GetBody()->Get(), Equals(hello_buf));
+
+        SECTION("Acknowledging frees the worker for more") {
+
+            _Message work;
+
+            REQUIRE(worker2.TryReceive(work) == ec_enone);
+            const auto ticket = push_dispatcher::TakeTicket(work);
+            REQUIRE(ticket == 1);
+            REQUIRE_THAT(work.GetBody()->Get(), Equals(def_buf));
+
+            REQUIRE(push_dispatcher::Acknowledge(acks, ticket) == ec_enone);
+            REQUIRE(wait_for_outstanding(1, 0) == 0);
+            REQUIRE(dp->GetStats(1).acknowledged == 1);
+
+            REQUIRE(dp->TrySend(bm, flag_nonblock) == ec_enone);
+            REQUIRE(dp->GetStats(1).outstanding == 1);
+            REQUIRE(dp->GetStats(1).sent == 2);
+
+            REQUIRE(worker2.TryReceive(work) == ec_enone);
+            REQUIRE(push_dispatcher::TakeTicket(work) == 1);
+            REQUIRE_THAT(work.GetBody()->Get(), Equals(hello_buf));
+        }
+    }
+
+    SECTION("Acknowledgements keep crediting well beyond the first") {
+
+        // Many times the credit across both lanes, so that every ack must be counted.
+        const auto message_count = 20;
+        const auto deadline = chrono::steady_clock::now() + 2000ms;
+
+        _Message work;
+
+        auto sent = 0, acknowledged = 0;
+
+        while (acknowledged < message_count && chrono::steady_clock::now() < deadline) {
+
+            if (sent < message_count) {
+                REQUIRE_NOTHROW(bm << abc);
+                const auto ec = dp->TrySend(bm, flag_nonblock);
+                REQUIRE((ec == ec_enone || ec == ec_eagain));
+                if (ec == ec_enone) { ++sent; }
+                else { REQUIRE_NOTHROW(bm.Clear()); }
+            }
+
+            for (auto* wp : { &worker1, &worker2 }) {
+                if (wp->TryReceive(work, flag_nonblock) != ec_enone) { continue; }
+                REQUIRE(push_dispatcher::Acknowledge(acks, push_dispatcher::TakeTicket(work)) == ec_enone);
+                ++acknowledged;
+            }
+
+            this_thread::sleep_for(1ms);
+        }
+
+        REQUIRE(sent == message_count);
+        REQUIRE(acknowledged == message_count);
+        REQUIRE(wait_for_outstanding(0, 0) == 0);
+        REQUIRE(wait_for_outstanding(1, 0) == 0);
+        REQUIRE(dp->GetStats(0).acknowledged + dp->GetStats(1).acknowledged == message_count);
+    }
+
+    SECTION("Dispatch is selectable as a mode on the push socket") {
+
+        latest_push_socket pusher;
+
+        REQUIRE(pusher.GetDispatcher() == nullptr);
+        REQUIRE_NOTHROW(pusher.SetDispatcher(shared_ptr<push_dispatcher>(move(dp))));
+
+        const auto dispatcherp = pusher.GetDispatcher();
+        REQUIRE(dispatcherp != nullptr);
+
+        REQUIRE_NOTHROW(bm << abc);
+        REQUIRE_NOTHROW(pusher.Send(bm));
+        REQUIRE(pusher.TrySend(def_buf) == ec_enone);
+
+        REQUIRE(dispatcherp->GetStats(0).sent == 1);
+        REQUIRE(dispatcherp->GetStats(1).sent == 1);
+
+        _Message work;
+
+        REQUIRE(worker1.TryReceive(work) == ec_enone);
+        REQUIRE(push_dispatcher::TakeTicket(work) == 0);
+        REQUIRE_THAT(work.GetBody()->Get(), Equals(abc_buf));
+
+        REQUIRE(worker2.TryReceive(work) == ec_enone);
+        REQUIRE(push_dispatcher::TakeTicket(work) == 1);
+        REQUIRE_THAT(work.GetBody()->Get(), Equals(def_buf));
+
+        // Out of credit everywhere, which is an exception for the throwing overload.
+        REQUIRE_NOTHROW(bm << hello);
+        REQUIRE_THROWS_AS_MATCHING(pusher.Send(bm, flag_nonblock), nng_exception, THROWS_NNG_EXCEPTION(ec_eagain));
+
+        REQUIRE_NOTHROW(pusher.SetDispatcher(nullptr));
+        REQUIRE(pusher.GetDispatcher() == nullptr);
+    }
+}
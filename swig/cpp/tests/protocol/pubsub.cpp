@@ -155,6 +155,9 @@ TEST_CASE("Publisher/subscriber pattern using C++ wrapper", Catch::Tags("pub", "
             REQUIRE_THROWS_AS(pubp->Receive(sz), invalid_operation);
             REQUIRE_THROWS_AS(pubp->TryReceive(bmp.get()), invalid_operation);
             REQUIRE_THROWS_AS(pubp->TryReceive(&buf, sz), invalid_operation);
+            REQUIRE_THROWS_AS(pubp->ReceiveAllocated(), invalid_operation);
+            REQUIRE_THROWS_AS(pubp->ReceiveScatter(nullptr, 0), invalid_operation);
+            REQUIRE_THROWS_AS(pubp->TryReceiveScatter(nullptr, 0, sz), invalid_operation);
         }
 
         SECTION("Socket can close") {
@@ -172,6 +175,8 @@ TEST_CASE("Publisher/subscriber pattern using C++ wrapper", Catch::Tags("pub", "
             REQUIRE_THROWS_AS(subp->Send(*bmp), invalid_operation);
             REQUIRE_THROWS_AS(subp->Send(buf), invalid_operation);
             REQUIRE_THROWS_AS(subp->Send(buf, sz), invalid_operation);
+            REQUIRE_THROWS_AS(subp->SendGather(nullptr, 0), invalid_operation);
+            REQUIRE_THROWS_AS(subp->TrySendGather(nullptr, 0), invalid_operation);
         }
 
         SECTION("Socket can close") {
@@ -260,3 +265,172 @@ TEST_CASE("Publisher/subscriber pattern using C++ wrapper", Catch::Tags("pub", "
         }
     }
 }
+
+TEST_CASE("Subscription trie holds and matches topics", Catch::Tags("pub", "sub"
+    , "v0", "subscriptions", "trie", "protocol", "cxx").c_str()) {
+
+    using namespace std;
+    using namespace nng;
+    using namespace nng::protocol;
+    using namespace constants;
+
+    subscription_trie trie;
+
+    REQUIRE(trie.Add(topics::some_like_it_hot) == true);
+    REQUIRE(trie.Add(topics::some_day_some_how) == true);
+    REQUIRE(trie.Add(topics::some) == true);
+    REQUIRE(trie.Add(topics::some_like_it_hot) == false);
+
+    REQUIRE(trie.GetCount() == 3);
+    REQUIRE(trie.GetRefCount(topics::some_like_it_hot) == 2);
+    REQUIRE(trie.GetRefCount(topics::some_day_some_how) == 1);
+    // Shared prefixes are not topics in their own right.
+    REQUIRE(trie.GetRefCount("/some/like/") == 0);
+
+    const auto matches = [&](const string& s) { return trie.Matches(s.data(), s.size()); };
+
+    SECTION("Messages match by prefix") {
+
+        REQUIRE(matches(topics::some_like_it_hot) == true);
+        REQUIRE(matches(topics::some_like_it_raw) == true);
+        REQUIRE(matches(topics::somewhere_over_the_rainbow) == false);
+        REQUIRE(matches(topics::some_do_not_like_it) == false);
+        REQUIRE(matches(__empty) == false);
+
+        REQUIRE(trie.Add(__empty) == true);
+        REQUIRE(matches(topics::some_do_not_like_it) == true);
+    }
+
+    SECTION("Topics are counted down before they are removed") {
+
+        REQUIRE(trie.Remove(topics::some_like_it_hot) == false);
+        REQUIRE(trie.Remove(topics::some_like_it_hot) == true);
+        REQUIRE(trie.Remove(topics::some_like_it_hot) == false);
+        REQUIRE(trie.Remove(hello) == false);
+
+        REQUIRE(trie.Remove(topics::some) == true);
+
+        REQUIRE(trie.GetCount() == 1);
+        REQUIRE_THAT(trie.GetTopics(), Catch::Matchers::Equals(vector<string>{ topics::some_day_some_how }));
+        REQUIRE(matches(topics::some_like_it_hot) == false);
+        REQUIRE(matches(topics::some_day_some_how) == true);
+
+        REQUIRE(trie.Remove(topics::some_day_some_how) == true);
+        REQUIRE(trie.GetCount() == 0);
+        REQUIRE(trie.GetTopics().empty());
+    }
+
+    SECTION("Handlers are gathered shortest topic first") {
+
+        vector<string> handled;
+
+        REQUIRE(trie.SetHandler(topics::some, [&](binary_message&) { handled.push_back(topics::some); }) == true);
+        REQUIRE(trie.SetHandler(topics::some_like_it_hot, [&](binary_message&) { handled.push_back(topics::some_like_it_hot); }) == true);
+        REQUIRE(trie.SetHandler(hello, [&](binary_message&) {}) == false);
+
+        vector<subscription_trie::handler_ptr_type> handlers;
+        const auto& s = topics::some_like_it_hot;
+
+        // Three topics match, but only two of them have handlers.
+        REQUIRE(trie.Add(topics::some_like_it_hot.substr(0, 8)) == true);
+        REQUIRE(trie.GetHandlers(s.data(), s.size(), handlers) == 3);
+        REQUIRE(handlers.size() == 2);
+
+        binary_message bm;
+        for (auto& handlerp : handlers) { (*handlerp)(bm); }
+
+        REQUIRE_THAT(handled, Catch::Matchers::Equals(vector<string>{ topics::some, topics::some_like_it_hot }));
+    }
+}
+
+TEST_CASE("Subscribers manage subscriptions in bulk", Catch::Tags("pub", "sub"
+    , "v0", "subscriptions", "protocol", "cxx").c_str()) {
+
+    using namespace std;
+    using namespace nng;
+    using namespace nng::protocol;
+    using namespace constants;
+    using namespace Catch::Matchers;
+    using O = option_names;
+
+    basic_fixture fixture;
+
+    unique_ptr<latest_pub_socket> pubp;
+    unique_ptr<latest_sub_socket> subp;
+
+    REQUIRE_NOTHROW(pubp = make_unique<latest_pub_socket>());
+    REQUIRE_NOTHROW(subp = make_unique<latest_sub_socket>());
+
+    REQUIRE_NOTHROW(subp->Listen(test_addr));
+    REQUIRE_NOTHROW(pubp->Dial(test_addr));
+    SLEEP_FOR(20ms);
+
+    REQUIRE_NOTHROW(subp->GetOptions()->SetDuration(O::recv_timeout_duration, 90ms));
+
+    const auto publish = [&](const string& s) {
+        binary_message bm;
+        bm << s;
+        pubp->Send(bm);
+    };
+
+    SECTION("Duplicates are conveyed to NNG once") {
+
+        REQUIRE(subp->Subscribe(vector<string>{ topics::some, abc, topics::some, abc }) == 2);
+        REQUIRE(subp->GetSubscriptionCount() == 2);
+
+        // The batch counted each topic once, so one more subscribe and unsubscribe leaves it held.
+        REQUIRE(subp->Subscribe(topics::some) == false);
+        REQUIRE(subp->Unsubscribe(topics::some) == false);
+        REQUIRE(subp->IsSubscribed(topics::some) == true);
+
+        binary_message bm;
+        REQUIRE_NOTHROW(publish(topics::some_like_it_hot));
+        REQUIRE(subp->TryReceive(bm) == ec_enone);
+        REQUIRE_THAT(bm.GetBody()->Get(), Equals(topics::some_like_it_hot_buf));
+
+        REQUIRE(subp->Unsubscribe(vector<string>{ topics::some, abc, topics::some, hello }) == 2);
+        REQUIRE(subp->GetSubscriptionCount() == 0);
+
+        REQUIRE_NOTHROW(publish(topics::some_like_it_hot));
+        REQUIRE(subp->TryReceive(bm) == ec_etimedout);
+    }
+
+    SECTION("Local filtering receives only what matches") {
+
+        REQUIRE(subp->Subscribe(topics::some) == true);
+        REQUIRE_NOTHROW(subp->EnableLocalFiltering());
+        REQUIRE(subp->IsLocalFilteringEnabled() == true);
+
+        REQUIRE_NOTHROW(publish(topics::somewhere_over_the_rainbow));
+        REQUIRE_NOTHROW(publish(topics::some_day_some_how));
+
+        binary_message bm;
+        REQUIRE(subp->ReceiveMatching(bm) == ec_enone);
+        REQUIRE_THAT(bm.GetBody()->Get(), Equals(topics::some_day_some_how_buf));
+
+        REQUIRE(subp->Subscribe(abc) == true);
+        REQUIRE_NOTHROW(publish(abc));
+        REQUIRE(subp->ReceiveMatching(bm) == ec_enone);
+        REQUIRE(subp->ReceiveMatching(bm) == ec_etimedout);
+    }
+
+    SECTION("Received messages are dispatched to topic handlers") {
+
+        int some = 0, hot = 0;
+
+        REQUIRE(subp->Subscribe(topics::some, [&](binary_message&) { ++some; }) == true);
+        REQUIRE(subp->Subscribe(topics::some_like_it_hot, [&](binary_message&) { ++hot; }) == true);
+
+        REQUIRE_NOTHROW(publish(topics::some_like_it_hot));
+        REQUIRE_NOTHROW(publish(topics::some_day_some_how));
+
+        binary_message bm;
+        REQUIRE(subp->TryReceive(bm) == ec_enone);
+        REQUIRE(subp->Dispatch(bm) == 2);
+        REQUIRE(subp->TryReceive(bm) == ec_enone);
+        REQUIRE(subp->Dispatch(bm) == 1);
+
+        REQUIRE(some == 2);
+        REQUIRE(hot == 1);
+    }
+}
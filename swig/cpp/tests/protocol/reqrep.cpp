@@ -20,6 +20,8 @@
 #include "../helpers/constants.h"
 #include "../helpers/protocol_boilerplate.hpp"
 
+#include <atomic>
+
 DEFINE_SOCKET_FIXTURE(v0, req_socket_fixture, req_socket)
 DEFINE_SOCKET_FIXTURE(v0, rep_socket_fixture, rep_socket)
 
@@ -229,3 +231,212 @@ TEST_CASE("Request/reply pattern using C++ wrapper", Catch::Tags("req", "rep"
         REQUIRE_THAT(cmdp->GetBody()->Get(), Equals(def_buf));
 	}
 }
+
+TEST_CASE("Pipelined requests using C++ wrapper", Catch::Tags("req", "rep"
+    , "v0", "pipelined", "client", "protocol", "cxx").c_str()) {
+
+    using namespace std;
+    using namespace nng;
+    using namespace nng::protocol;
+    using namespace constants;
+    using namespace Catch::Matchers;
+    using O = option_names;
+
+    basic_fixture fixture;
+
+    unique_ptr<latest_req_socket> reqp;
+    unique_ptr<latest_rep_socket> repp;
+
+    REQUIRE_NOTHROW(reqp = make_unique<latest_req_socket>());
+    REQUIRE_NOTHROW(repp = make_unique<latest_rep_socket>());
+
+    // The server answers out of order, which only raw mode allows.
+    REQUIRE_NOTHROW(repp->GetOptions()->SetInt32(O::raw, 1));
+    REQUIRE_NOTHROW(repp->GetOptions()->SetDuration(O::recv_timeout_duration, 1000ms));
+
+    REQUIRE_NOTHROW(reqp->GetOptions()->SetDuration(O::req_resend_duration, 1000ms));
+
+    REQUIRE_NOTHROW(repp->Listen(test_addr));
+    REQUIRE_NOTHROW(reqp->Dial(test_addr));
+
+    unique_ptr<request_client> clientp;
+
+    REQUIRE_NOTHROW(clientp = make_unique<request_client>(*reqp));
+    REQUIRE(clientp->GetDefaultTimeout() == 1000ms);
+
+    SECTION("Replies complete their requests in any order") {
+
+        const vector<string> requests = { abc, def, ping };
+        vector<async_future> futures;
+
+        for (const auto& x : requests) {
+            binary_message bm;
+            REQUIRE_NOTHROW(bm << x);
+            futures.push_back(clientp->Request(std::move(bm)));
+        }
+
+        vector<unique_ptr<binary_message>> received;
+
+        for (size_t i = 0; i < requests.size(); i++) {
+            auto bmp = make_unique<binary_message>();
+            REQUIRE(repp->TryReceive(*bmp) == ec_enone);
+            received.push_back(std::move(bmp));
+        }
+
+        REQUIRE(clientp->GetOutstandingCount() == requests.size());
+
+        // Echo back to front, so that every reply arrives out of order.
+        for (auto it = received.rbegin(); it != received.rend(); it++) {
+            REQUIRE((*it)->GetHeader()->GetSize() > 0);
+            REQUIRE(repp->TrySend(**it) == ec_enone);
+        }
+
+        for (size_t i = 0; i < requests.size(); i++) {
+            unique_ptr<binary_message> bmp;
+            REQUIRE_NOTHROW(bmp = futures[i].Get());
+            REQUIRE(bmp.get() != nullptr);
+            REQUIRE_THAT(bmp->GetBody()->Get(), Equals(to_buffer(requests[i])));
+        }
+
+        REQUIRE(clientp->GetOutstandingCount() == 0);
+    }
+
+    SECTION("Handlers are invoked with the reply") {
+
+        atomic<bool> replied(false);
+        async_promise done;
+
+        binary_message bm;
+        REQUIRE_NOTHROW(bm << ping);
+        REQUIRE_NOTHROW(clientp->Request(std::move(bm), [&](async_future& f) {
+            replied = f.GetResult() == ec_enone;
+            done.SetResult(f.GetResult());
+        }));
+
+        REQUIRE(repp->TryReceive(bm) == ec_enone);
+        REQUIRE(repp->TrySend(bm) == ec_enone);
+
+        REQUIRE(done.GetFuture().WaitFor(1000ms) == true);
+        REQUIRE(replied == true);
+    }
+
+    SECTION("Unanswered requests time out") {
+
+        binary_message bm;
+        REQUIRE_NOTHROW(bm << ping);
+        auto future = clientp->Request(std::move(bm), 50ms);
+
+        REQUIRE(future.WaitFor(1000ms) == true);
+        REQUIRE(future.GetResult() == ec_etimedout);
+        REQUIRE(clientp->GetOutstandingCount() == 0);
+    }
+
+    SECTION("Outstanding requests are canceled along with the client") {
+
+        binary_message bm;
+        REQUIRE_NOTHROW(bm << ping);
+        auto future = clientp->Request(std::move(bm));
+
+        REQUIRE_NOTHROW(clientp.reset());
+
+        REQUIRE(future.IsReady() == true);
+        REQUIRE(future.GetResult() == ec_ecanceled);
+    }
+}
+
+TEST_CASE("Concurrent reply server using C++ wrapper", Catch::Tags("req", "rep"
+    , "v0", "server", "workers", "protocol", "cxx").c_str()) {
+
+    using namespace std;
+    using namespace nng;
+    using namespace nng::protocol;
+    using namespace constants;
+    using namespace Catch::Matchers;
+    using O = option_names;
+
+    basic_fixture fixture;
+
+    const string slow = "slow";
+
+    unique_ptr<latest_rep_socket> repp;
+
+    REQUIRE_NOTHROW(repp = make_unique<latest_rep_socket>());
+    REQUIRE_NOTHROW(repp->Listen(test_addr));
+
+    atomic<int> handled(0);
+
+    // Echoes, taking its time over anything slow.
+    const auto handler = [&](binary_message& bm) {
+        if (bm.GetBody()->Get() == to_buffer(slow)) { SLEEP_FOR(200ms); }
+        ++handled;
+        return true;
+    };
+
+    unique_ptr<reply_server> serverp;
+
+    REQUIRE_NOTHROW(serverp = make_unique<reply_server>(*repp, 4, handler));
+    REQUIRE(serverp->GetWorkerCount() == 4);
+
+    SECTION("Slow requests do not hold up the others") {
+
+        unique_ptr<latest_req_socket> reqp;
+        REQUIRE_NOTHROW(reqp = make_unique<latest_req_socket>());
+        REQUIRE_NOTHROW(reqp->Dial(test_addr));
+
+        unique_ptr<request_client> clientp;
+        REQUIRE_NOTHROW(clientp = make_unique<request_client>(*reqp));
+
+        binary_message bm;
+        REQUIRE_NOTHROW(bm << slow);
+        auto slow_reply = clientp->Request(std::move(bm), 1000ms);
+
+        REQUIRE_NOTHROW(bm << abc);
+        auto fast_reply = clientp->Request(std::move(bm), 1000ms);
+
+        unique_ptr<binary_message> bmp;
+        REQUIRE_NOTHROW(bmp = fast_reply.Get());
+        REQUIRE_THAT(bmp->GetBody()->Get(), Equals(abc_buf));
+
+        // The slow one is still in hand after the fast one has been replied to.
+        REQUIRE(slow_reply.IsReady() == false);
+
+        REQUIRE_NOTHROW(bmp = slow_reply.Get());
+        REQUIRE_THAT(bmp->GetBody()->Get(), Equals(to_buffer(slow)));
+
+        REQUIRE(serverp->GetRepliedCount() == 2);
+    }
+
+    SECTION("Many requestors are served") {
+
+        const int requestor_count = 8;
+
+        vector<unique_ptr<latest_req_socket>> requestors;
+
+        for (int i = 0; i < requestor_count; i++) {
+            requestors.push_back(make_unique<latest_req_socket>());
+            REQUIRE_NOTHROW(requestors.back()->GetOptions()->SetDuration(O::recv_timeout_duration, 1000ms));
+            REQUIRE_NOTHROW(requestors.back()->Dial(test_addr));
+        }
+
+        for (auto& sp : requestors) {
+            binary_message bm;
+            REQUIRE_NOTHROW(bm << ping);
+            REQUIRE(sp->TrySend(bm) == ec_enone);
+        }
+
+        for (auto& sp : requestors) {
+            binary_message bm;
+            REQUIRE(sp->TryReceive(bm) == ec_enone);
+            REQUIRE_THAT(bm.GetBody()->Get(), Equals(ping_buf));
+        }
+
+        REQUIRE(handled == requestor_count);
+    }
+
+    SECTION("Server stops") {
+
+        REQUIRE_NOTHROW(serverp->Stop());
+        REQUIRE(serverp->GetBusyCount() == 0);
+        REQUIRE_NOTHROW(serverp.reset());
+    }
+}
@@ -19,6 +19,10 @@
 #include "../helpers/constants.h"
 #include "../helpers/protocol_boilerplate.hpp"
 
+#include <atomic>
+#include <chrono>
+#include <thread>
+
 // Defined for convenience throughout unit testing.
 DEFINE_SOCKET_FIXTURE(v0, survey_socket_fixture, survey_socket)
 DEFINE_SOCKET_FIXTURE(v0, respond_socket_fixture, respond_socket)
@@ -210,3 +214,149 @@ TEST_CASE("Survey pattern using C++ wrapper", Catch::Tags("surveyor", "responden
 		}
 	}
 }
+
+TEST_CASE("Survey aggregation using C++ wrapper", Catch::Tags("survey"
+    , "v0", "surveyor", "respondent", "aggregator", "protocol", "cxx").c_str()) {
+
+    using namespace std;
+    using namespace nng;
+    using namespace nng::protocol;
+    using namespace constants;
+    using O = option_names;
+
+    basic_fixture fixture;
+
+    const int respondent_count = 5;
+
+    unique_ptr<latest_survey_socket> surveyorp;
+
+    REQUIRE_NOTHROW(surveyorp = make_unique<latest_survey_socket>());
+    REQUIRE_NOTHROW(surveyorp->GetOptions()->SetDuration(O::surveyor_survey_duration, 250ms));
+    REQUIRE_NOTHROW(surveyorp->Listen(test_addr));
+
+    vector<unique_ptr<latest_respond_socket>> respondents;
+    vector<thread> threads;
+
+    for (int i = 0; i < respondent_count; i++) {
+        respondents.push_back(make_unique<latest_respond_socket>());
+        REQUIRE_NOTHROW(respondents.back()->Dial(test_addr));
+    }
+
+    // Each respondent answers with its own number, until its socket is closed.
+    for (int i = 0; i < respondent_count; i++) {
+        const auto rp = respondents[i].get();
+        threads.emplace_back([rp, i]() {
+            binary_message bm;
+            while (rp->TryReceive(bm) == ec_enone) {
+                bm.GetBody()->Clear();
+                bm.GetBody()->Append(static_cast<uint32_t>(i + 1));
+                if (rp->TrySend(bm) != ec_enone) { break; }
+            }
+        });
+    }
+
+    SLEEP_FOR(20ms);
+
+    survey_aggregator aggregator(*surveyorp);
+
+    const auto get_number = [](binary_message& bm) {
+        uint32_t x = 0;
+        bm.GetBody()->TrimLeft(&x);
+        return x;
+    };
+
+    SECTION("Responses are folded without a quorum until the survey expires") {
+
+        binary_message bm;
+        REQUIRE_NOTHROW(bm << abc);
+
+        survey_result result;
+
+        const auto sum = aggregator.Fold(bm, 0u, [&](uint32_t acc, binary_message& response) {
+            return acc + get_number(response);
+        }, 0, &result);
+
+        REQUIRE(result.ec == ec_etimedout);
+        REQUIRE(result.responses == respondent_count);
+        REQUIRE(sum == 15);
+    }
+
+    SECTION("Surveys stop early once the quorum is reached") {
+
+        binary_message bm;
+        REQUIRE_NOTHROW(bm << abc);
+
+        const auto start = chrono::steady_clock::now();
+
+        const auto result = aggregator.Survey(bm, [](binary_message&) { return true; }, 3);
+
+        REQUIRE(result.ec == ec_enone);
+        REQUIRE(result.responses == 3);
+        REQUIRE(chrono::steady_clock::now() - start < 250ms);
+    }
+
+    SECTION("Responses stream asynchronously") {
+
+        atomic<int> streamed(0);
+
+        binary_message bm;
+        REQUIRE_NOTHROW(bm << def);
+
+        auto future = aggregator.SurveyAsync(std::move(bm), [&](binary_message&) {
+            ++streamed;
+            return true;
+        }, respondent_count);
+
+        REQUIRE(future.WaitFor(1000ms) == true);
+        REQUIRE(future.GetResult() == ec_enone);
+        REQUIRE(streamed == respondent_count);
+        REQUIRE(aggregator.IsSurveying() == false);
+    }
+
+    SECTION("Asynchronous surveys keep receiving until the quorum is reached") {
+
+        atomic<int> streamed(0);
+
+        binary_message bm;
+        REQUIRE_NOTHROW(bm << abc);
+
+        const auto start = chrono::steady_clock::now();
+
+        // Takes two respondents at least, so the receive must be reissued from its own handler.
+        auto future = aggregator.SurveyAsync(std::move(bm), [&](binary_message&) {
+            ++streamed;
+            return true;
+        }, 2);
+
+        REQUIRE(future.WaitFor(1000ms) == true);
+        REQUIRE(future.GetResult() == ec_enone);
+        REQUIRE(streamed == 2);
+        REQUIRE(chrono::steady_clock::now() - start < 250ms);
+
+        SECTION("And the next survey may follow straight away") {
+
+            REQUIRE_NOTHROW(bm << def);
+
+            auto next = aggregator.SurveyAsync(std::move(bm), [](binary_message&) { return true; }, 2);
+
+            REQUIRE(next.WaitFor(1000ms) == true);
+            REQUIRE(next.GetResult() == ec_enone);
+        }
+    }
+
+    SECTION("One survey at a time") {
+
+        binary_message bm;
+        REQUIRE_NOTHROW(bm << abc);
+
+        auto future = aggregator.SurveyAsync(std::move(bm), [](binary_message&) { return true; });
+
+        REQUIRE_NOTHROW(bm << def);
+        REQUIRE(aggregator.Survey(bm, [](binary_message&) { return true; }).ec == ec_ebusy);
+
+        REQUIRE(future.GetResult() == ec_etimedout);
+    }
+
+    for (auto& rp : respondents) { rp->Close(); }
+    for (auto& t : threads) { t.join(); }
+}